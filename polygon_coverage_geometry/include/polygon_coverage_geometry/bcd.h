@@ -1,6 +1,10 @@
 #ifndef POLYGON_COVERAGE_GEOMETRY_BCD_H_
 #define POLYGON_COVERAGE_GEOMETRY_BCD_H_
 
+#include <limits>
+#include <set>
+#include <vector>
+
 #include "polygon_coverage_geometry/cgal_definitions.h"
 
 // Choset, Howie. "Coverage of known spaces: The boustrophedon cellular
@@ -8,21 +12,99 @@
 // https://www.cs.cmu.edu/~motionplanning/lecture/Chap6-CellDecomp_howie.pdf
 namespace polygon_coverage_planning {
 
-std::vector<Polygon_2> computeBCD(const PolygonWithHoles& polygon_in,
-                                       const Direction_2& dir);
+// Sweeps a line perpendicular to dir along dir. The sweep status is ordered
+// bottom to top. Each event takes O(log n). That makes the whole decomposition
+// O(n log n). All predicates are evaluated in the sweep frame, i.e., the
+// polygon is never rotated and the cells are exact.
+// adjacency: optional, the neighbors of every returned cell, i.e., the cells
+// that share a piece of a cut perpendicular to dir.
+std::vector<Polygon_2> computeBCD(
+    const PolygonWithHoles& polygon_in, const Direction_2& dir,
+    std::vector<std::set<size_t>>* adjacency = nullptr);
 void sortPolygon(PolygonWithHoles* pwh);
-std::vector<VertexConstCirculator> getXSortedVertices(
-    const PolygonWithHoles& p);
-PolygonWithHoles rotatePolygon(const PolygonWithHoles& polygon_in,
-                               const Direction_2& dir);
-void processEvent(const PolygonWithHoles& pwh, const VertexConstCirculator& v,
-                  std::vector<VertexConstCirculator>* sorted_vertices,
-                  std::vector<Point_2>* processed_vertices,
-                  std::list<Segment_2>* L, std::list<Polygon_2>* open_polygons,
+
+// The sweep frame. x is the coordinate along dir, y the coordinate along dir
+// rotated counter-clockwise by 90 degrees. Comparisons are exact predicates
+// that do not construct rotated points.
+class SweepDirection {
+ public:
+  SweepDirection(const Direction_2& dir)
+      : dir_(dir.vector()),
+        x_axis_(Point_2(CGAL::ORIGIN), dir_.perpendicular(CGAL::CLOCKWISE)),
+        y_axis_(Point_2(CGAL::ORIGIN), dir_) {}
+
+  inline bool lessX(const Point_2& a, const Point_2& b) const {
+    return CGAL::compare_signed_distance_to_line(x_axis_, a, b) ==
+           CGAL::SMALLER;
+  }
+  inline bool equalX(const Point_2& a, const Point_2& b) const {
+    return CGAL::compare_signed_distance_to_line(x_axis_, a, b) ==
+           CGAL::EQUAL;
+  }
+  inline bool lessY(const Point_2& a, const Point_2& b) const {
+    return CGAL::compare_signed_distance_to_line(y_axis_, a, b) ==
+           CGAL::SMALLER;
+  }
+  // Lexicographic order by x, then y.
+  bool lessXY(const Point_2& a, const Point_2& b) const;
+  // The point of s at the x of p. s must not be perpendicular to dir.
+  Point_2 intersect(const Segment_2& s, const Point_2& p) const;
+
+ private:
+  Vector_2 dir_;
+  Line_2 x_axis_;  // The signed distance to this line is x.
+  Line_2 y_axis_;  // The signed distance to this line is y.
+};
+
+// A sweep event. It is a single vertex, or a run of vertical edges, i.e.,
+// edges perpendicular to the sweep direction, from first to last in polygon
+// order. Vertical edges never enter the sweep status.
+struct BCDEvent {
+  VertexConstCirculator first;
+  VertexConstCirculator last;
+};
+
+// A non-vertical edge in the sweep status, oriented from left to right.
+struct BCDStatusEdge {
+  BCDStatusEdge() : is_floor(false), cell(0) {}
+  Segment_2 edge;
+  bool is_floor;        // The free space lies above the edge.
+  mutable size_t cell;  // The open cell bounded by the edge.
+};
+
+// Orders the status edges from bottom to top. The status edges do not cross,
+// so the order does not depend on the sweep position.
+struct BCDStatusEdgeLess {
+  BCDStatusEdgeLess(const SweepDirection& sweep) : sweep(sweep) {}
+  bool operator()(const BCDStatusEdge& a, const BCDStatusEdge& b) const;
+  SweepDirection sweep;
+};
+typedef std::set<BCDStatusEdge, BCDStatusEdgeLess> BCDStatus;
+
+// A cell. Both chains are sorted from left to right. The first and the last
+// points of the chains span the left and the right cut.
+struct BCDCell {
+  BCDCell() : polygon(std::numeric_limits<size_t>::max()) {}
+  std::vector<Point_2> floor;
+  std::vector<Point_2> ceiling;
+  size_t polygon;  // The index of the closed polygon. max() if open or invalid.
+};
+
+// Returns all events, sorted by x and then by y.
+std::vector<BCDEvent> getSortedEvents(const PolygonWithHoles& p,
+                                      const SweepDirection& sweep);
+void processEvent(const BCDEvent& event, const SweepDirection& sweep,
+                  BCDStatus* status,
+                  std::vector<BCDCell>* cells,
                   std::vector<Polygon_2>* closed_polygons);
-std::vector<Point_2> getIntersections(const std::list<Segment_2>& L,
-                                      const Line_2& l);
-bool outOfPWH(const PolygonWithHoles& pwh, const Point_2& p);
+// Closes a cell. The polygon is added if it is valid.
+void closeCell(BCDCell* cell, std::vector<Polygon_2>* closed_polygons);
+// Two closed cells are adjacent if the right cut of one and the left cut of
+// the other lie on the same sweep line and overlap. Only cuts with equal x are
+// compared, so this takes O(n log n) for n cells in general position.
+void computeBCDAdjacency(const std::vector<BCDCell>& cells,
+                         const SweepDirection& sweep, size_t num_polygons,
+                         std::vector<std::set<size_t>>* adjacency);
 // Removes duplicate vertices. Returns if resulting polygon is simple and has
 // some area.
 bool cleanupPolygon(Polygon_2* poly);
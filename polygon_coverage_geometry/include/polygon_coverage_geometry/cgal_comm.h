@@ -1,3 +1,6 @@
+#include <set>
+#include <vector>
+
 #include "polygon_coverage_geometry/cgal_definitions.h"
 
 namespace polygon_coverage_planning {
@@ -31,4 +34,28 @@ inline FT computeArea(const Polygon_2& poly) {
 void simplifyPolygon(Polygon_2* polygon);
 void simplifyPolygon(PolygonWithHoles* pwh);
 
+// Copies that share no reference counted representations with the original.
+// Copies of objects of K share their lazily evaluated representations, which
+// are not thread-safe. Deep copies made on one thread can be handed to other
+// threads.
+Point_2 deepCopy(const Point_2& p);
+Direction_2 deepCopy(const Direction_2& d);
+Polygon_2 deepCopy(const Polygon_2& poly);
+PolygonWithHoles deepCopy(const PolygonWithHoles& pwh);
+
+// The number of threads for parallel code that shares objects of K between
+// threads: num_threads if the kernel is thread-safe, one otherwise.
+inline size_t getKernelThreads(size_t num_threads) {
+  return kIsKernelThreadSafe ? num_threads : 1;
+}
+
+// Find the cells of a decomposition that share a boundary segment of positive
+// length. Touching in a single point is not adjacent. Only cells with
+// overlapping bounding boxes are compared, found by sweeping the boxes along
+// x. Use it for decompositions that do not report their adjacency.
+void computeCellAdjacency(const std::vector<Polygon_2>& cells,
+                          std::vector<std::set<size_t>>* adjacency);
+// Whether two polygons share a boundary segment of positive length.
+bool shareBoundarySegment(const Polygon_2& a, const Polygon_2& b);
+
 }  // namespace polygon_coverage_planning
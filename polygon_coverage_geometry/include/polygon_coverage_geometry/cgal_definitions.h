@@ -4,6 +4,7 @@
 #include <CGAL/Exact_predicates_exact_constructions_kernel.h>
 #include <CGAL/Exact_predicates_inexact_constructions_kernel.h>
 #include <CGAL/Polygon_with_holes_2.h>
+#include <CGAL/version.h>
 
 typedef CGAL::Exact_predicates_exact_constructions_kernel K;
 typedef K::FT FT;
@@ -24,6 +25,15 @@ typedef Polygon_2::Edge_const_circulator EdgeConstCirculator;
 typedef CGAL::Polygon_with_holes_2<K> PolygonWithHoles;
 typedef CGAL::Exact_predicates_inexact_constructions_kernel InexactKernel;
 
+// Copies of objects of K share lazily evaluated, reference counted
+// representations. Using them on several threads at the same time is only safe
+// from CGAL 5.5 on and if CGAL is built with thread support.
+#if defined(CGAL_HAS_THREADS) && CGAL_VERSION_NR >= 1050501000
+const bool kIsKernelThreadSafe = true;
+#else
+const bool kIsKernelThreadSafe = false;
+#endif
+
 enum DecompositionType { kBoustrophedeon, kTrapezoidal };
 
 #endif  // POLYGON_COVERAGE_GEOMETRY_CGAL_DEFINITIONS_H_
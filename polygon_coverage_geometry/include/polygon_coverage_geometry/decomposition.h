@@ -0,0 +1,75 @@
+#ifndef POLYGON_COVERAGE_GEOMETRY_DECOMPOSITION_H_
+#define POLYGON_COVERAGE_GEOMETRY_DECOMPOSITION_H_
+
+#include <functional>
+#include <set>
+#include <vector>
+
+#include "polygon_coverage_geometry/cgal_definitions.h"
+
+namespace polygon_coverage_planning {
+
+// The smallest altitude of a cell over all edge directions in which the cell
+// is weakly monotone, i.e., the distance between its south and north vertex.
+// best_dir: optional, the edge direction with the smallest altitude. Returns
+// max() if the cell is not weakly monotone in any edge direction.
+double findBestSweepDir(const Polygon_2& cell, Direction_2* best_dir = nullptr);
+
+// A cheap lower bound on findBestSweepDir.
+double computeMinAltitudeLowerBound(const Polygon_2& cell);
+// A cheap lower bound on the sum of findBestSweepDir over the cells of any
+// decomposition of pwh along dir. Does not decompose the polygon.
+double computeDecompositionLowerBound(const PolygonWithHoles& pwh,
+                                      const Direction_2& dir);
+
+// All directions perpendicular to an edge of the polygon and their opposites.
+// Collinear edges contribute one direction.
+std::vector<Direction_2> findPerpEdgeDirections(const PolygonWithHoles& pwh);
+
+// Decomposes pwh along dir into cells. adjacency: optional, the neighbors of
+// every cell. Decompositions that do not report their adjacency leave it
+// empty.
+typedef std::function<bool(const PolygonWithHoles& pwh, const Direction_2& dir,
+                           std::vector<Polygon_2>* cells,
+                           std::vector<std::set<size_t>>* adjacency)>
+    DecompositionFunction;
+
+// Decompose the polygon along every direction of findPerpEdgeDirections.
+// Return the decomposition with the smallest sum of cell altitudes. The
+// directions are evaluated on num_threads threads (0: all hardware threads),
+// in ascending order of computeDecompositionLowerBound. A direction is not
+// decomposed if its bound exceeds the best sum so far, and it is abandoned once
+// its partial sum does. Every direction is decomposed and scored on its own
+// deep copy of the polygon, i.e., decompose needs to be thread-safe for
+// distinct inputs. Ties go to the first direction, i.e., the result is the one
+// of an exhaustive serial search and does not depend on the number of
+// threads.
+// adjacency: optional, the adjacency that decompose reports for the best
+// decomposition.
+bool computeBestDecomposition(
+    const PolygonWithHoles& pwh, const DecompositionFunction& decompose,
+    size_t num_threads, std::vector<Polygon_2>* cells,
+    std::vector<std::set<size_t>>* adjacency = nullptr);
+
+// computeBestDecomposition with computeBCD. adjacency: optional, the cell
+// adjacency found by the sweep of the best direction.
+bool computeBestBCDFromPolygonWithHoles(
+    const PolygonWithHoles& pwh, std::vector<Polygon_2>* bcd_polygons,
+    size_t num_threads = 0,
+    std::vector<std::set<size_t>>* adjacency = nullptr);
+
+// Trapezoidal decomposition with cell walls perpendicular to dir. CGAL only
+// decomposes along the x-axis, i.e., any other direction rotates the polygon
+// and the resulting cells.
+std::vector<Polygon_2> computeTCD(const PolygonWithHoles& pwh,
+                                  const Direction_2& dir);
+
+// computeBestDecomposition with computeTCD. The trapezoidal decomposition does
+// not report the cell adjacency.
+bool computeBestTCDFromPolygonWithHoles(const PolygonWithHoles& pwh,
+                                        std::vector<Polygon_2>* trap_polygons,
+                                        size_t num_threads = 0);
+
+}  // namespace polygon_coverage_planning
+
+#endif  // POLYGON_COVERAGE_GEOMETRY_DECOMPOSITION_H_
@@ -37,12 +37,24 @@ class Polygon {
                             bool counter_clockwise,
                             std::vector<Point_2>* waypoints) const;
 
-  bool computeBCDFromPolygonWithHoles(std::vector<Polygon>* bcd_polygons) const;
+  // Sweep along dir. The cells are computed in the polygon frame, i.e., there
+  // is no need to rotate them back.
+  bool computeBCDFromPolygonWithHoles(const Direction_2& dir,
+                                      std::vector<Polygon>* bcd_polygons) const;
+  inline bool computeBCDFromPolygonWithHoles(
+      std::vector<Polygon>* bcd_polygons) const {
+    return computeBCDFromPolygonWithHoles(Direction_2(1, 0), bcd_polygons);
+  }
 
-  // Compute BCDs for every edge direction. Return any with the smallest number
-  // of cells.
+  // Compute BCDs for every edge direction. Return the one with the smallest
+  // sum of cell altitudes. Same as
+  // polygon_coverage_planning::computeBestBCDFromPolygonWithHoles, i.e., the
+  // directions are evaluated by num_threads threads, 0 uses all hardware
+  // threads, and the result does not depend on the number of threads.
+  // adjacency: optional, the cell adjacency found by the sweep.
   bool computeBestBCDFromPolygonWithHoles(
-      std::vector<Polygon>* bcd_polygons) const;
+      std::vector<Polygon>* bcd_polygons, size_t num_threads = 0,
+      std::vector<std::set<size_t>>* adjacency = nullptr) const;
 
   // TODO(rikba): implement.
   bool computeBestDecompositionFromPolygonWithHoles(
@@ -50,12 +62,17 @@ class Polygon {
     return computeBCDFromPolygonWithHoles(bcd_polygons);
   }
 
+  // CGAL only decomposes along the x-axis. Any other direction rotates the
+  // polygon and the resulting cells.
+  bool computeTrapezoidalDecompositionFromPolygonWithHoles(
+      const Direction_2& dir, std::vector<Polygon>* trap_polygons) const;
   bool computeTrapezoidalDecompositionFromPolygonWithHoles(
       std::vector<Polygon>* trap_polygons) const;
 
   // The best TCD is considered the one with the smallest bound on sweeps.
+  // Same as polygon_coverage_planning::computeBestTCDFromPolygonWithHoles.
   bool computeBestTrapezoidalDecompositionFromPolygonWithHoles(
-      std::vector<Polygon>* trap_polygons) const;
+      std::vector<Polygon>* trap_polygons, size_t num_threads = 0) const;
 
   inline const PolygonWithHoles& getPolygon() const { return polygon_; }
   std::vector<Point_2> getHullVertices() const;
@@ -89,7 +106,6 @@ class Polygon {
                          Direction_2* sweep_dir = nullptr) const;
 
  private:
-
   bool checkConvexity() const;
 
   // Sort boundary to be counter-clockwise and holes to be clockwise.
@@ -0,0 +1,298 @@
+#ifndef POLYGON_COVERAGE_GEOMETRY_SWEEP_IMPL_H_
+#define POLYGON_COVERAGE_GEOMETRY_SWEEP_IMPL_H_
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+#include <ros/assert.h>
+#include <ros/console.h>
+
+namespace polygon_coverage_planning {
+
+template <class Kernel>
+bool computeSweepSegments(
+    const CGAL::Polygon_2<Kernel>& in, const typename Kernel::FT offset,
+    const CGAL::Direction_2<Kernel>& dir,
+    std::vector<CGAL::Segment_2<Kernel>>* sweep_segments) {
+  typedef typename Kernel::FT FT;
+  typedef typename Kernel::Point_2 Point_2;
+  typedef typename Kernel::Vector_2 Vector_2;
+  typedef typename Kernel::Line_2 Line_2;
+  typedef typename Kernel::Segment_2 Segment_2;
+  ROS_ASSERT(sweep_segments);
+  sweep_segments->clear();
+  const FT kSqOffset = offset * offset;
+
+  // Assertions.
+  // TODO(rikba): Check monotone perpendicular to dir.
+  if (!in.is_counterclockwise_oriented()) return false;
+
+  // Find start sweep.
+  Line_2 sweep(Point_2(0.0, 0.0), dir);
+  std::vector<Point_2> sorted_pts = sortVerticesToLine(in, sweep);
+  sweep = Line_2(sorted_pts.front(), dir);
+
+  Vector_2 offset_vector = sweep.perpendicular(sorted_pts.front()).to_vector();
+  offset_vector = offset * offset_vector /
+                  std::sqrt(CGAL::to_double(offset_vector.squared_length()));
+  const CGAL::Aff_transformation_2<Kernel> kOffset(CGAL::TRANSLATION,
+                                                   offset_vector);
+
+  // Find the sweep segments incrementally.
+  SweepSegmentFinder<Kernel> finder(in, dir);
+  Segment_2 sweep_segment;
+  bool has_sweep_segment = finder.findSweepSegment(sweep, &sweep_segment);
+  while (has_sweep_segment) {
+    sweep_segments->push_back(sweep_segment);
+
+    // Offset sweep.
+    sweep = sweep.transform(kOffset);
+    // Find new sweep segment.
+    const Segment_2 prev_sweep_segment = sweep_segment;
+    has_sweep_segment = finder.findSweepSegment(sweep, &sweep_segment);
+    // Add a final sweep if the last sweep does not touch the top vertex.
+    if (!has_sweep_segment &&
+        prev_sweep_segment.source() != sorted_pts.back() &&
+        prev_sweep_segment.target() != sorted_pts.back()) {
+      sweep = Line_2(sorted_pts.back(), dir);
+      has_sweep_segment = finder.findSweepSegment(sweep, &sweep_segment);
+      if (!has_sweep_segment) {
+        ROS_ERROR_STREAM("Failed to calculate final sweep.");
+        return false;
+      }
+      // Do not add super close sweep.
+      if (CGAL::squared_distance(sweep_segment, prev_sweep_segment) < 0.1)
+        break;
+    }
+    // Check observability of vertices between sweeps.
+    if (has_sweep_segment) {
+      typename std::vector<Point_2>::const_iterator unobservable_point =
+          sorted_pts.end();
+      checkObservability(prev_sweep_segment, sweep_segment, sorted_pts,
+                         kSqOffset, &unobservable_point);
+      if (unobservable_point != sorted_pts.end()) {
+        sweep = Line_2(*unobservable_point, dir);
+        has_sweep_segment = finder.findSweepSegment(sweep, &sweep_segment);
+        if (!has_sweep_segment) {
+          ROS_ERROR_STREAM("Failed to calculate extra sweep at point: "
+                           << *unobservable_point);
+          return false;
+        }
+      }
+    }
+  }
+
+  return true;
+}
+
+template <class Kernel>
+bool findSweepSegment(const CGAL::Polygon_2<Kernel>& p,
+                      const CGAL::Line_2<Kernel>& l,
+                      CGAL::Segment_2<Kernel>* sweep_segment) {
+  std::vector<CGAL::Point_2<Kernel>> intersections = findIntersections(p, l);
+  if (intersections.empty()) return false;
+  *sweep_segment =
+      CGAL::Segment_2<Kernel>(intersections.front(), intersections.back());
+  return true;
+}
+
+template <class Kernel>
+void checkObservability(
+    const CGAL::Segment_2<Kernel>& prev_sweep,
+    const CGAL::Segment_2<Kernel>& sweep,
+    const std::vector<CGAL::Point_2<Kernel>>& sorted_pts,
+    const typename Kernel::FT max_sq_distance,
+    typename std::vector<CGAL::Point_2<Kernel>>::const_iterator*
+        lowest_unobservable_point) {
+  typedef typename Kernel::FT FT;
+  ROS_ASSERT(lowest_unobservable_point);
+  *lowest_unobservable_point = sorted_pts.end();
+
+  // Find first point that is between prev_sweep and sweep and unobservable.
+  for (typename std::vector<CGAL::Point_2<Kernel>>::const_iterator it =
+           sorted_pts.begin();
+       it != sorted_pts.end(); ++it) {
+    if (prev_sweep.supporting_line().has_on_positive_side(*it)) continue;
+    if (sweep.supporting_line().has_on_negative_side(*it)) {
+      break;
+    }
+    FT sq_distance_prev = CGAL::squared_distance(prev_sweep, *it);
+    FT sq_distance_curr = CGAL::squared_distance(sweep, *it);
+    if (sq_distance_prev > max_sq_distance &&
+        sq_distance_curr > max_sq_distance) {
+      *lowest_unobservable_point = it;
+      return;
+    }
+  }
+}
+
+template <class Kernel>
+SweepSegmentFinder<Kernel>::SweepSegmentFinder(
+    const CGAL::Polygon_2<Kernel>& p, const CGAL::Direction_2<Kernel>& dir)
+    : polygon_(p),
+      x_axis_(Point_2(CGAL::ORIGIN), dir),
+      is_weakly_monotone_(p.size() > 2),
+      tolerance_(0.0) {
+  if (!is_weakly_monotone_) {
+    return;
+  }
+
+  // Floating point heights of vertices on the same sweep line differ by
+  // rounding errors.
+  if (!kIsExact) {
+    const CGAL::Bbox_2 bbox = polygon_.bbox();
+    const double max_coordinate =
+        std::max({std::abs(bbox.xmin()), std::abs(bbox.xmax()),
+                  std::abs(bbox.ymin()), std::abs(bbox.ymax())});
+    tolerance_ = FT(kRelativeTolerance * max_coordinate);
+  }
+
+  // Find south and north.
+  typedef typename CGAL::Polygon_2<Kernel>::Vertex_const_circulator
+      VertexConstCirculator;
+  VertexConstCirculator south = polygon_.vertices_circulator();
+  VertexConstCirculator north = south;
+  VertexConstCirculator vc = south;
+  do {
+    if (computeHeight(*vc) < computeHeight(*south)) south = vc;
+    if (computeHeight(*vc) > computeHeight(*north)) north = vc;
+  } while (++vc != polygon_.vertices_circulator());
+
+  // Split the polygon into two chains from south to north. The polygon is
+  // weakly monotone if the heights do not decrease along both chains.
+  chains_.resize(2);
+  for (Chain& chain : chains_) {
+    const bool is_counter_clockwise = &chain == &chains_.front();
+    VertexConstCirculator c = south;
+    chain.vertices.push_back(*c);
+    chain.heights.push_back(computeHeight(*c));
+    do {
+      if (is_counter_clockwise)
+        ++c;
+      else
+        --c;
+      chain.vertices.push_back(*c);
+      chain.heights.push_back(computeHeight(*c));
+      if (isBelow(chain.heights.back(),
+                  chain.heights[chain.heights.size() - 2])) {
+        is_weakly_monotone_ = false;
+        chains_.clear();
+        return;
+      }
+    } while (c != north);
+  }
+}
+
+template <class Kernel>
+bool SweepSegmentFinder<Kernel>::findSweepSegment(
+    const Line_2& l, Segment_2* sweep_segment) {
+  ROS_ASSERT(sweep_segment);
+  if (!is_weakly_monotone_ || !CGAL::parallel(l, x_axis_)) {
+    return polygon_coverage_planning::findSweepSegment(polygon_, l,
+                                                       sweep_segment);
+  }
+
+  const FT level = computeHeight(l.point(0));
+  std::vector<Point_2> intersections;
+  for (Chain& chain : chains_) {
+    findIntersections(level, &chain, &intersections);
+  }
+  if (intersections.empty()) return false;
+
+  // First and last intersection along the line, as in findIntersections.
+  const Line_2 perp_l = l.perpendicular(l.point(0));
+  auto is_smaller = [&perp_l](const Point_2& a, const Point_2& b) -> bool {
+    return CGAL::has_smaller_signed_distance_to_line(perp_l, a, b);
+  };
+  *sweep_segment = Segment_2(
+      *std::min_element(intersections.begin(), intersections.end(),
+                        is_smaller),
+      *std::max_element(intersections.begin(), intersections.end(),
+                        is_smaller));
+  return true;
+}
+
+template <class Kernel>
+void SweepSegmentFinder<Kernel>::findIntersections(
+    const FT& level, Chain* chain, std::vector<Point_2>* intersections) const {
+  ROS_ASSERT(chain);
+  ROS_ASSERT(intersections);
+  const std::vector<FT>& h = chain->heights;
+  if (isBelow(level, h.front()) || isBelow(h.back(), level)) return;
+
+  // Walk to the edge [k, k + 1] with h[k] <= level <= h[k + 1]. The heights
+  // increase monotonically along the chain.
+  size_t& k = chain->edge;
+  while (k + 2 < h.size() && h[k + 1] < level) ++k;
+  while (k > 0 && h[k] > level) --k;
+
+  if (isBelow(h[k], level) && isBelow(level, h[k + 1])) {
+    // Proper crossing.
+    const Point_2& u = chain->vertices[k];
+    const Point_2& v = chain->vertices[k + 1];
+    intersections->push_back(u +
+                             (v - u) * ((level - h[k]) / (h[k + 1] - h[k])));
+    return;
+  }
+
+  // The line passes through vertices, possibly several collinear ones.
+  for (size_t i = k + 1; i-- > 0 && isAtLevel(h[i], level);) {
+    intersections->push_back(chain->vertices[i]);
+  }
+  for (size_t i = k + 1; i < h.size() && isAtLevel(h[i], level); ++i) {
+    intersections->push_back(chain->vertices[i]);
+  }
+}
+
+template <class Kernel>
+std::vector<CGAL::Point_2<Kernel>> sortVerticesToLine(
+    const CGAL::Polygon_2<Kernel>& p, const CGAL::Line_2<Kernel>& l) {
+  // Copy points.
+  std::vector<CGAL::Point_2<Kernel>> pts(p.vertices_begin(),
+                                         p.vertices_end());
+
+  // Sort.
+  std::sort(pts.begin(), pts.end(),
+            [&l](const CGAL::Point_2<Kernel>& a,
+                 const CGAL::Point_2<Kernel>& b) -> bool {
+              return CGAL::has_smaller_signed_distance_to_line(l, a, b);
+            });
+
+  return pts;
+}
+
+template <class Kernel>
+std::vector<CGAL::Point_2<Kernel>> findIntersections(
+    const CGAL::Polygon_2<Kernel>& p, const CGAL::Line_2<Kernel>& l) {
+  typedef typename Kernel::Point_2 Point_2;
+  typedef typename Kernel::Segment_2 Segment_2;
+  std::vector<Point_2> intersections;
+
+  for (typename CGAL::Polygon_2<Kernel>::Edge_const_iterator it =
+           p.edges_begin();
+       it != p.edges_end(); ++it) {
+    auto result = CGAL::intersection(*it, l);
+    if (result) {
+      if (const Segment_2* s = boost::get<Segment_2>(&*result)) {
+        intersections.push_back(s->source());
+        intersections.push_back(s->target());
+      } else {
+        intersections.push_back(*boost::get<Point_2>(&*result));
+      }
+    }
+  }
+
+  // Sort.
+  typename Kernel::Line_2 perp_l = l.perpendicular(l.point(0));
+  std::sort(intersections.begin(), intersections.end(),
+            [&perp_l](const Point_2& a, const Point_2& b) -> bool {
+              return CGAL::has_smaller_signed_distance_to_line(perp_l, a, b);
+            });
+
+  return intersections;
+}
+
+}  // namespace polygon_coverage_planning
+
+#endif  // POLYGON_COVERAGE_GEOMETRY_SWEEP_IMPL_H_
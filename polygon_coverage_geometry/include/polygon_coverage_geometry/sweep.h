@@ -1,6 +1,8 @@
 #ifndef POLYGON_COVERAGE_GEOMETRY_SWEEP_H_
 #define POLYGON_COVERAGE_GEOMETRY_SWEEP_H_
 
+#include <type_traits>
+
 #include "polygon_coverage_geometry/cgal_definitions.h"
 #include "polygon_coverage_geometry/visibility_graph.h"
 
@@ -12,27 +14,129 @@ bool computeSweep(const Polygon_2& in,
                   const FT offset, const Direction_2& dir,
                   bool counter_clockwise, std::vector<Point_2>* waypoints);
 
+// Connect the source and target of every sweep segment to the visibility
+// graph.
+bool createSweepSegmentQueries(
+    const visibility_graph::VisibilityGraph& visibility_graph,
+    const std::vector<Segment_2>& sweep_segments,
+    std::vector<visibility_graph::QueryNode>* sources,
+    std::vector<visibility_graph::QueryNode>* targets);
+
+// Connect the sweep segments with shortest paths, swapping direction every
+// segment. The first segment is traversed from target to source if
+// counter_clockwise.
+bool connectSweepSegments(
+    const visibility_graph::VisibilityGraph& visibility_graph,
+    const std::vector<Segment_2>& sweep_segments,
+    const std::vector<visibility_graph::QueryNode>& sources,
+    const std::vector<visibility_graph::QueryNode>& targets,
+    bool counter_clockwise, std::vector<Point_2>* waypoints);
+
 // Compute sweeps in all sweepable directions, starting counter-clockwise,
-// clockwise, and reverse.
+// clockwise, and reverse. If use_inexact_kernel, the sweep segments are
+// computed with computeInexactSweepSegments.
 bool computeAllSweeps(const Polygon_2& poly, const double max_sweep_offset,
-                      std::vector<std::vector<Point_2>>* cluster_sweeps);
+                      std::vector<std::vector<Point_2>>* cluster_sweeps,
+                      bool use_inexact_kernel = false);
+
+// Compute the sweep segments on InexactKernel and convert them to K. Endpoints
+// that are rounded outside of the polygon are projected onto its boundary.
+bool computeInexactSweepSegments(const Polygon_2& in, const FT offset,
+                                 const Direction_2& dir,
+                                 std::vector<Segment_2>* sweep_segments);
+
+// Compute the sweep segments by moving a sweep line from the bottom to the top
+// of the polygon. The segments are not aligned to a sweep pattern, yet.
+// Templated on the kernel. The planner uses the exact kernel K. A floating
+// point kernel, e.g., InexactKernel, is much faster but not robust to
+// degenerate input. Its segment endpoints can lie slightly outside the polygon,
+// see computeInexactSweepSegments.
+template <class Kernel>
+bool computeSweepSegments(
+    const CGAL::Polygon_2<Kernel>& in, const typename Kernel::FT offset,
+    const CGAL::Direction_2<Kernel>& dir,
+    std::vector<CGAL::Segment_2<Kernel>>* sweep_segments);
 
 // A segment is observable if all vertices between two sweeps are observable.
+template <class Kernel>
 void checkObservability(
-    const Segment_2& prev_sweep, const Segment_2& sweep,
-    const std::vector<Point_2>& sorted_pts, const FT max_sq_distance,
-    std::vector<Point_2>::const_iterator* lowest_unobservable_point);
+    const CGAL::Segment_2<Kernel>& prev_sweep,
+    const CGAL::Segment_2<Kernel>& sweep,
+    const std::vector<CGAL::Point_2<Kernel>>& sorted_pts,
+    const typename Kernel::FT max_sq_distance,
+    typename std::vector<CGAL::Point_2<Kernel>>::const_iterator*
+        lowest_unobservable_point);
 
 // Find the intersections between a polygon and a line and sort them by the
 // distance to the perpendicular direction of the line.
-std::vector<Point_2> findIntersections(const Polygon_2& p, const Line_2& l);
+template <class Kernel>
+std::vector<CGAL::Point_2<Kernel>> findIntersections(
+    const CGAL::Polygon_2<Kernel>& p, const CGAL::Line_2<Kernel>& l);
 
 // Same as findIntersections but only return first and last intersection.
-bool findSweepSegment(const Polygon_2& p, const Line_2& l,
-                      Segment_2* sweep_segment);
+template <class Kernel>
+bool findSweepSegment(const CGAL::Polygon_2<Kernel>& p,
+                      const CGAL::Line_2<Kernel>& l,
+                      CGAL::Segment_2<Kernel>* sweep_segment);
+
+// Same as findSweepSegment for many lines parallel to dir. The two chains of a
+// polygon that is weakly monotone perpendicular to dir are walked in step with
+// the lines, i.e., a query close to the previous query takes amortized
+// constant time. Falls back to findSweepSegment if the polygon is not weakly
+// monotone or the line is not parallel to dir.
+template <class Kernel>
+class SweepSegmentFinder {
+ public:
+  typedef typename Kernel::FT FT;
+  typedef typename Kernel::Point_2 Point_2;
+  typedef typename Kernel::Line_2 Line_2;
+  typedef typename Kernel::Segment_2 Segment_2;
+
+  SweepSegmentFinder(const CGAL::Polygon_2<Kernel>& p,
+                     const CGAL::Direction_2<Kernel>& dir);
+
+  bool findSweepSegment(const Line_2& l, Segment_2* sweep_segment);
+
+ private:
+  // A chain from the south to the north vertex.
+  struct Chain {
+    Chain() : edge(0) {}
+    std::vector<Point_2> vertices;
+    std::vector<FT> heights;  // The signed distances to x_axis_.
+    size_t edge;              // The edge of the last query.
+  };
+
+  // Exact kernels compare heights exactly. Inexact kernels consider heights
+  // within tolerance_ equal.
+  static constexpr bool kIsExact = std::is_same<
+      typename CGAL::Algebraic_structure_traits<FT>::Is_exact,
+      CGAL::Tag_true>::value;
+  static constexpr double kRelativeTolerance = 1.0e-9;
+
+  inline FT computeHeight(const Point_2& p) const {
+    return x_axis_.a() * p.x() + x_axis_.b() * p.y();
+  }
+  inline bool isBelow(const FT& a, const FT& b) const {
+    return kIsExact ? a < b : a < b - tolerance_;
+  }
+  inline bool isAtLevel(const FT& h, const FT& level) const {
+    return !isBelow(h, level) && !isBelow(level, h);
+  }
+  // Append the intersections between the chain and the line at height level.
+  void findIntersections(const FT& level, Chain* chain,
+                         std::vector<Point_2>* intersections) const;
+
+  CGAL::Polygon_2<Kernel> polygon_;
+  Line_2 x_axis_;
+  bool is_weakly_monotone_;
+  FT tolerance_;
+  std::vector<Chain> chains_;
+};
 
 // Sort vertices of polygon based on signed distance to line l.
-std::vector<Point_2> sortVerticesToLine(const Polygon_2& p, const Line_2& l);
+template <class Kernel>
+std::vector<CGAL::Point_2<Kernel>> sortVerticesToLine(
+    const CGAL::Polygon_2<Kernel>& p, const CGAL::Line_2<Kernel>& l);
 
 // Connect to points in the polygon using the visibility graph.
 bool calculateShortestPath(
@@ -42,4 +146,6 @@ bool calculateShortestPath(
 
 }  // namespace polygon_coverage_planning
 
+#include "polygon_coverage_geometry/impl/sweep_impl.h"
+
 #endif  // POLYGON_COVERAGE_GEOMETRY_SWEEP_H_
@@ -2,10 +2,14 @@
 #define POLYGON_COVERAGE_GEOMETRY_VISIBILITY_GRAPH_H_
 
 #include <map>
+#include <memory>
+#include <utility>
+#include <vector>
 
 #include <polygon_coverage_solvers/graph_base.h>
 
 #include "polygon_coverage_geometry/cgal_definitions.h"
+#include "polygon_coverage_geometry/visibility_polygon.h"
 
 namespace polygon_coverage_planning {
 namespace visibility_graph {
@@ -20,6 +24,18 @@ struct NodeProperty {
 
 struct EdgeProperty {};
 
+// A start or goal point that is connected to the graph nodes it sees on the
+// fly. Create it once with createQueryNode and reuse it for every query.
+struct QueryNode {
+  QueryNode() : coordinates(Point_2(CGAL::ORIGIN)) {}
+  Point_2 coordinates;   // The 2D coordinates.
+  Polygon_2 visibility;  // The visibile polygon from the point.
+  // The visible graph nodes.
+  // first: graph node id
+  // second: Euclidean distance to the graph node
+  std::vector<std::pair<size_t, double>> visible_nodes;
+};
+
 // Shortest path calculation in the reduced visibility graph.
 // https://www.david-gouveia.com/pathfinding-on-a-2d-polygonal-map
 class VisibilityGraph : public GraphBase<NodeProperty, EdgeProperty> {
@@ -29,7 +45,7 @@ class VisibilityGraph : public GraphBase<NodeProperty, EdgeProperty> {
   VisibilityGraph(const Polygon_2& polygon)
       : VisibilityGraph(PolygonWithHoles(polygon)) {}
 
-  VisibilityGraph() : GraphBase() {}
+  VisibilityGraph() : GraphBase(), has_all_pairs_(false) {}
 
   virtual bool create() override;
 
@@ -45,6 +61,24 @@ class VisibilityGraph : public GraphBase<NodeProperty, EdgeProperty> {
              const Point_2& goal, const Polygon_2& goal_visibility_polygon,
              std::vector<Point_2>* waypoints) const;
 
+  // Same as solve but with start and goal query nodes. The query nodes are
+  // connected to the graph virtually, i.e., the graph is not copied or
+  // modified. Thread-safe.
+  bool solve(const QueryNode& start, const QueryNode& goal,
+             std::vector<Point_2>* waypoints) const;
+
+  // Precompute the shortest paths between all graph nodes with one Dijkstra
+  // search per node on num_threads threads (0: all hardware threads).
+  // Afterwards, a query only combines the visible nodes of start and goal with
+  // the table instead of searching the graph.
+  bool precomputeAllPairs(size_t num_threads = 0);
+  inline bool hasAllPairs() const { return has_all_pairs_; }
+
+  // Find all graph nodes visible from point. Point needs to be contained in
+  // the polygon_.
+  bool createQueryNode(const Point_2& point, const Polygon_2& visibility,
+                       QueryNode* query_node) const;
+
   // Convenience function: addtionally adds original start and goal to shortest
   // path, if they were outside of polygon.
   bool solveWithOutsideStartAndGoal(const Point_2& start, const Point_2& goal,
@@ -55,6 +89,22 @@ class VisibilityGraph : public GraphBase<NodeProperty, EdgeProperty> {
 
   inline PolygonWithHoles getPolygon() const { return polygon_; }
 
+  // Compute the visibility polygon of a point in the polygon. Uses the cached
+  // visibility oracle of the graph. Thread-safe.
+  bool computeVisibility(const Point_2& query_point,
+                         Polygon_2* visibility) const;
+  // Compute the visibility polygons of many points in the polygon on
+  // num_threads threads (0: all hardware threads). Small batches use the cached
+  // visibility oracle, larger ones its cached worker oracles. Thread-safe.
+  bool computeVisibility(const std::vector<Point_2>& query_points,
+                         std::vector<Polygon_2>* visibility,
+                         size_t num_threads = 0) const;
+  // The visibility oracle shared by all copies of this graph.
+  inline std::shared_ptr<const ParallelVisibilityPolygonOracle>
+  getVisibilityOracle() const {
+    return visibility_oracle_;
+  }
+
  private:
   // Adds all line of sight neighbors.
   // The graph is acyclic and undirected and thus forms a symmetric adjacency
@@ -72,11 +122,21 @@ class VisibilityGraph : public GraphBase<NodeProperty, EdgeProperty> {
   void findConvexHoleVertices(
       std::vector<VertexConstCirculator>* convex_vertices) const;
 
+  // Shortest path between query nodes from the all-pairs table.
+  bool solveAllPairs(const QueryNode& start, const QueryNode& goal,
+                     std::vector<Point_2>* waypoints) const;
+
   // Given two waypoints, compute its euclidean distance.
   double computeEuclideanSegmentCost(const Point_2& from,
                                      const Point_2& to) const;
 
   PolygonWithHoles polygon_;
+  std::shared_ptr<const ParallelVisibilityPolygonOracle> visibility_oracle_;
+
+  // All-pairs shortest paths, indexed [from * size() + to].
+  bool has_all_pairs_;
+  std::vector<double> all_pairs_cost_;
+  std::vector<size_t> all_pairs_next_;  // The next node from 'from' to 'to'.
 };
 
 }  // namespace visibility_graph
@@ -1,6 +1,15 @@
 #ifndef POLYGON_COVERAGE_GEOMETRY_VISIBILITY_POLYGON_H_
 #define POLYGON_COVERAGE_GEOMETRY_VISIBILITY_POLYGON_H_
 
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <CGAL/Arr_landmarks_point_location.h>
+#include <CGAL/Arr_segment_traits_2.h>
+#include <CGAL/Arrangement_2.h>
+#include <CGAL/Triangular_expansion_visibility_2.h>
+
 #include "polygon_coverage_geometry/cgal_definitions.h"
 
 namespace polygon_coverage_planning {
@@ -13,6 +22,93 @@ bool computeVisibilityPolygon(const PolygonWithHoles& pwh,
                               const Point_2& query_point,
                               Polygon_2* visibility_polygon);
 
+// Compute the visibility polygons of many query points on num_threads threads
+// (0: all hardware threads). Same as
+// ParallelVisibilityPolygonOracle(pwh).computeVisibilityPolygons(...). Reuse a
+// ParallelVisibilityPolygonOracle to answer several batches.
+bool computeVisibilityPolygons(const PolygonWithHoles& pwh,
+                               const std::vector<Point_2>& query_points,
+                               std::vector<Polygon_2>* visibility_polygons,
+                               size_t num_threads = 0);
+
+// Answers many visibility polygon queries in the same polygon. The
+// arrangement, the triangular expansion visibility structure and the landmarks
+// point locator are built once. Queries are serialized, i.e., one oracle can
+// be shared between threads. The oracle works on a deep copy of the polygon and
+// returns deep copies, i.e., it shares no kernel objects with its callers.
+class VisibilityPolygonOracle {
+ public:
+  // Note: The polygon needs to be strictly simple.
+  VisibilityPolygonOracle(const PolygonWithHoles& pwh);
+
+  // Same as computeVisibilityPolygon(pwh, query_point, visibility_polygon).
+  // The query point must not be used by another thread during the query.
+  bool computeVisibilityPolygon(const Point_2& query_point,
+                                Polygon_2* visibility_polygon) const;
+
+  inline const PolygonWithHoles& getPolygon() const { return pwh_; }
+
+ private:
+  typedef CGAL::Arr_segment_traits_2<K> VisibilityTraits;
+  typedef CGAL::Arrangement_2<VisibilityTraits> VisibilityArrangement;
+  typedef CGAL::Triangular_expansion_visibility_2<VisibilityArrangement,
+                                                  CGAL::Tag_true>
+      TEV;
+  typedef CGAL::Arr_landmarks_point_location<VisibilityArrangement>
+      LandmarksPL;
+
+  // Not copyable. The visibility structure and the point locator refer to the
+  // arrangement.
+  VisibilityPolygonOracle(const VisibilityPolygonOracle&) = delete;
+  VisibilityPolygonOracle& operator=(const VisibilityPolygonOracle&) = delete;
+
+  PolygonWithHoles pwh_;
+  VisibilityArrangement arrangement_;
+  VisibilityArrangement::Face_const_handle main_face_;
+  TEV tev_;
+  LandmarksPL pl_;
+  // The visibility structure and the lazy exact kernel are not thread-safe.
+  mutable std::mutex mutex_;
+};
+
+// Answers single queries and batches of visibility polygon queries in the same
+// polygon. Single queries and small batches go to one shared oracle. Larger
+// batches are split between worker oracles, one per thread. The worker oracles
+// are built from deep copies on first use and reused by later batches.
+class ParallelVisibilityPolygonOracle {
+ public:
+  // Note: The polygon needs to be strictly simple.
+  ParallelVisibilityPolygonOracle(const PolygonWithHoles& pwh);
+
+  // Same as VisibilityPolygonOracle::computeVisibilityPolygon.
+  bool computeVisibilityPolygon(const Point_2& query_point,
+                                Polygon_2* visibility_polygon) const;
+  // Compute the visibility polygons of many query points on num_threads
+  // threads (0: all hardware threads).
+  bool computeVisibilityPolygons(const std::vector<Point_2>& query_points,
+                                 std::vector<Polygon_2>* visibility_polygons,
+                                 size_t num_threads = 0) const;
+
+ private:
+  // Batches with fewer queries per thread use fewer threads.
+  static const size_t kMinQueriesPerWorker = 8;
+
+  // Returns num_workers worker oracles, building the missing ones.
+  std::vector<const VisibilityPolygonOracle*> getWorkers(
+      size_t num_workers) const;
+
+  ParallelVisibilityPolygonOracle(const ParallelVisibilityPolygonOracle&) =
+      delete;
+  ParallelVisibilityPolygonOracle& operator=(
+      const ParallelVisibilityPolygonOracle&) = delete;
+
+  // A deep copy to build the worker oracles from. Guarded by workers_mutex_.
+  PolygonWithHoles pwh_;
+  VisibilityPolygonOracle oracle_;
+  mutable std::vector<std::unique_ptr<VisibilityPolygonOracle>> workers_;
+  mutable std::mutex workers_mutex_;
+};
+
 }  // namespace polygon_coverage_planning
 
 #endif  // POLYGON_COVERAGE_GEOMETRY_VISIBILITY_POLYGON_H_
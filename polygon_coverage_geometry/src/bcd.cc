@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <vector>
 
 #include <ros/assert.h>
@@ -7,389 +8,293 @@
 
 namespace polygon_coverage_planning {
 
-std::vector<Polygon_2> computeBCD(const PolygonWithHoles& polygon_in,
-                                  const Direction_2& dir) {
-  // Rotate polygon to have direction aligned with x-axis.
-  // TODO(rikba): Make this independent of rotation.
-  PolygonWithHoles rotated_polygon = rotatePolygon(polygon_in, dir);
-  sortPolygon(&rotated_polygon);
+std::vector<Polygon_2> computeBCD(
+    const PolygonWithHoles& polygon_in, const Direction_2& dir,
+    std::vector<std::set<size_t>>* adjacency) {
+  PolygonWithHoles polygon = polygon_in;
+  sortPolygon(&polygon);
+  const SweepDirection sweep(dir);
 
-  // Sort vertices by x value.
-  std::vector<VertexConstCirculator> sorted_vertices =
-      getXSortedVertices(rotated_polygon);
+  // Sort events along the sweep direction.
+  std::vector<BCDEvent> events = getSortedEvents(polygon, sweep);
 
-  // Initialize edge list.
-  std::list<Segment_2> L;
-  std::list<Polygon_2> open_polygons;
+  // Sweep.
+  const BCDStatusEdgeLess less(sweep);
+  BCDStatus status(less);
+  std::vector<BCDCell> cells;
   std::vector<Polygon_2> closed_polygons;
-  std::vector<Point_2> processed_vertices;
-  for (size_t i = 0; i < sorted_vertices.size(); ++i) {
-    const VertexConstCirculator& v = sorted_vertices[i];
-    // v already processed.
-    if (std::find(processed_vertices.begin(), processed_vertices.end(), *v) !=
-        processed_vertices.end())
-      continue;
-    processEvent(rotated_polygon, v, &sorted_vertices, &processed_vertices, &L,
-                 &open_polygons, &closed_polygons);
+  for (const BCDEvent& event : events) {
+    processEvent(event, sweep, &status, &cells, &closed_polygons);
   }
+  ROS_ASSERT(status.empty());
 
-  // Rotate back all polygons.
-  for (Polygon_2& p : closed_polygons) {
-    CGAL::Aff_transformation_2<K> rotation(CGAL::ROTATION, dir, 1, 1e9);
-    p = CGAL::transform(rotation, p);
+  if (adjacency) {
+    computeBCDAdjacency(cells, sweep, closed_polygons.size(), adjacency);
   }
 
   return closed_polygons;
 }
 
-std::vector<VertexConstCirculator> getXSortedVertices(
-    const PolygonWithHoles& p) {
-  std::vector<VertexConstCirculator> sorted_vertices;
+bool SweepDirection::lessXY(const Point_2& a, const Point_2& b) const {
+  const CGAL::Comparison_result x =
+      CGAL::compare_signed_distance_to_line(x_axis_, a, b);
+  return x == CGAL::SMALLER ||
+         (x == CGAL::EQUAL &&
+          CGAL::compare_signed_distance_to_line(y_axis_, a, b) ==
+              CGAL::SMALLER);
+}
+
+Point_2 SweepDirection::intersect(const Segment_2& s, const Point_2& p) const {
+  const Vector_2 v = s.to_vector();
+  return s.source() + v * (((p - s.source()) * dir_) / (v * dir_));
+}
+
+bool BCDStatusEdgeLess::operator()(const BCDStatusEdge& a,
+                                   const BCDStatusEdge& b) const {
+  const Segment_2& s_a = a.edge;
+  const Segment_2& s_b = b.edge;
+  if (s_a.source() == s_b.source()) {
+    return CGAL::orientation(s_a.source(), s_a.target(), s_b.target()) ==
+           CGAL::LEFT_TURN;
+  }
+  // Compare the left vertex of the edge that starts later with the other edge.
+  if (sweep.lessXY(s_b.source(), s_a.source())) {
+    return CGAL::orientation(s_b.source(), s_b.target(), s_a.source()) ==
+           CGAL::RIGHT_TURN;
+  } else {
+    return CGAL::orientation(s_a.source(), s_a.target(), s_b.source()) ==
+           CGAL::LEFT_TURN;
+  }
+}
 
-  // Get boundary vertices.
-  VertexConstCirculator v = p.outer_boundary().vertices_circulator();
-  do {
-    sorted_vertices.push_back(v);
-  } while (++v != p.outer_boundary().vertices_circulator());
-  // Get hole vertices.
+std::vector<BCDEvent> getSortedEvents(const PolygonWithHoles& p,
+                                      const SweepDirection& sweep) {
+  std::vector<BCDEvent> events;
+
+  // Collect the events of all rings. A vertical run is a single event that is
+  // created at its first vertex.
+  std::vector<const Polygon_2*> rings = {&p.outer_boundary()};
   for (PolygonWithHoles::Hole_const_iterator hit = p.holes_begin();
        hit != p.holes_end(); ++hit) {
-    VertexConstCirculator vh = hit->vertices_circulator();
+    rings.push_back(&*hit);
+  }
+  for (const Polygon_2* ring : rings) {
+    VertexConstCirculator v = ring->vertices_circulator();
     do {
-      sorted_vertices.push_back(vh);
-    } while (++vh != hit->vertices_circulator());
+      if (sweep.equalX(*std::prev(v), *v)) continue;
+      BCDEvent event;
+      event.first = v;
+      event.last = v;
+      while (sweep.equalX(*std::next(event.last), *event.last)) ++event.last;
+      events.push_back(event);
+    } while (++v != ring->vertices_circulator());
   }
-  // Sort x,y.
-  Polygon_2::Traits::Less_xy_2 less_xy_2;
-  std::sort(sorted_vertices.begin(), sorted_vertices.end(),
-            [&less_xy_2](const VertexConstCirculator& a,
-                         const VertexConstCirculator& b) -> bool {
-              return less_xy_2(*a, *b);
-            });
-
-  return sorted_vertices;
-}
 
-PolygonWithHoles rotatePolygon(const PolygonWithHoles& polygon_in,
-                               const Direction_2& dir) {
-  CGAL::Aff_transformation_2<K> rotation(CGAL::ROTATION, dir, 1, 1e9);
-  rotation = rotation.inverse();
-  PolygonWithHoles rotated_polygon = polygon_in;
-  rotated_polygon.outer_boundary() =
-      CGAL::transform(rotation, polygon_in.outer_boundary());
-  PolygonWithHoles::Hole_iterator hit_rot = rotated_polygon.holes_begin();
-  for (PolygonWithHoles::Hole_const_iterator hit = polygon_in.holes_begin();
-       hit != polygon_in.holes_end(); ++hit) {
-    *(hit_rot++) = CGAL::transform(rotation, *hit);
-  }
+  // Sort x,y by the lowest vertex of every event.
+  auto lowest = [&sweep](const BCDEvent& e) -> const Point_2& {
+    return sweep.lessXY(*e.last, *e.first) ? *e.last : *e.first;
+  };
+  std::sort(events.begin(), events.end(),
+            [&sweep, &lowest](const BCDEvent& a, const BCDEvent& b) {
+              return sweep.lessXY(lowest(a), lowest(b));
+            });
 
-  return rotated_polygon;
+  return events;
 }
 
-void processEvent(const PolygonWithHoles& pwh, const VertexConstCirculator& v,
-                  std::vector<VertexConstCirculator>* sorted_vertices,
-                  std::vector<Point_2>* processed_vertices,
-                  std::list<Segment_2>* L, std::list<Polygon_2>* open_polygons,
+void processEvent(const BCDEvent& event, const SweepDirection& sweep,
+                  BCDStatus* status,
+                  std::vector<BCDCell>* cells,
                   std::vector<Polygon_2>* closed_polygons) {
-  ROS_ASSERT(sorted_vertices);
-  ROS_ASSERT(processed_vertices);
-  ROS_ASSERT(L);
-  ROS_ASSERT(open_polygons);
+  ROS_ASSERT(status);
+  ROS_ASSERT(cells);
   ROS_ASSERT(closed_polygons);
 
-  Polygon_2::Traits::Equal_2 eq_2;
-
-  // Compute intersection.
-  Line_2 l(*v, Direction_2(0, 1));
-  std::vector<Point_2> intersections = getIntersections(*L, l);
-
-  // Get e_lower and e_upper.
-  Segment_2 e_prev(*v, *std::prev(v));
-  Segment_2 e_next(*v, *std::next(v));
-  // Catch vertical edges.
-  Polygon_2::Traits::Equal_x_2 eq_x_2;
-  if (eq_x_2(e_prev.source(), e_prev.target())) {
-    e_prev = Segment_2(*std::prev(v), *std::prev(v, 2));
-  } else if (eq_x_2(e_next.source(), e_next.target())) {
-    e_next = Segment_2(*std::next(v), *std::next(v, 2));
-  }
+  // The non-vertical edges entering and leaving the event in polygon order.
+  // Polygon order keeps the free space to the left, i.e., an edge traversed
+  // from left to right is a floor.
+  const Point_2& first = *event.first;
+  const Point_2& last = *event.last;
+  const Point_2& prev = *std::prev(event.first);
+  const Point_2& next = *std::next(event.last);
+  const bool in_starts = sweep.lessX(first, prev);
+  const bool out_starts = sweep.lessX(last, next);
+  BCDStatusEdge e_in;
+  e_in.edge = in_starts ? Segment_2(first, prev) : Segment_2(prev, first);
+  e_in.is_floor = !in_starts;
+  BCDStatusEdge e_out;
+  e_out.edge = out_starts ? Segment_2(last, next) : Segment_2(next, last);
+  e_out.is_floor = out_starts;
+  auto intersect = [&sweep, &first](const BCDStatusEdge& e) -> Point_2 {
+    return sweep.intersect(e.edge, first);
+  };
+
+  if (in_starts && out_starts) {
+    // IN: Open one cell, or close one and open two.
+    BCDStatus::iterator in_it = status->insert(e_in).first;
+    BCDStatus::iterator out_it = status->insert(e_out).first;
+    const bool in_is_lower = status->key_comp()(e_in, e_out);
+    BCDStatus::iterator lower = in_is_lower ? in_it : out_it;
+    BCDStatus::iterator upper = in_is_lower ? out_it : in_it;
+    const Point_2& p_lower = in_is_lower ? first : last;
+    const Point_2& p_upper = in_is_lower ? last : first;
+
+    if (lower->is_floor) {
+      BCDCell cell;
+      cell.floor.push_back(p_lower);
+      cell.ceiling.push_back(p_upper);
+      lower->cell = upper->cell = cells->size();
+      cells->push_back(cell);
+    } else {
+      // The new edges split the cell between e_LOWER and e_UPPER.
+      ROS_ASSERT(lower != status->begin());
+      ROS_ASSERT(std::next(upper) != status->end());
+      BCDStatus::iterator e_LOWER = std::prev(lower);
+      BCDStatus::iterator e_UPPER = std::next(upper);
+      ROS_ASSERT(e_LOWER->cell == e_UPPER->cell);
+      const Point_2 p_LOWER = intersect(*e_LOWER);
+      const Point_2 p_UPPER = intersect(*e_UPPER);
 
-  Polygon_2::Traits::Less_y_2 less_y_2;
-  Polygon_2::Traits::Less_x_2 less_x_2;
-  Segment_2 e_lower = e_prev;
-  Segment_2 e_upper = e_next;
-  if (less_x_2(e_prev.target(), e_prev.source()) &&
-      less_x_2(e_next.target(), e_next.source())) {  // OUT
-
-    Point_2 p_on_upper = eq_2(e_lower.source(), e_upper.source())
-                             ? e_upper.target()
-                             : e_upper.source();
-    if (e_lower.supporting_line().has_on_positive_side(p_on_upper))
-      std::swap(e_lower, e_upper);
-
-    // Determine whether we close one or close two and open one.
-    // TODO(rikba): instead of looking at unbounded side, look at adjacent edge
-    // angle
-    bool close_one = outOfPWH(pwh, *v + Vector_2(1e-6, 0));
-
-    // Find edges to remove.
-    std::list<Segment_2>::iterator e_lower_it = L->begin();
-    size_t e_lower_id = 0;
-    for (; e_lower_it != L->end(); ++e_lower_it) {
-      if (*e_lower_it == e_lower || *e_lower_it == e_lower.opposite()) {
-        break;
-      }
-      e_lower_id++;
+      // Close one cell.
+      BCDCell& cell = (*cells)[e_LOWER->cell];
+      cell.floor.push_back(p_LOWER);
+      cell.ceiling.push_back(p_UPPER);
+      closeCell(&cell, closed_polygons);
+
+      // Open two new cells.
+      BCDCell lower_cell;
+      lower_cell.floor.push_back(p_LOWER);
+      lower_cell.ceiling.push_back(p_lower);
+      e_LOWER->cell = lower->cell = cells->size();
+      cells->push_back(lower_cell);
+      BCDCell upper_cell;
+      upper_cell.floor.push_back(p_upper);
+      upper_cell.ceiling.push_back(p_UPPER);
+      upper->cell = e_UPPER->cell = cells->size();
+      cells->push_back(upper_cell);
     }
-
-    std::list<Segment_2>::iterator e_upper_it = std::next(e_lower_it);
-    size_t e_upper_id = e_lower_id + 1;
-    size_t lower_cell_id = e_lower_id / 2;
-    size_t upper_cell_id = e_upper_id / 2;
-
-    if (close_one) {
-      std::list<Polygon_2>::iterator cell =
-          std::next(open_polygons->begin(), lower_cell_id);
-      cell->push_back(e_lower.source());
-      Polygon_2::Traits::Equal_2 eq_2;
-      if (!eq_2(e_lower.source(), e_upper.source())) {
-        cell->push_back(e_upper.source());
-      }
-      if (cleanupPolygon(&*cell)) closed_polygons->push_back(*cell);
-      L->erase(e_lower_it);
-      L->erase(e_upper_it);
-      open_polygons->erase(cell);
+  } else if (!in_starts && !out_starts) {
+    // OUT: Close one cell, or close two and open one.
+    BCDStatus::iterator in_it = status->find(e_in);
+    BCDStatus::iterator out_it = status->find(e_out);
+    ROS_ASSERT(in_it != status->end());
+    ROS_ASSERT(out_it != status->end());
+    const bool in_is_lower = status->key_comp()(e_in, e_out);
+    BCDStatus::iterator lower = in_is_lower ? in_it : out_it;
+    BCDStatus::iterator upper = in_is_lower ? out_it : in_it;
+    const Point_2& p_lower = in_is_lower ? first : last;
+    const Point_2& p_upper = in_is_lower ? last : first;
+
+    if (lower->is_floor) {
+      ROS_ASSERT(lower->cell == upper->cell);
+      BCDCell& cell = (*cells)[lower->cell];
+      cell.floor.push_back(p_lower);
+      cell.ceiling.push_back(p_upper);
+      closeCell(&cell, closed_polygons);
     } else {
-      // Close two cells, open one.
+      // The edges separate the cells between e_LOWER and e_UPPER.
+      ROS_ASSERT(lower != status->begin());
+      ROS_ASSERT(std::next(upper) != status->end());
+      BCDStatus::iterator e_LOWER = std::prev(lower);
+      BCDStatus::iterator e_UPPER = std::next(upper);
+      const Point_2 p_LOWER = intersect(*e_LOWER);
+      const Point_2 p_UPPER = intersect(*e_UPPER);
+
       // Close lower cell.
-      ROS_ASSERT(e_lower_id > 0);
-      ROS_ASSERT(intersections.size() > e_upper_id + 1);
-      std::list<Polygon_2>::iterator lower_cell =
-          std::next(open_polygons->begin(), lower_cell_id);
-      lower_cell->push_back(intersections[e_lower_id - 1]);
-      lower_cell->push_back(intersections[e_lower_id]);
-      if (cleanupPolygon(&*lower_cell)) closed_polygons->push_back(*lower_cell);
+      BCDCell& lower_cell = (*cells)[lower->cell];
+      lower_cell.floor.push_back(p_LOWER);
+      lower_cell.ceiling.push_back(p_lower);
+      closeCell(&lower_cell, closed_polygons);
       // Close upper cell.
-      std::list<Polygon_2>::iterator upper_cell =
-          std::next(open_polygons->begin(), upper_cell_id);
-      upper_cell->push_back(intersections[e_upper_id]);
-      upper_cell->push_back(intersections[e_upper_id + 1]);
-      if (cleanupPolygon(&*upper_cell)) closed_polygons->push_back(*upper_cell);
-
-      // Delete e_lower and e_upper from list.
-      L->erase(e_lower_it);
-      L->erase(e_upper_it);
+      BCDCell& upper_cell = (*cells)[upper->cell];
+      upper_cell.floor.push_back(p_upper);
+      upper_cell.ceiling.push_back(p_UPPER);
+      closeCell(&upper_cell, closed_polygons);
 
       // Open one new cell.
-      std::list<Polygon_2>::iterator new_polygon =
-          open_polygons->insert(lower_cell, Polygon_2());
-      new_polygon->push_back(intersections[e_upper_id + 1]);
-      new_polygon->push_back(intersections[e_lower_id - 1]);
-
-      open_polygons->erase(lower_cell);
-      open_polygons->erase(upper_cell);
-    }
-    processed_vertices->push_back(e_lower.source());
-    if (!eq_2(e_lower.source(), e_upper.source())) {
-      processed_vertices->push_back(e_upper.source());
-    }
-  } else if (!less_x_2(e_lower.target(), e_lower.source()) &&
-             !less_x_2(e_upper.target(), e_upper.source())) {
-    // IN
-    Polygon_2::Traits::Equal_2 eq_2;
-    Point_2 p_on_lower = eq_2(e_lower.source(), e_upper.source())
-                             ? e_lower.target()
-                             : e_lower.source();
-    if (e_upper.supporting_line().has_on_positive_side(p_on_lower))
-      std::swap(e_lower, e_upper);
-
-    // Determine whether we open one or close one and open two.
-    bool open_one = outOfPWH(pwh, *v - Vector_2(1e-6, 0));
-
-    // Find edge to update.
-    size_t e_LOWER_id = 0;
-    bool found_e_lower_id = false;
-    for (size_t i = 0; i < intersections.size() - 1; i = i + 2) {
-      if (intersections.empty()) break;
-      if (open_one) {
-        if (less_y_2(intersections[i], e_lower.source()) &&
-            less_y_2(intersections[i + 1], e_upper.source())) {
-          e_LOWER_id = i;
-          found_e_lower_id = true;
-        }
-      } else {
-        if (less_y_2(intersections[i], e_lower.source()) &&
-            less_y_2(e_upper.source(), intersections[i + 1])) {
-          e_LOWER_id = i;
-        }
-      }
-    }
-    if (open_one) {
-      // Add one new cell above e_UPPER.
-      std::list<Segment_2>::iterator e_UPPER = L->begin();
-      std::list<Polygon_2>::iterator open_cell = open_polygons->begin();
-      if (!L->empty() && found_e_lower_id) {
-        e_UPPER = std::next(e_UPPER, e_LOWER_id + 1);
-        open_cell = std::next(open_cell, e_LOWER_id / 2 + 1);
-      }
-      // Update edge list.
-      if (L->empty()) {
-        L->insert(L->end(), e_lower);
-        L->insert(L->end(), e_upper);
-      } else if (!L->empty() && !found_e_lower_id) {
-        L->insert(L->begin(), e_upper);
-        L->insert(L->begin(), e_lower);
-      } else {
-        std::list<Segment_2>::iterator inserter = std::next(e_UPPER);
-        L->insert(inserter, e_lower);
-        L->insert(inserter, e_upper);
-      }
-
-      // Create new polygon.
-      std::list<Polygon_2>::iterator open_polygon =
-          open_polygons->insert(open_cell, Polygon_2());
-      open_polygon->push_back(e_upper.source());
-      if (!eq_2(e_lower.source(), e_upper.source())) {
-        open_polygon->push_back(e_lower.source());
-      }
-    } else {
-      // Add new polygon between e_LOWER and e_UPPER.
-      std::list<Segment_2>::iterator e_LOWER =
-          std::next(L->begin(), e_LOWER_id);
-      std::list<Polygon_2>::iterator cell =
-          std::next(open_polygons->begin(), e_LOWER_id / 2);
-
-      // Add e_lower and e_upper
-      std::list<Segment_2>::iterator e_lower_it =
-          L->insert(std::next(e_LOWER), e_lower);
-      L->insert(std::next(e_lower_it), e_upper);
-
-      // Add new cell.
-      std::list<Polygon_2>::iterator new_polygon =
-          open_polygons->insert(cell, Polygon_2());
-
-      // Close one cell.
-      cell->push_back(intersections[e_LOWER_id]);
-      cell->push_back(intersections[e_LOWER_id + 1]);
-      if (cleanupPolygon(&*cell)) closed_polygons->push_back(*cell);
-      // Open two new cells
-      // Lower polygon.
-      new_polygon->push_back(e_lower.source());
-      new_polygon->push_back(intersections[e_LOWER_id]);
-
-      // Upper polygon.
-      new_polygon = open_polygons->insert(cell, Polygon_2());
-      new_polygon->push_back(intersections[e_LOWER_id + 1]);
-      new_polygon->push_back(e_upper.source());
-      // Close old cell.
-      open_polygons->erase(cell);
-    }
-    processed_vertices->push_back(e_lower.source());
-    if (!eq_2(e_lower.source(), e_upper.source())) {
-      processed_vertices->push_back(e_upper.source());
+      BCDCell cell;
+      cell.floor.push_back(p_LOWER);
+      cell.ceiling.push_back(p_UPPER);
+      e_LOWER->cell = e_UPPER->cell = cells->size();
+      cells->push_back(cell);
     }
+    status->erase(in_it);
+    status->erase(out_it);
   } else {
-    // TODO(rikba): Sort vertices correctly in the first place.
-    // Check if v exits among edges.
-    VertexConstCirculator v_middle = v;
-    std::list<Segment_2>::iterator it = L->end();
-    while (it == L->end()) {
-      for (it = L->begin(); it != L->end(); it++) {
-        if (*v_middle == it->source() || *v_middle == it->target()) {
-          // Swap v in sorted vertices.
-          if (!eq_2(*v, *v_middle)) {
-            std::vector<VertexConstCirculator>::iterator i_v =
-                sorted_vertices->end();
-            std::vector<VertexConstCirculator>::iterator i_v_middle =
-                sorted_vertices->end();
-            for (std::vector<VertexConstCirculator>::iterator it =
-                     sorted_vertices->begin();
-                 it != sorted_vertices->end(); ++it) {
-              if (*it == v) i_v = it;
-              if (*it == v_middle) i_v_middle = it;
-            }
-            ROS_ASSERT(i_v != sorted_vertices->end());
-            ROS_ASSERT(i_v_middle != sorted_vertices->end());
-            std::iter_swap(i_v, i_v_middle);
-          }
-          break;
-        }
-      }
-      if (it == L->end()) {
-        VertexConstCirculator v_prev = std::prev(v_middle);
-        VertexConstCirculator v_next = std::next(v_middle);
-        ROS_ASSERT(v_prev->x() != v_next->x());
-        ROS_ASSERT(v_prev->x() == v_middle->x() ||
-                   v_next->x() == v_middle->x());
-        if (v_prev->x() == v_middle->x())
-          v_middle = v_prev;
-        else
-          v_middle = v_next;
-      }
-    }
-
-    // Correct vertical edges.
-    e_prev = Segment_2(*v_middle, *std::prev(v_middle));
-    e_next = Segment_2(*v_middle, *std::next(v_middle));
-
-    // Find edge to update.
-    std::list<Segment_2>::iterator old_e_it = L->begin();
-    Segment_2 new_edge;
-    size_t edge_id = 0;
-    for (; old_e_it != L->end(); ++old_e_it) {
-      if (*old_e_it == e_next || *old_e_it == e_next.opposite()) {
-        new_edge = e_prev;
-        break;
-      } else if (*old_e_it == e_prev || *old_e_it == e_prev.opposite()) {
-        new_edge = e_next;
-        break;
-      }
-      edge_id++;
-    }
-    ROS_ASSERT(old_e_it != L->end());
-
-    // Update cell with new vertex.
-    size_t cell_id = edge_id / 2;
-    std::list<Polygon_2>::iterator cell =
-        std::next(open_polygons->begin(), cell_id);
-
-    if ((edge_id % 2) == 0) {
-      // Case 1: Insert new vertex at end.
-      cell->push_back(new_edge.source());
-    } else {
-      // Case 2: Insert new vertex at begin.
-      cell->insert(cell->vertices_begin(), new_edge.source());
-    }
-    // Update edge.
-    L->insert(old_e_it, new_edge);
-    L->erase(old_e_it);
+    // Replace the ending edge with the starting edge. The event extends the
+    // cell's floor or ceiling from left to right.
+    const BCDStatusEdge& e_old = in_starts ? e_out : e_in;
+    BCDStatusEdge e_new = in_starts ? e_in : e_out;
+    const Point_2& p_old = in_starts ? last : first;
+    const Point_2& p_new = in_starts ? first : last;
+
+    BCDStatus::iterator old_it = status->find(e_old);
+    ROS_ASSERT(old_it != status->end());
+    e_new.cell = old_it->cell;
+    BCDCell& cell = (*cells)[e_new.cell];
+    std::vector<Point_2>& chain = e_new.is_floor ? cell.floor : cell.ceiling;
+    chain.push_back(p_old);
+    if (p_new != p_old) chain.push_back(p_new);
+
+    status->insert(status->erase(old_it), e_new);
+  }
+}
 
-    processed_vertices->push_back(*v_middle);
+void closeCell(BCDCell* cell, std::vector<Polygon_2>* closed_polygons) {
+  ROS_ASSERT(cell);
+  ROS_ASSERT(closed_polygons);
+  Polygon_2 poly(cell->floor.begin(), cell->floor.end());
+  for (std::vector<Point_2>::const_reverse_iterator it =
+           cell->ceiling.rbegin();
+       it != cell->ceiling.rend(); ++it) {
+    poly.push_back(*it);
+  }
+  if (cleanupPolygon(&poly)) {
+    cell->polygon = closed_polygons->size();
+    closed_polygons->push_back(poly);
   }
 }
-std::vector<Point_2> getIntersections(const std::list<Segment_2>& L,
-                                      const Line_2& l) {
-  typedef CGAL::cpp11::result_of<Intersect_2(Segment_2, Line_2)>::type
-      Intersection;
-
-  std::vector<Point_2> intersections(L.size());
-  std::vector<Point_2>::iterator intersection = intersections.begin();
-  for (std::list<Segment_2>::const_iterator it = L.begin(); it != L.end();
-       ++it) {
-    Intersection result = CGAL::intersection(*it, l);
-    if (result) {
-      if (boost::get<Segment_2>(&*result)) {
-        *(intersection++) = it->target();
-      } else {
-        const Point_2* p = boost::get<Point_2>(&*result);
-        *(intersection++) = *p;
+
+void computeBCDAdjacency(const std::vector<BCDCell>& cells,
+                         const SweepDirection& sweep, size_t num_polygons,
+                         std::vector<std::set<size_t>>* adjacency) {
+  ROS_ASSERT(adjacency);
+  adjacency->assign(num_polygons, std::set<size_t>());
+
+  // Sort the left and the right cuts of all valid cells by x.
+  std::vector<size_t> left, right;
+  for (size_t i = 0; i < cells.size(); ++i) {
+    if (cells[i].polygon >= num_polygons) continue;
+    left.push_back(i);
+    right.push_back(i);
+  }
+  std::sort(left.begin(), left.end(), [&cells, &sweep](size_t a, size_t b) {
+    return sweep.lessX(cells[a].floor.front(), cells[b].floor.front());
+  });
+  std::sort(right.begin(), right.end(), [&cells, &sweep](size_t a, size_t b) {
+    return sweep.lessX(cells[a].floor.back(), cells[b].floor.back());
+  });
+
+  // Merge both lists. Pair the cuts on the same sweep line that overlap.
+  std::vector<size_t>::const_iterator l = left.begin();
+  for (std::vector<size_t>::const_iterator r = right.begin(); r != right.end();
+       ++r) {
+    const BCDCell& rc = cells[*r];
+    while (l != left.end() &&
+           sweep.lessX(cells[*l].floor.front(), rc.floor.back()))
+      ++l;
+    for (std::vector<size_t>::const_iterator it = l;
+         it != left.end() &&
+         sweep.equalX(cells[*it].floor.front(), rc.floor.back());
+         ++it) {
+      const BCDCell& lc = cells[*it];
+      if (sweep.lessY(rc.floor.back(), lc.ceiling.front()) &&
+          sweep.lessY(lc.floor.front(), rc.ceiling.back())) {
+        (*adjacency)[rc.polygon].insert(lc.polygon);
+        (*adjacency)[lc.polygon].insert(rc.polygon);
       }
-    } else {
-      ROS_ERROR_STREAM("No intersection found!");
     }
   }
-
-  return intersections;
 }
 
 void sortPolygon(PolygonWithHoles* pwh) {
@@ -419,17 +324,4 @@ bool cleanupPolygon(Polygon_2* poly) {
   return poly->is_simple() && poly->area() != 0.0;
 }
 
-bool outOfPWH(const PolygonWithHoles& pwh, const Point_2& p) {
-  if (pwh.outer_boundary().has_on_unbounded_side(p)) return true;
-
-  for (PolygonWithHoles::Hole_const_iterator hit = pwh.holes_begin();
-       hit != pwh.holes_end(); ++hit) {
-    if (hit->has_on_bounded_side(p)) {
-      return true;
-    }
-  }
-
-  return false;
-}
-
 }  // namespace polygon_coverage_planning
@@ -1,5 +1,8 @@
 #include "polygon_coverage_geometry/cgal_comm.h"
 
+#include <algorithm>
+#include <numeric>
+
 #include <ros/assert.h>
 
 namespace polygon_coverage_planning {
@@ -137,4 +140,76 @@ void simplifyPolygon(PolygonWithHoles* pwh) {
     simplifyPolygon(&*hi);
 }
 
+Point_2 deepCopy(const Point_2& p) {
+  return Point_2(FT(CGAL::exact(p.x())), FT(CGAL::exact(p.y())));
+}
+
+Direction_2 deepCopy(const Direction_2& d) {
+  return Direction_2(FT(CGAL::exact(d.dx())), FT(CGAL::exact(d.dy())));
+}
+
+Polygon_2 deepCopy(const Polygon_2& poly) {
+  Polygon_2 copy;
+  for (VertexConstIterator vit = poly.vertices_begin();
+       vit != poly.vertices_end(); ++vit)
+    copy.push_back(deepCopy(*vit));
+  return copy;
+}
+
+PolygonWithHoles deepCopy(const PolygonWithHoles& pwh) {
+  PolygonWithHoles copy(deepCopy(pwh.outer_boundary()));
+  for (PolygonWithHoles::Hole_const_iterator hit = pwh.holes_begin();
+       hit != pwh.holes_end(); ++hit)
+    copy.add_hole(deepCopy(*hit));
+  return copy;
+}
+
+void computeCellAdjacency(const std::vector<Polygon_2>& cells,
+                          std::vector<std::set<size_t>>* adjacency) {
+  ROS_ASSERT(adjacency);
+  adjacency->assign(cells.size(), std::set<size_t>());
+
+  // Sort the bounding boxes by their left side.
+  std::vector<CGAL::Bbox_2> bboxes(cells.size());
+  for (size_t i = 0; i < cells.size(); ++i) bboxes[i] = cells[i].bbox();
+  std::vector<size_t> order(cells.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&bboxes](size_t a, size_t b) {
+    return bboxes[a].xmin() < bboxes[b].xmin();
+  });
+
+  // Only compare cells whose boxes overlap. Adjacent cells have touching
+  // boxes, which do_overlap counts as overlapping.
+  for (size_t k = 0; k < order.size(); ++k) {
+    const size_t i = order[k];
+    for (size_t l = k + 1;
+         l < order.size() && bboxes[order[l]].xmin() <= bboxes[i].xmax(); ++l) {
+      const size_t j = order[l];
+      if (!CGAL::do_overlap(bboxes[i], bboxes[j])) continue;
+      if (shareBoundarySegment(cells[i], cells[j])) {
+        (*adjacency)[i].insert(j);
+        (*adjacency)[j].insert(i);
+      }
+    }
+  }
+}
+
+bool shareBoundarySegment(const Polygon_2& a, const Polygon_2& b) {
+  for (EdgeConstIterator ea = a.edges_begin(); ea != a.edges_end(); ++ea) {
+    const CGAL::Bbox_2 bbox_a = ea->bbox();
+    for (EdgeConstIterator eb = b.edges_begin(); eb != b.edges_end(); ++eb) {
+      if (!CGAL::do_overlap(bbox_a, eb->bbox())) continue;
+      if (!CGAL::collinear(ea->source(), ea->target(), eb->source()) ||
+          !CGAL::collinear(ea->source(), ea->target(), eb->target()))
+        continue;
+      // Collinear edges overlap if the larger of the lower endpoints lies
+      // before the smaller of the upper endpoints.
+      const Point_2 low = std::max(ea->min(), eb->min(), K::Less_xy_2());
+      const Point_2 high = std::min(ea->max(), eb->max(), K::Less_xy_2());
+      if (CGAL::compare_xy(low, high) == CGAL::SMALLER) return true;
+    }
+  }
+  return false;
+}
+
 }  // namespace polygon_coverage_planning
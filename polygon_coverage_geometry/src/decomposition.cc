@@ -0,0 +1,267 @@
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <iterator>
+#include <limits>
+
+#include <CGAL/Polygon_vertical_decomposition_2.h>
+#include <polygon_coverage_solvers/parallel_for.h>
+#include <ros/assert.h>
+#include <ros/console.h>
+
+#include "polygon_coverage_geometry/bcd.h"
+#include "polygon_coverage_geometry/cgal_comm.h"
+#include "polygon_coverage_geometry/decomposition.h"
+#include "polygon_coverage_geometry/weakly_monotone.h"
+
+namespace polygon_coverage_planning {
+
+double findBestSweepDir(const Polygon_2& cell, Direction_2* best_dir) {
+  double min_altitude = std::numeric_limits<double>::max();
+  for (const Direction_2& dir : getAllSweepableEdgeDirections(cell)) {
+    const Line_2 x_axis(Point_2(CGAL::ORIGIN), dir);
+    const Point_2& south = *findSouth(cell, x_axis);
+    const Point_2& north = *findNorth(cell, x_axis);
+    const double altitude = std::sqrt(
+        CGAL::to_double(CGAL::squared_distance(Line_2(south, dir), north)));
+    if (altitude < min_altitude) {
+      min_altitude = altitude;
+      if (best_dir) *best_dir = dir;
+    }
+  }
+
+  return min_altitude;
+}
+
+double computeMinAltitudeLowerBound(const Polygon_2& cell) {
+  // A region of area A that fits into a disk of diameter d has a width of at
+  // least A / d in any direction. The bounding box diagonal bounds d.
+  const CGAL::Bbox_2 bbox = cell.bbox();
+  const double diameter =
+      std::hypot(bbox.xmax() - bbox.xmin(), bbox.ymax() - bbox.ymin());
+  if (diameter == 0.0) return 0.0;
+  // The tolerance absorbs the rounding of the altitudes.
+  const double kTolerance = 1.0 - 1.0e-6;
+  return kTolerance * std::fabs(CGAL::to_double(cell.area())) / diameter;
+}
+
+double computeDecompositionLowerBound(const PolygonWithHoles& pwh,
+                                      const Direction_2& dir) {
+  // Every cell of area A_i has a width of at least A_i / d_i, see
+  // computeMinAltitudeLowerBound. All cells fit into the bounding box of the
+  // polygon in the frame of dir, so its diagonal d bounds every d_i, and the
+  // cell areas sum up to the area of the polygon.
+  const double dx = CGAL::to_double(dir.dx());
+  const double dy = CGAL::to_double(dir.dy());
+  const double norm = std::hypot(dx, dy);
+  double min_u = std::numeric_limits<double>::max();
+  double min_v = min_u;
+  double max_u = std::numeric_limits<double>::lowest();
+  double max_v = max_u;
+  for (VertexConstIterator vit = pwh.outer_boundary().vertices_begin();
+       vit != pwh.outer_boundary().vertices_end(); ++vit) {
+    const double x = CGAL::to_double(vit->x());
+    const double y = CGAL::to_double(vit->y());
+    const double u = (dx * x + dy * y) / norm;
+    const double v = (dx * y - dy * x) / norm;
+    min_u = std::min(min_u, u);
+    max_u = std::max(max_u, u);
+    min_v = std::min(min_v, v);
+    max_v = std::max(max_v, v);
+  }
+  const double diameter = std::hypot(max_u - min_u, max_v - min_v);
+  if (diameter == 0.0) return 0.0;
+  // The tolerance absorbs the rounding of the altitudes.
+  const double kTolerance = 1.0 - 1.0e-6;
+  return kTolerance * CGAL::to_double(computeArea(pwh)) / diameter;
+}
+
+std::vector<Direction_2> findPerpEdgeDirections(const PolygonWithHoles& pwh) {
+  // Get all edge directions. Skip collinear ones.
+  std::vector<Direction_2> directions;
+  auto add_edge_directions = [&directions](const Polygon_2& poly) {
+    for (EdgeConstIterator it = poly.edges_begin(); it != poly.edges_end();
+         ++it) {
+      const Direction_2 dir = it->direction();
+      if (std::none_of(directions.begin(), directions.end(),
+                       [&dir](const Direction_2& d) {
+                         return CGAL::orientation(d.vector(), dir.vector()) ==
+                                CGAL::COLLINEAR;
+                       })) {
+        directions.push_back(dir);
+      }
+    }
+  };
+  add_edge_directions(pwh.outer_boundary());
+  for (PolygonWithHoles::Hole_const_iterator hit = pwh.holes_begin();
+       hit != pwh.holes_end(); ++hit)
+    add_edge_directions(*hit);
+
+  // Perpendicular directions and their opposites.
+  const size_t num_directions = directions.size();
+  for (size_t i = 0; i < num_directions; ++i) {
+    directions[i] = Direction_2(-directions[i].dy(), directions[i].dx());
+  }
+  for (size_t i = 0; i < num_directions; ++i) {
+    directions.push_back(-directions[i]);
+  }
+
+  return directions;
+}
+
+bool computeBestDecomposition(const PolygonWithHoles& pwh,
+                              const DecompositionFunction& decompose,
+                              size_t num_threads, std::vector<Polygon_2>* cells,
+                              std::vector<std::set<size_t>>* adjacency) {
+  ROS_ASSERT(cells);
+  cells->clear();
+  if (adjacency) adjacency->clear();
+
+  // Get all possible decomposition directions and bound their decompositions
+  // from below.
+  std::vector<Direction_2> directions = findPerpEdgeDirections(pwh);
+  std::vector<double> lower_bounds(directions.size());
+  for (size_t i = 0; i < directions.size(); ++i) {
+    lower_bounds[i] = computeDecompositionLowerBound(pwh, directions[i]);
+  }
+
+  // Every direction gets its own deep copy of the polygon. The decompositions
+  // only share kernel objects with their copy.
+  std::vector<PolygonWithHoles> polygons;
+  polygons.reserve(directions.size());
+  for (Direction_2& dir : directions) {
+    dir = deepCopy(dir);
+    polygons.push_back(deepCopy(pwh));
+  }
+
+  // Decompose and score the directions in ascending order of their lower
+  // bounds.
+  std::vector<size_t> order(directions.size());
+  for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+  std::sort(order.begin(), order.end(), [&lower_bounds](size_t a, size_t b) {
+    return lower_bounds[a] < lower_bounds[b] ||
+           (lower_bounds[a] == lower_bounds[b] && a < b);
+  });
+  const double kInfinity = std::numeric_limits<double>::max();
+  std::atomic<double> best_sum(kInfinity);
+  std::atomic<size_t> num_decomposed(0);
+  std::vector<double> min_altitude_sums(directions.size(), kInfinity);
+  std::vector<std::vector<Polygon_2>> decompositions(directions.size());
+  std::vector<std::vector<std::set<size_t>>> adjacencies(
+      adjacency ? directions.size() : 0);
+  parallelFor(order.size(), num_threads, [&](size_t k) {
+    // Branch and bound: skip the direction if it cannot be the best.
+    const size_t i = order[k];
+    if (lower_bounds[i] > best_sum.load()) return;
+
+    // Calculate decomposition.
+    std::vector<Polygon_2> decomposition;
+    std::vector<std::set<size_t>> decomposition_adjacency;
+    num_decomposed++;
+    if (!decompose(polygons[i], directions[i], &decomposition,
+                   adjacency ? &decomposition_adjacency : nullptr)) {
+      ROS_WARN_STREAM("Failed to compute decomposition.");
+      return;
+    }
+
+    // Calculate minimum altitude sum for each cell. Abandon the direction if
+    // it cannot be the best anymore.
+    double cell_lower_bound_sum = 0.0;
+    for (const Polygon_2& cell : decomposition) {
+      cell_lower_bound_sum += computeMinAltitudeLowerBound(cell);
+    }
+    if (cell_lower_bound_sum > best_sum.load()) return;
+    double min_altitude_sum = 0.0;
+    for (const Polygon_2& cell : decomposition) {
+      min_altitude_sum += findBestSweepDir(cell);
+      if (min_altitude_sum > best_sum.load()) return;
+    }
+
+    // Update best sum.
+    double best = best_sum.load();
+    while (min_altitude_sum < best &&
+           !best_sum.compare_exchange_weak(best, min_altitude_sum)) {
+    }
+    min_altitude_sums[i] = min_altitude_sum;
+    decompositions[i] = std::move(decomposition);
+    if (adjacency) adjacencies[i] = std::move(decomposition_adjacency);
+  });
+  size_t num_scored = 0;
+  for (double min_altitude_sum : min_altitude_sums) {
+    if (min_altitude_sum < kInfinity) num_scored++;
+  }
+  ROS_DEBUG_STREAM("Decomposed " << num_decomposed.load() << " and scored "
+                                 << num_scored << " of " << directions.size()
+                                 << " decomposition directions.");
+
+  // Select the best decomposition. Ties go to the first direction as in a
+  // serial evaluation.
+  size_t best_id = directions.size();
+  for (size_t i = 0; i < directions.size(); ++i) {
+    if (min_altitude_sums[i] < kInfinity &&
+        (best_id == directions.size() ||
+         min_altitude_sums[i] < min_altitude_sums[best_id])) {
+      best_id = i;
+    }
+  }
+  if (best_id == directions.size()) return false;
+  *cells = std::move(decompositions[best_id]);
+  if (adjacency) *adjacency = std::move(adjacencies[best_id]);
+
+  return !cells->empty();
+}
+
+bool computeBestBCDFromPolygonWithHoles(
+    const PolygonWithHoles& pwh, std::vector<Polygon_2>* bcd_polygons,
+    size_t num_threads, std::vector<std::set<size_t>>* adjacency) {
+  return computeBestDecomposition(
+      pwh,
+      [](const PolygonWithHoles& p, const Direction_2& dir,
+         std::vector<Polygon_2>* cells,
+         std::vector<std::set<size_t>>* cell_adjacency) {
+        *cells = computeBCD(p, dir, cell_adjacency);
+        return true;
+      },
+      num_threads, bcd_polygons, adjacency);
+}
+
+std::vector<Polygon_2> computeTCD(const PolygonWithHoles& pwh,
+                                  const Direction_2& dir) {
+  std::vector<Polygon_2> traps;
+  CGAL::Polygon_vertical_decomposition_2<K> decompose;
+  if (dir == Direction_2(1, 0)) {
+    decompose(pwh, std::back_inserter(traps));
+    return traps;
+  }
+
+  // Rotate dir onto the x-axis. The rotation is rational, i.e., rotating the
+  // cells back is exact.
+  const CGAL::Aff_transformation_2<K> rotation(CGAL::ROTATION, dir, 1, 1e3);
+  const CGAL::Aff_transformation_2<K> inverse = rotation.inverse();
+  PolygonWithHoles rotated(CGAL::transform(inverse, pwh.outer_boundary()));
+  for (PolygonWithHoles::Hole_const_iterator hit = pwh.holes_begin();
+       hit != pwh.holes_end(); ++hit) {
+    rotated.add_hole(CGAL::transform(inverse, *hit));
+  }
+  decompose(rotated, std::back_inserter(traps));
+
+  // Reverse rotation.
+  for (Polygon_2& trap : traps) trap = CGAL::transform(rotation, trap);
+  return traps;
+}
+
+bool computeBestTCDFromPolygonWithHoles(const PolygonWithHoles& pwh,
+                                        std::vector<Polygon_2>* trap_polygons,
+                                        size_t num_threads) {
+  return computeBestDecomposition(
+      pwh,
+      [](const PolygonWithHoles& p, const Direction_2& dir,
+         std::vector<Polygon_2>* cells,
+         std::vector<std::set<size_t>>* /*adjacency*/) {
+        *cells = computeTCD(p, dir);
+        return true;
+      },
+      num_threads, trap_polygons);
+}
+
+}  // namespace polygon_coverage_planning
@@ -14,6 +14,7 @@
 #include <CGAL/partition_2.h>
 #include <glog/logging.h>
 #include <mav_coverage_planning_comm/eigen_conversions.h>
+#include <polygon_coverage_geometry/decomposition.h>
 #include <boost/make_shared.hpp>
 
 #include "mav_2d_coverage_planning/geometry/bcd_exact.h"
@@ -65,6 +66,30 @@ std::vector<std::vector<Point_2>> Polygon::getHoleVertices() const {
   return hole_vertices;
 }
 
+bool Polygon::computeTrapezoidalDecompositionFromPolygonWithHoles(
+    const Direction_2& dir, std::vector<Polygon>* trap_polygons) const {
+  CHECK_NOTNULL(trap_polygons);
+  if (dir == Direction_2(1, 0)) {
+    return computeTrapezoidalDecompositionFromPolygonWithHoles(trap_polygons);
+  }
+
+  const Polygon rotated_poly = rotatePolygon({dir}).front();
+  if (!rotated_poly.computeTrapezoidalDecompositionFromPolygonWithHoles(
+          trap_polygons)) {
+    return false;
+  }
+
+  // Reverse rotation.
+  CGAL::Aff_transformation_2<K> rotation(CGAL::ROTATION, dir, 1, 1e3);
+  for (Polygon& trap : *trap_polygons) {
+    Polygon_2 trap_2 = trap.getPolygon().outer_boundary();
+    trap_2 = CGAL::transform(rotation, trap_2);
+    trap = Polygon(trap_2, trap.getPlaneTransformation());
+  }
+
+  return true;
+}
+
 bool Polygon::computeTrapezoidalDecompositionFromPolygonWithHoles(
     std::vector<Polygon>* trap_polygons) const {
   CHECK_NOTNULL(trap_polygons);
@@ -173,104 +198,34 @@ double Polygon::findMinAltitude(const Polygon& subregion,
 }
 
 bool Polygon::computeBestTrapezoidalDecompositionFromPolygonWithHoles(
-    std::vector<Polygon>* trap_polygons) const {
+    std::vector<Polygon>* trap_polygons, size_t num_threads) const {
   CHECK_NOTNULL(trap_polygons);
   trap_polygons->clear();
-  double min_altitude_sum = std::numeric_limits<double>::max();
-
-  // Get all possible decomposition directions.
-  std::vector<Direction_2> directions = findPerpEdgeDirections();
-  std::vector<Polygon> rotated_polys = rotatePolygon(directions);
-
-  // For all possible rotations:
-  Direction_2 best_direction = directions.front();
-  CHECK_EQ(rotated_polys.size(), directions.size());
-  for (size_t i = 0; i < rotated_polys.size(); ++i) {
-    // Calculate decomposition.
-    std::vector<Polygon> traps;
-    if (!rotated_polys[i].computeTrapezoidalDecompositionFromPolygonWithHoles(
-            &traps)) {
-      LOG(WARNING) << "Failed to compute trapezoidal decomposition.";
-      continue;
-    }
-
-    // Calculate minimum altitude sum for each cell.
-    double min_altitude_sum_tmp = 0.0;
-    for (const Polygon& trap : traps) {
-      min_altitude_sum_tmp += findMinAltitude(trap);
-    }
-
-    // Update best decomposition.
-    if (min_altitude_sum_tmp < min_altitude_sum) {
-      min_altitude_sum = min_altitude_sum_tmp;
-      *trap_polygons = traps;
-      best_direction = directions[i];
-    }
-  }
 
-  // Reverse trap rotation.
-  CGAL::Aff_transformation_2<K> rotation(CGAL::ROTATION, best_direction, 1,
-                                         1e3);
-  for (Polygon& trap : *trap_polygons) {
-    Polygon_2 trap_2 = trap.getPolygon().outer_boundary();
-    trap_2 = CGAL::transform(rotation, trap_2);
-    trap = Polygon(trap_2, trap.getPlaneTransformation());
+  std::vector<Polygon_2> traps;
+  if (!polygon_coverage_planning::computeBestTCDFromPolygonWithHoles(
+          polygon_, &traps, num_threads)) {
+    return false;
   }
 
-  if (trap_polygons->empty())
-    return false;
-  else
-    return true;
+  for (const Polygon_2& trap : traps) trap_polygons->emplace_back(trap);
+  return true;
 }
 
 bool Polygon::computeBestBCDFromPolygonWithHoles(
-    std::vector<Polygon>* bcd_polygons) const {
+    std::vector<Polygon>* bcd_polygons, size_t num_threads,
+    std::vector<std::set<size_t>>* adjacency) const {
   CHECK_NOTNULL(bcd_polygons);
   bcd_polygons->clear();
-  double min_altitude_sum = std::numeric_limits<double>::max();
-
-  // Get all possible decomposition directions.
-  std::vector<Direction_2> directions = findPerpEdgeDirections();
-  std::vector<Polygon> rotated_polys = rotatePolygon(directions);
-
-  // For all possible rotations:
-  Direction_2 best_direction = directions.front();
-  CHECK_EQ(rotated_polys.size(), directions.size());
-  for (size_t i = 0; i < rotated_polys.size(); ++i) {
-    // Calculate decomposition.
-    std::vector<Polygon> bcds;
-    if (!rotated_polys[i].computeBCDFromPolygonWithHoles(&bcds)) {
-      LOG(WARNING) << "Failed to compute boustrophedon decomposition.";
-      continue;
-    }
-
-    // Calculate minimum altitude sum for each cell.
-    double min_altitude_sum_tmp = 0.0;
-    for (const Polygon& bcd : bcds) {
-      min_altitude_sum_tmp += findMinAltitude(bcd);
-    }
 
-    // Update best decomposition.
-    if (min_altitude_sum_tmp < min_altitude_sum) {
-      min_altitude_sum = min_altitude_sum_tmp;
-      *bcd_polygons = bcds;
-      best_direction = directions[i];
-    }
-  }
-
-  // Reverse bcd rotation.
-  CGAL::Aff_transformation_2<K> rotation(CGAL::ROTATION, best_direction, 1,
-                                         1e3);
-  for (Polygon& bcd : *bcd_polygons) {
-    Polygon_2 bcd_2 = bcd.getPolygon().outer_boundary();
-    bcd_2 = CGAL::transform(rotation, bcd_2);
-    bcd = Polygon(bcd_2, bcd.getPlaneTransformation());
+  std::vector<Polygon_2> bcds;
+  if (!polygon_coverage_planning::computeBestBCDFromPolygonWithHoles(
+          polygon_, &bcds, num_threads, adjacency)) {
+    return false;
   }
 
-  if (bcd_polygons->empty())
-    return false;
-  else
-    return true;
+  for (const Polygon_2& p : bcds) bcd_polygons->emplace_back(p);
+  return true;
 }
 
 std::vector<Direction_2> Polygon::getUniformDirections(const int num) const {
@@ -285,13 +240,12 @@ std::vector<Direction_2> Polygon::getUniformDirections(const int num) const {
 }
 
 bool Polygon::computeBCDFromPolygonWithHoles(
-    std::vector<Polygon>* bcd_polygons) const {
+    const Direction_2& dir, std::vector<Polygon>* bcd_polygons) const {
   CHECK_NOTNULL(bcd_polygons);
   bcd_polygons->clear();
 
   BCD bcd(polygon_);
-  std::vector<Polygon_2> polygons =
-      computeBCDExact(polygon_, Direction_2(1, 0));
+  std::vector<Polygon_2> polygons = computeBCDExact(polygon_, dir);
 
   for (const Polygon_2& p : polygons) {
     bcd_polygons->emplace_back(p);
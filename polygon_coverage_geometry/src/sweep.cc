@@ -1,7 +1,9 @@
 #include "polygon_coverage_geometry/sweep.h"
+#include "polygon_coverage_geometry/cgal_comm.h"
 #include "polygon_coverage_geometry/visibility_polygon.h"
 #include "polygon_coverage_geometry/weakly_monotone.h"
 
+#include <CGAL/Cartesian_converter.h>
 #include <ros/assert.h>
 #include <ros/console.h>
 
@@ -13,33 +15,76 @@ bool computeSweep(const Polygon_2& in,
                   bool counter_clockwise, std::vector<Point_2>* waypoints) {
   ROS_ASSERT(waypoints);
   waypoints->clear();
-  const FT kSqOffset = offset * offset;
-
-  // Assertions.
-  // TODO(rikba): Check monotone perpendicular to dir.
-  if (!in.is_counterclockwise_oriented()) return false;
-
-  // Find start sweep.
-  Line_2 sweep(Point_2(0.0, 0.0), dir);
-  std::vector<Point_2> sorted_pts = sortVerticesToLine(in, sweep);
-  sweep = Line_2(sorted_pts.front(), dir);
-
-  Vector_2 offset_vector = sweep.perpendicular(sorted_pts.front()).to_vector();
-  offset_vector = offset * offset_vector /
-                  std::sqrt(CGAL::to_double(offset_vector.squared_length()));
-  const CGAL::Aff_transformation_2<K> kOffset(CGAL::TRANSLATION, offset_vector);
-
-  Segment_2 sweep_segment;
-  bool has_sweep_segment = findSweepSegment(in, sweep, &sweep_segment);
-  while (has_sweep_segment) {
-    // Align sweep segment.
-    if (counter_clockwise) sweep_segment = sweep_segment.opposite();
+
+  std::vector<Segment_2> sweep_segments;
+  std::vector<visibility_graph::QueryNode> sources, targets;
+  return computeSweepSegments(in, offset, dir, &sweep_segments) &&
+         createSweepSegmentQueries(visibility_graph, sweep_segments, &sources,
+                                   &targets) &&
+         connectSweepSegments(visibility_graph, sweep_segments, sources,
+                              targets, counter_clockwise, waypoints);
+}
+
+bool createSweepSegmentQueries(
+    const visibility_graph::VisibilityGraph& visibility_graph,
+    const std::vector<Segment_2>& sweep_segments,
+    std::vector<visibility_graph::QueryNode>* sources,
+    std::vector<visibility_graph::QueryNode>* targets) {
+  ROS_ASSERT(sources);
+  ROS_ASSERT(targets);
+  sources->resize(sweep_segments.size());
+  targets->resize(sweep_segments.size());
+
+  for (size_t i = 0; i < sweep_segments.size(); ++i) {
+    for (bool is_source : {true, false}) {
+      const Point_2& p = is_source ? sweep_segments[i].source()
+                                   : sweep_segments[i].target();
+      visibility_graph::QueryNode* query =
+          is_source ? &(*sources)[i] : &(*targets)[i];
+      Polygon_2 visibility;
+      if (!visibility_graph.computeVisibility(p, &visibility) ||
+          !visibility_graph.createQueryNode(p, visibility, query)) {
+        ROS_ERROR_STREAM("Cannot compute visibility polygon from query point "
+                         << p
+                         << " in polygon: " << visibility_graph.getPolygon());
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool connectSweepSegments(
+    const visibility_graph::VisibilityGraph& visibility_graph,
+    const std::vector<Segment_2>& sweep_segments,
+    const std::vector<visibility_graph::QueryNode>& sources,
+    const std::vector<visibility_graph::QueryNode>& targets,
+    bool counter_clockwise, std::vector<Point_2>* waypoints) {
+  ROS_ASSERT(waypoints);
+  ROS_ASSERT(sources.size() == sweep_segments.size());
+  ROS_ASSERT(targets.size() == sweep_segments.size());
+  waypoints->clear();
+
+  for (size_t i = 0; i < sweep_segments.size(); ++i) {
+    // Align sweep segment. The direction swaps every sweep.
+    const bool reverse = (i % 2 == 0) == counter_clockwise;
+    const Segment_2 sweep_segment =
+        reverse ? sweep_segments[i].opposite() : sweep_segments[i];
     // Connect previous sweep.
-    if (!waypoints->empty()) {
+    if (i > 0) {
+      const bool reverse_prev = !reverse;
+      const visibility_graph::QueryNode& from =
+          reverse_prev ? sources[i - 1] : targets[i - 1];
+      const visibility_graph::QueryNode& to =
+          reverse ? targets[i] : sources[i];
       std::vector<Point_2> shortest_path;
-      if (!calculateShortestPath(visibility_graph, waypoints->back(),
-                                 sweep_segment.source(), &shortest_path))
+      if (!visibility_graph.solve(from, to, &shortest_path) ||
+          shortest_path.size() < 2) {
+        ROS_ERROR_STREAM("Cannot compute shortest path from "
+                         << from.coordinates << " to " << to.coordinates
+                         << " in polygon: " << visibility_graph.getPolygon());
         return false;
+      }
       for (std::vector<Point_2>::iterator it = std::next(shortest_path.begin());
            it != std::prev(shortest_path.end()); ++it) {
         waypoints->push_back(*it);
@@ -49,87 +94,46 @@ bool computeSweep(const Polygon_2& in,
     waypoints->push_back(sweep_segment.source());
     if (!sweep_segment.is_degenerate())
       waypoints->push_back(sweep_segment.target());
-
-    // Offset sweep.
-    sweep = sweep.transform(kOffset);
-    // Find new sweep segment.
-    Segment_2 prev_sweep_segment =
-        counter_clockwise ? sweep_segment.opposite() : sweep_segment;
-    has_sweep_segment = findSweepSegment(in, sweep, &sweep_segment);
-    // Add a final sweep.
-    if (!has_sweep_segment &&
-        !((!waypoints->empty() &&
-           *std::prev(waypoints->end(), 1) == sorted_pts.back()) ||
-          (waypoints->size() > 1 &&
-           *std::prev(waypoints->end(), 2) == sorted_pts.back()))) {
-      sweep = Line_2(sorted_pts.back(), dir);
-      has_sweep_segment = findSweepSegment(in, sweep, &sweep_segment);
-      if (!has_sweep_segment) {
-        ROS_ERROR_STREAM("Failed to calculate final sweep.");
-        return false;
-      }
-      // Do not add super close sweep.
-      if (CGAL::squared_distance(sweep_segment, prev_sweep_segment) < 0.1)
-        break;
-    }
-    // Check observability of vertices between sweeps.
-    if (has_sweep_segment) {
-      std::vector<Point_2>::const_iterator unobservable_point =
-          sorted_pts.end();
-      checkObservability(prev_sweep_segment, sweep_segment, sorted_pts,
-                         kSqOffset, &unobservable_point);
-      if (unobservable_point != sorted_pts.end()) {
-        sweep = Line_2(*unobservable_point, dir);
-        has_sweep_segment = findSweepSegment(in, sweep, &sweep_segment);
-        if (!has_sweep_segment) {
-          ROS_ERROR_STREAM("Failed to calculate extra sweep at point: "
-                           << *unobservable_point);
-          return false;
-        }
-      }
-    }
-
-    // Swap directions.
-    counter_clockwise = !counter_clockwise;
   }
 
   return true;
 }
 
-bool findSweepSegment(const Polygon_2& p, const Line_2& l,
-                      Segment_2* sweep_segment) {
-  std::vector<Point_2> intersections = findIntersections(p, l);
-  if (intersections.empty()) return false;
-  *sweep_segment = Segment_2(intersections.front(), intersections.back());
-  return true;
-}
+bool computeInexactSweepSegments(const Polygon_2& in, const FT offset,
+                                 const Direction_2& dir,
+                                 std::vector<Segment_2>* sweep_segments) {
+  ROS_ASSERT(sweep_segments);
+  sweep_segments->clear();
 
-void checkObservability(
-    const Segment_2& prev_sweep, const Segment_2& sweep,
-    const std::vector<Point_2>& sorted_pts, const FT max_sq_distance,
-    std::vector<Point_2>::const_iterator* lowest_unobservable_point) {
-  ROS_ASSERT(lowest_unobservable_point);
-  *lowest_unobservable_point = sorted_pts.end();
-
-  // Find first point that is between prev_sweep and sweep and unobservable.
-  for (std::vector<Point_2>::const_iterator it = sorted_pts.begin();
-       it != sorted_pts.end(); ++it) {
-    if (prev_sweep.supporting_line().has_on_positive_side(*it)) continue;
-    if (sweep.supporting_line().has_on_negative_side(*it)) {
-      break;
-    }
-    FT sq_distance_prev = CGAL::squared_distance(prev_sweep, *it);
-    FT sq_distance_curr = CGAL::squared_distance(sweep, *it);
-    if (sq_distance_prev > max_sq_distance &&
-        sq_distance_curr > max_sq_distance) {
-      *lowest_unobservable_point = it;
-      return;
-    }
+  const CGAL::Cartesian_converter<K, InexactKernel> to_inexact;
+  const CGAL::Cartesian_converter<InexactKernel, K> to_exact;
+  CGAL::Polygon_2<InexactKernel> inexact_in;
+  for (VertexConstIterator it = in.vertices_begin(); it != in.vertices_end();
+       ++it) {
+    inexact_in.push_back(to_inexact(*it));
+  }
+  std::vector<CGAL::Segment_2<InexactKernel>> inexact_segments;
+  if (!computeSweepSegments(inexact_in, CGAL::to_double(offset),
+                            to_inexact(dir), &inexact_segments)) {
+    return false;
   }
+
+  // The visibility queries require the endpoints to lie in the polygon.
+  const PolygonWithHoles pwh(in);
+  sweep_segments->reserve(inexact_segments.size());
+  for (const CGAL::Segment_2<InexactKernel>& s : inexact_segments) {
+    Point_2 source = to_exact(s.source());
+    Point_2 target = to_exact(s.target());
+    if (!pointInPolygon(pwh, source)) source = projectPointOnHull(pwh, source);
+    if (!pointInPolygon(pwh, target)) target = projectPointOnHull(pwh, target);
+    sweep_segments->emplace_back(source, target);
+  }
+  return true;
 }
 
 bool computeAllSweeps(const Polygon_2& poly, const double max_sweep_offset,
-                      std::vector<std::vector<Point_2>>* cluster_sweeps) {
+                      std::vector<std::vector<Point_2>>* cluster_sweeps,
+                      bool use_inexact_kernel) {
   ROS_ASSERT(cluster_sweeps);
   cluster_sweeps->clear();
   cluster_sweeps->reserve(2 * poly.size());
@@ -137,31 +141,40 @@ bool computeAllSweeps(const Polygon_2& poly, const double max_sweep_offset,
   // Find all sweepable directions.
   std::vector<Direction_2> dirs = getAllSweepableEdgeDirections(poly);
 
-  // Compute all possible sweeps.
+  // Compute all possible sweeps. Counter-clockwise and clockwise sweeps share
+  // the sweep segments and their endpoint visibility.
   visibility_graph::VisibilityGraph vis_graph(poly);
   for (const Direction_2& dir : dirs) {
-    bool counter_clockwise = true;
-    std::vector<Point_2> sweep;
-    if (!computeSweep(poly, vis_graph, max_sweep_offset, dir, counter_clockwise,
-                      &sweep)) {
-      ROS_ERROR_STREAM("Cannot compute counter-clockwise sweep.");
+    std::vector<Segment_2> sweep_segments;
+    std::vector<visibility_graph::QueryNode> sources, targets;
+    const bool success =
+        use_inexact_kernel
+            ? computeInexactSweepSegments(poly, max_sweep_offset, dir,
+                                          &sweep_segments)
+            : computeSweepSegments(poly, FT(max_sweep_offset), dir,
+                                   &sweep_segments);
+    if (!success ||
+        !createSweepSegmentQueries(vis_graph, sweep_segments, &sources,
+                                   &targets)) {
+      ROS_ERROR_STREAM("Cannot compute sweep segments.");
       return false;
-    } else {
-      ROS_ASSERT(!sweep.empty());
-      cluster_sweeps->push_back(sweep);
-      std::reverse(sweep.begin(), sweep.end());
-      cluster_sweeps->push_back(sweep);
     }
 
-    if (!computeSweep(poly, vis_graph, max_sweep_offset, dir,
-                      !counter_clockwise, &sweep)) {
-      ROS_ERROR_STREAM("Cannot compute clockwise sweep.");
-      return false;
-    } else {
-      ROS_ASSERT(!sweep.empty());
-      cluster_sweeps->push_back(sweep);
-      std::reverse(sweep.begin(), sweep.end());
-      cluster_sweeps->push_back(sweep);
+    for (bool counter_clockwise : {true, false}) {
+      std::vector<Point_2> sweep;
+      if (!connectSweepSegments(vis_graph, sweep_segments, sources, targets,
+                                counter_clockwise, &sweep)) {
+        ROS_ERROR_STREAM("Cannot compute "
+                         << (counter_clockwise ? "counter-clockwise"
+                                               : "clockwise")
+                         << " sweep.");
+        return false;
+      } else {
+        ROS_ASSERT(!sweep.empty());
+        cluster_sweeps->push_back(sweep);
+        std::reverse(sweep.begin(), sweep.end());
+        cluster_sweeps->push_back(sweep);
+      }
     }
   }
   return true;
@@ -175,15 +188,13 @@ bool calculateShortestPath(
   shortest_path->clear();
 
   Polygon_2 start_visibility, goal_visibility;
-  if (!computeVisibilityPolygon(visibility_graph.getPolygon(), start,
-                                &start_visibility)) {
+  if (!visibility_graph.computeVisibility(start, &start_visibility)) {
     ROS_ERROR_STREAM("Cannot compute visibility polygon from start query point "
                      << start
                      << " in polygon: " << visibility_graph.getPolygon());
     return false;
   }
-  if (!computeVisibilityPolygon(visibility_graph.getPolygon(), goal,
-                                &goal_visibility)) {
+  if (!visibility_graph.computeVisibility(goal, &goal_visibility)) {
     ROS_ERROR_STREAM("Cannot compute visibility polygon from goal query point "
                      << goal
                      << " in polygon: " << visibility_graph.getPolygon());
@@ -205,49 +216,4 @@ bool calculateShortestPath(
   return true;
 }
 
-std::vector<Point_2> sortVerticesToLine(const Polygon_2& p, const Line_2& l) {
-  // Copy points.
-  std::vector<Point_2> pts(p.size());
-  std::vector<Point_2>::iterator pts_it = pts.begin();
-  for (VertexConstIterator it = p.vertices_begin(); it != p.vertices_end();
-       ++it) {
-    *(pts_it++) = *it;
-  }
-
-  // Sort.
-  std::sort(pts.begin(), pts.end(),
-            [&l](const Point_2& a, const Point_2& b) -> bool {
-              return CGAL::has_smaller_signed_distance_to_line(l, a, b);
-            });
-
-  return pts;
-}
-
-std::vector<Point_2> findIntersections(const Polygon_2& p, const Line_2& l) {
-  std::vector<Point_2> intersections;
-  typedef CGAL::cpp11::result_of<Intersect_2(Segment_2, Line_2)>::type
-      Intersection;
-
-  for (EdgeConstIterator it = p.edges_begin(); it != p.edges_end(); ++it) {
-    Intersection result = CGAL::intersection(*it, l);
-    if (result) {
-      if (const Segment_2* s = boost::get<Segment_2>(&*result)) {
-        intersections.push_back(s->source());
-        intersections.push_back(s->target());
-      } else {
-        intersections.push_back(*boost::get<Point_2>(&*result));
-      }
-    }
-  }
-
-  // Sort.
-  Line_2 perp_l = l.perpendicular(l.point(0));
-  std::sort(intersections.begin(), intersections.end(),
-            [&perp_l](const Point_2& a, const Point_2& b) -> bool {
-              return CGAL::has_smaller_signed_distance_to_line(perp_l, a, b);
-            });
-
-  return intersections;
-}
-
 }  // namespace polygon_coverage_planning
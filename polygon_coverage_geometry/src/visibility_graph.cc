@@ -2,6 +2,14 @@
 #include "polygon_coverage_geometry/cgal_comm.h"
 #include "polygon_coverage_geometry/visibility_polygon.h"
 
+#include <polygon_coverage_solvers/parallel_for.h>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+
 #include <ros/assert.h>
 #include <ros/console.h>
 
@@ -9,32 +17,46 @@ namespace polygon_coverage_planning {
 namespace visibility_graph {
 
 VisibilityGraph::VisibilityGraph(const PolygonWithHoles& polygon)
-    : GraphBase(), polygon_(polygon) {
+    : GraphBase(),
+      polygon_(polygon),
+      visibility_oracle_(std::make_shared<ParallelVisibilityPolygonOracle>(polygon)),
+      has_all_pairs_(false) {
   // Build visibility graph.
   is_created_ = create();
 }
 
 bool VisibilityGraph::create() {
   clear();
+  has_all_pairs_ = false;
+  all_pairs_cost_.clear();
+  all_pairs_next_.clear();
   // Select shortest path vertices.
   std::vector<VertexConstCirculator> graph_vertices;
   findConcaveOuterBoundaryVertices(&graph_vertices);
   findConvexHoleVertices(&graph_vertices);
 
+  // Compute visibility polygons.
+  std::vector<Point_2> points;
+  points.reserve(graph_vertices.size());
   for (const VertexConstCirculator& v : graph_vertices) {
-    // Compute visibility polygon.
-    Polygon_2 visibility;
-    if (!computeVisibilityPolygon(polygon_, *v, &visibility)) {
-      ROS_ERROR_STREAM("Cannot compute visibility polygon.");
-      return false;
-    }
-    if (!addNode(NodeProperty(*v, visibility))) {
+    points.push_back(*v);
+  }
+  std::vector<Polygon_2> visibility;
+  if (!computeVisibility(points, &visibility)) {
+    ROS_ERROR_STREAM("Cannot compute visibility polygon.");
+    return false;
+  }
+
+  reserve(points.size());
+  for (size_t i = 0; i < points.size(); ++i) {
+    if (!addNode(NodeProperty(points[i], visibility[i]))) {
       return false;
     }
   }
+  freeze();
 
   ROS_DEBUG_STREAM("Created visibility graph with "
-                   << graph_.size() << " nodes and " << edge_properties_.size()
+                   << graph_.size() << " nodes and " << getNumberOfEdges()
                    << " edges.");
 
   return true;
@@ -118,8 +140,8 @@ bool VisibilityGraph::solve(const Point_2& start, const Point_2& goal,
 
   // Compute start and goal visibility polygon.
   Polygon_2 start_visibility, goal_visibility;
-  if (!computeVisibilityPolygon(polygon_, start_new, &start_visibility) ||
-      !computeVisibilityPolygon(polygon_, goal_new, &goal_visibility)) {
+  if (!computeVisibility(start_new, &start_visibility) ||
+      !computeVisibility(goal_new, &goal_visibility)) {
     return false;
   }
 
@@ -136,48 +158,261 @@ bool VisibilityGraph::solve(const Point_2& start,
   ROS_ASSERT(waypoints);
   waypoints->clear();
 
+  QueryNode start_node, goal_node;
+  if (!createQueryNode(start, start_visibility_polygon, &start_node) ||
+      !createQueryNode(goal, goal_visibility_polygon, &goal_node)) {
+    return false;
+  }
+
+  return solve(start_node, goal_node, waypoints);
+}
+
+bool VisibilityGraph::createQueryNode(const Point_2& point,
+                                      const Polygon_2& visibility,
+                                      QueryNode* query_node) const {
+  ROS_ASSERT(query_node);
+
   if (!is_created_) {
     ROS_ERROR_STREAM("Visibility graph not initialized.");
     return false;
-  } else if (!pointInPolygon(polygon_, start) ||
-             !pointInPolygon(polygon_, goal)) {
+  } else if (!pointInPolygon(polygon_, point)) {
     ROS_ERROR_STREAM("Start or goal is not in polygon.");
     return false;
   }
 
-  VisibilityGraph temp_visibility_graph = *this;
-  // Add start and goal node.
-  if (!temp_visibility_graph.addStartNode(
-          NodeProperty(start, start_visibility_polygon)) ||
-      !temp_visibility_graph.addGoalNode(
-          NodeProperty(goal, goal_visibility_polygon))) {
+  query_node->coordinates = point;
+  query_node->visibility = visibility;
+  query_node->visible_nodes.clear();
+  for (size_t id = 0; id < graph_.size(); ++id) {
+    const NodeProperty* node_property = getNodeProperty(id);
+    if (node_property == nullptr) {
+      ROS_ERROR_STREAM("Cannot access potential neighbor.");
+      return false;
+    }
+    if (pointInPolygon(visibility, node_property->coordinates)) {
+      query_node->visible_nodes.emplace_back(
+          id, computeEuclideanSegmentCost(point, node_property->coordinates));
+    }
+  }
+  return true;
+}
+
+bool VisibilityGraph::solve(const QueryNode& start, const QueryNode& goal,
+                            std::vector<Point_2>* waypoints) const {
+  ROS_ASSERT(waypoints);
+  waypoints->clear();
+
+  if (!is_created_) {
+    ROS_ERROR_STREAM("Visibility graph not initialized.");
     return false;
   }
 
   // Check if start and goal are in line of sight.
-  size_t start_idx = temp_visibility_graph.getStartIdx();
-  size_t goal_idx = temp_visibility_graph.getGoalIdx();
-  const NodeProperty* start_node_property =
-      temp_visibility_graph.getNodeProperty(start_idx);
-  if (start_node_property == nullptr) {
+  if (pointInPolygon(start.visibility, goal.coordinates)) {
+    waypoints->push_back(start.coordinates);
+    waypoints->push_back(goal.coordinates);
+    return true;
+  }
+
+  if (has_all_pairs_) {
+    return solveAllPairs(start, goal, waypoints);
+  }
+
+  // A* on the graph extended by a virtual start and goal node. Start and goal
+  // are connected through their visible nodes instead of graph edges.
+  const size_t num_nodes = graph_.size();
+  const size_t start_idx = num_nodes;
+  const size_t goal_idx = num_nodes + 1;
+  const double kInfinity = std::numeric_limits<double>::max();
+  std::vector<double> cost(num_nodes + 2, kInfinity);  // Cost from start.
+  std::vector<double> heuristic(num_nodes + 2, -1.0);  // Computed on demand.
+  std::vector<size_t> came_from(num_nodes + 2, start_idx);
+  std::vector<bool> closed(num_nodes + 2, false);
+  std::vector<double> goal_cost(num_nodes, kInfinity);  // Cost to goal.
+  for (const std::pair<size_t, double>& n : goal.visible_nodes) {
+    goal_cost[n.first] = n.second;
+  }
+  heuristic[goal_idx] = 0.0;
+
+  // first: cost + heuristic
+  // second: node id
+  typedef std::pair<double, size_t> OpenSetEntry;
+  std::priority_queue<OpenSetEntry, std::vector<OpenSetEntry>,
+                      std::greater<OpenSetEntry>>
+      open_set;
+  auto relax = [&](size_t current, size_t n, double edge_cost) {
+    if (closed[n]) {
+      return;  // Ignore already evaluated neighbors.
+    }
+    const double tentative_cost = cost[current] + edge_cost;
+    if (tentative_cost >= cost[n]) {
+      return;  // This is not a better path to n.
+    }
+    came_from[n] = current;
+    cost[n] = tentative_cost;
+    if (heuristic[n] < 0.0) {
+      heuristic[n] = computeEuclideanSegmentCost(
+          node_properties_[n].coordinates, goal.coordinates);
+    }
+    open_set.emplace(cost[n] + heuristic[n], n);
+  };
+
+  cost[start_idx] = 0.0;
+  closed[start_idx] = true;
+  for (const std::pair<size_t, double>& n : start.visible_nodes) {
+    relax(start_idx, n.first, n.second);
+  }
+  while (!open_set.empty() && !closed[goal_idx]) {
+    const size_t current = open_set.top().second;
+    open_set.pop();
+    if (closed[current]) {
+      continue;  // Outdated entry.
+    }
+    closed[current] = true;
+    if (current == goal_idx) {
+      break;
+    }
+    forEachNeighbor(current, [&](size_t n, double edge_cost) {
+      relax(current, n, edge_cost);
+      return true;
+    });
+    if (goal_cost[current] < kInfinity) {
+      relax(current, goal_idx, goal_cost[current]);
+    }
+  }
+
+  if (!closed[goal_idx]) {
+    ROS_ERROR_STREAM(
+        "Could not find shortest path. Graph not fully connected.");
     return false;
   }
-  if (pointInPolygon(start_node_property->visibility, goal)) {
-    waypoints->push_back(start);
-    waypoints->push_back(goal);
-    return true;
+
+  // Reconstruct waypoints.
+  waypoints->push_back(goal.coordinates);
+  for (size_t id = came_from[goal_idx]; id != start_idx; id = came_from[id]) {
+    waypoints->push_back(node_properties_[id].coordinates);
   }
+  waypoints->push_back(start.coordinates);
+  std::reverse(waypoints->begin(), waypoints->end());
+  return true;
+}
+
+bool VisibilityGraph::precomputeAllPairs(size_t num_threads) {
+  if (!is_created_) {
+    ROS_ERROR_STREAM("Visibility graph not initialized.");
+    return false;
+  }
+
+  const size_t num_nodes = graph_.size();
+  const double kInfinity = std::numeric_limits<double>::max();
+  all_pairs_cost_.assign(num_nodes * num_nodes, kInfinity);
+  all_pairs_next_.assign(num_nodes * num_nodes,
+                         std::numeric_limits<size_t>::max());
+
+  // The graph is undirected. The predecessor of a node in the shortest path
+  // tree of a source is the next node from this node to the source. Every
+  // search writes its own column.
+  parallelFor(num_nodes, num_threads, [this, num_nodes,
+                                       kInfinity](size_t source) {
+    std::vector<double> cost(num_nodes, kInfinity);
+    std::vector<bool> closed(num_nodes, false);
+    // first: cost
+    // second: node id
+    typedef std::pair<double, size_t> OpenSetEntry;
+    std::priority_queue<OpenSetEntry, std::vector<OpenSetEntry>,
+                        std::greater<OpenSetEntry>>
+        open_set;
+    cost[source] = 0.0;
+    all_pairs_next_[source * num_nodes + source] = source;
+    open_set.emplace(0.0, source);
+    while (!open_set.empty()) {
+      const size_t current = open_set.top().second;
+      open_set.pop();
+      if (closed[current]) {
+        continue;  // Outdated entry.
+      }
+      closed[current] = true;
+      all_pairs_cost_[current * num_nodes + source] = cost[current];
+      forEachNeighbor(current, [&](size_t n, double edge_cost) {
+        const double tentative_cost = cost[current] + edge_cost;
+        if (!closed[n] && tentative_cost < cost[n]) {
+          cost[n] = tentative_cost;
+          all_pairs_next_[n * num_nodes + source] = current;
+          open_set.emplace(tentative_cost, n);
+        }
+        return true;
+      });
+    }
+  });
 
-  // Find shortest way using A*.
-  Solution solution;
-  if (!temp_visibility_graph.solveAStar(start_idx, goal_idx, &solution)) {
+  has_all_pairs_ = true;
+  ROS_DEBUG_STREAM("Precomputed all-pairs shortest paths between "
+                   << num_nodes << " nodes.");
+  return true;
+}
+
+bool VisibilityGraph::solveAllPairs(const QueryNode& start,
+                                    const QueryNode& goal,
+                                    std::vector<Point_2>* waypoints) const {
+  ROS_ASSERT(waypoints);
+  waypoints->clear();
+
+  // Cheapest combination of first and last graph node.
+  const size_t num_nodes = graph_.size();
+  const double kInfinity = std::numeric_limits<double>::max();
+  double best_cost = kInfinity;
+  size_t first = 0, last = 0;
+  for (const std::pair<size_t, double>& s : start.visible_nodes) {
+    for (const std::pair<size_t, double>& g : goal.visible_nodes) {
+      const double path_cost = all_pairs_cost_[s.first * num_nodes + g.first];
+      if (path_cost == kInfinity) {
+        continue;  // Not connected.
+      }
+      const double cost = s.second + path_cost + g.second;
+      if (cost < best_cost) {
+        best_cost = cost;
+        first = s.first;
+        last = g.first;
+      }
+    }
+  }
+  if (best_cost == kInfinity) {
     ROS_ERROR_STREAM(
         "Could not find shortest path. Graph not fully connected.");
     return false;
   }
 
   // Reconstruct waypoints.
-  return temp_visibility_graph.getWaypoints(solution, waypoints);
+  waypoints->push_back(start.coordinates);
+  waypoints->push_back(node_properties_[first].coordinates);
+  for (size_t id = first; id != last;) {
+    id = all_pairs_next_[id * num_nodes + last];
+    waypoints->push_back(node_properties_[id].coordinates);
+  }
+  waypoints->push_back(goal.coordinates);
+  return true;
+}
+
+bool VisibilityGraph::computeVisibility(const Point_2& query_point,
+                                        Polygon_2* visibility) const {
+  ROS_ASSERT(visibility);
+  if (visibility_oracle_ == nullptr) {
+    ROS_ERROR_STREAM("Visibility oracle not initialized.");
+    return false;
+  }
+  return visibility_oracle_->computeVisibilityPolygon(query_point, visibility);
+}
+
+bool VisibilityGraph::computeVisibility(
+    const std::vector<Point_2>& query_points,
+    std::vector<Polygon_2>* visibility, size_t num_threads) const {
+  ROS_ASSERT(visibility);
+  if (visibility_oracle_ == nullptr) {
+    ROS_ERROR_STREAM("Visibility oracle not initialized.");
+    return false;
+  }
+  return visibility_oracle_->computeVisibilityPolygons(query_points, visibility,
+                                                       num_threads);
 }
 
 bool VisibilityGraph::getWaypoints(const Solution& solution,
@@ -240,7 +475,10 @@ bool VisibilityGraph::solveWithOutsideStartAndGoal(
 
 double VisibilityGraph::computeEuclideanSegmentCost(const Point_2& from,
                                                     const Point_2& to) const {
-  return std::sqrt(CGAL::to_double(Segment_2(from, to).squared_length()));
+  // Evaluate in double instead of constructing an exact segment.
+  const double dx = CGAL::to_double(to.x()) - CGAL::to_double(from.x());
+  const double dy = CGAL::to_double(to.y()) - CGAL::to_double(from.y());
+  return std::sqrt(dx * dx + dy * dy);
 }
 
 }  // namespace visibility_graph
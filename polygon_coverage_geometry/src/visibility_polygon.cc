@@ -1,10 +1,11 @@
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#include <polygon_coverage_solvers/parallel_for.h>
 #include <ros/assert.h>
 #include <ros/console.h>
 
-#include <CGAL/Arr_naive_point_location.h>
-#include <CGAL/Arr_segment_traits_2.h>
-#include <CGAL/Triangular_expansion_visibility_2.h>
-
 #include "polygon_coverage_geometry/cgal_comm.h"
 #include "polygon_coverage_geometry/visibility_polygon.h"
 
@@ -13,79 +14,92 @@ namespace polygon_coverage_planning {
 bool computeVisibilityPolygon(const PolygonWithHoles& pwh,
                               const Point_2& query_point,
                               Polygon_2* visibility_polygon) {
-  ROS_ASSERT(visibility_polygon);
+  return VisibilityPolygonOracle(pwh).computeVisibilityPolygon(
+      query_point, visibility_polygon);
+}
 
-  // Preconditions.
-  ROS_ASSERT_MSG(pointInPolygon(pwh, query_point),
-                 "Query point outside of polygon.");
-  ROS_ASSERT_MSG(isStrictlySimple(pwh), "Polygon is not strictly simple.");
+bool computeVisibilityPolygons(const PolygonWithHoles& pwh,
+                               const std::vector<Point_2>& query_points,
+                               std::vector<Polygon_2>* visibility_polygons,
+                               size_t num_threads) {
+  return ParallelVisibilityPolygonOracle(pwh).computeVisibilityPolygons(
+      query_points, visibility_polygons, num_threads);
+}
+
+VisibilityPolygonOracle::VisibilityPolygonOracle(const PolygonWithHoles& pwh)
+    : pwh_(deepCopy(pwh)) {
+  ROS_ASSERT_MSG(isStrictlySimple(pwh_), "Polygon is not strictly simple.");
 
   // Create 2D arrangement.
-  typedef CGAL::Arr_segment_traits_2<K> VisibilityTraits;
-  typedef CGAL::Arrangement_2<VisibilityTraits> VisibilityArrangement;
-  VisibilityArrangement poly;
-  CGAL::insert(poly, pwh.outer_boundary().edges_begin(),
-               pwh.outer_boundary().edges_end());
+  CGAL::insert(arrangement_, pwh_.outer_boundary().edges_begin(),
+               pwh_.outer_boundary().edges_end());
   // Store main face.
-  ROS_ASSERT_MSG(poly.number_of_unbounded_faces() == 1,
+  ROS_ASSERT_MSG(arrangement_.number_of_unbounded_faces() == 1,
                  "Polygon has unbounded curves.");
-  ROS_ASSERT_MSG(poly.number_of_faces() == 2,
+  ROS_ASSERT_MSG(arrangement_.number_of_faces() == 2,
                  "More than one bounded face in polygon.");
 
-  VisibilityArrangement::Face_const_handle main_face = poly.faces_begin();
-  while (main_face->is_unbounded()) {
-    main_face++;
+  main_face_ = arrangement_.faces_begin();
+  while (main_face_->is_unbounded()) {
+    main_face_++;
   }
 
-  for (PolygonWithHoles::Hole_const_iterator hit = pwh.holes_begin();
-       hit != pwh.holes_end(); ++hit)
-    CGAL::insert(poly, hit->edges_begin(), hit->edges_end());
+  for (PolygonWithHoles::Hole_const_iterator hit = pwh_.holes_begin();
+       hit != pwh_.holes_end(); ++hit)
+    CGAL::insert(arrangement_, hit->edges_begin(), hit->edges_end());
 
-  // Create Triangular Expansion Visibility object.
-  typedef CGAL::Triangular_expansion_visibility_2<VisibilityArrangement,
-                                                  CGAL::Tag_true>
-      TEV;
-  TEV tev(poly);
+  // Create Triangular Expansion Visibility object and point locator once the
+  // arrangement is complete.
+  tev_.attach(arrangement_);
+  pl_.attach(arrangement_);
+}
+
+bool VisibilityPolygonOracle::computeVisibilityPolygon(
+    const Point_2& query_point, Polygon_2* visibility_polygon) const {
+  ROS_ASSERT(visibility_polygon);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  // Preconditions.
+  ROS_ASSERT_MSG(pointInPolygon(pwh_, query_point),
+                 "Query point outside of polygon.");
 
   // We need to determine the halfedge or face to which the query point
   // corresponds.
-  typedef CGAL::Arr_naive_point_location<VisibilityArrangement> NaivePL;
   typedef CGAL::Arr_point_location_result<VisibilityArrangement>::Type PLResult;
-  NaivePL pl(poly);
-  PLResult pl_result = pl.locate(query_point);
+  PLResult pl_result = pl_.locate(query_point);
 
-  VisibilityArrangement::Vertex_const_handle* v = nullptr;
-  VisibilityArrangement::Halfedge_const_handle* e = nullptr;
-  VisibilityArrangement::Face_const_handle* f = nullptr;
+  const VisibilityArrangement::Vertex_const_handle* v = nullptr;
+  const VisibilityArrangement::Halfedge_const_handle* e = nullptr;
+  const VisibilityArrangement::Face_const_handle* f = nullptr;
 
   typedef VisibilityArrangement::Face_handle VisibilityFaceHandle;
   VisibilityFaceHandle fh;
   VisibilityArrangement visibility_arr;
   if ((f = boost::get<VisibilityArrangement::Face_const_handle>(&pl_result))) {
     // Located in face.
-    fh = tev.compute_visibility(query_point, *f, visibility_arr);
+    fh = tev_.compute_visibility(query_point, *f, visibility_arr);
   } else if ((v = boost::get<VisibilityArrangement::Vertex_const_handle>(
                   &pl_result))) {
     // Located on vertex.
     // Search the incident halfedge that contains the polygon face.
-    VisibilityArrangement::Halfedge_const_handle he = poly.halfedges_begin();
-    while ((he->target()->point() != (*v)->point()) ||
-           (he->face() != main_face)) {
-      he++;
-      if (he == poly.halfedges_end()) {
+    VisibilityArrangement::Halfedge_around_vertex_const_circulator he =
+        (*v)->incident_halfedges();
+    while (he->face() != main_face_) {
+      if (++he == (*v)->incident_halfedges()) {
         ROS_ERROR_STREAM("Cannot find halfedge corresponding to vertex.");
         return false;
       }
     }
 
-    fh = tev.compute_visibility(query_point, he, visibility_arr);
+    fh = tev_.compute_visibility(query_point, he, visibility_arr);
   } else if ((e = boost::get<VisibilityArrangement::Halfedge_const_handle>(
                   &pl_result))) {
     // Located on halfedge.
     // Find halfedge that has polygon interior as face.
     VisibilityArrangement::Halfedge_const_handle he =
-        (*e)->face() == main_face ? (*e) : (*e)->twin();
-    fh = tev.compute_visibility(query_point, he, visibility_arr);
+        (*e)->face() == main_face_ ? (*e) : (*e)->twin();
+    fh = tev_.compute_visibility(query_point, he, visibility_arr);
   } else {
     ROS_ERROR_STREAM("Cannot locate query point on arrangement.");
     return false;
@@ -101,11 +115,12 @@ bool computeVisibilityPolygon(const PolygonWithHoles& pwh,
     return false;
   }
 
-  // Convert to polygon.
+  // Convert to polygon. Deep copies, because later queries on other threads
+  // evaluate the arrangement points.
   VisibilityArrangement::Ccb_halfedge_circulator curr = fh->outer_ccb();
   *visibility_polygon = Polygon_2();
   do {
-    visibility_polygon->push_back(curr->source()->point());
+    visibility_polygon->push_back(deepCopy(curr->source()->point()));
   } while (++curr != fh->outer_ccb());
 
   simplifyPolygon(visibility_polygon);
@@ -115,4 +130,83 @@ bool computeVisibilityPolygon(const PolygonWithHoles& pwh,
   return true;
 }
 
+ParallelVisibilityPolygonOracle::ParallelVisibilityPolygonOracle(
+    const PolygonWithHoles& pwh)
+    : pwh_(deepCopy(pwh)), oracle_(pwh_) {}
+
+bool ParallelVisibilityPolygonOracle::computeVisibilityPolygon(
+    const Point_2& query_point, Polygon_2* visibility_polygon) const {
+  return oracle_.computeVisibilityPolygon(query_point, visibility_polygon);
+}
+
+bool ParallelVisibilityPolygonOracle::computeVisibilityPolygons(
+    const std::vector<Point_2>& query_points,
+    std::vector<Polygon_2>* visibility_polygons, size_t num_threads) const {
+  ROS_ASSERT(visibility_polygons);
+  visibility_polygons->assign(query_points.size(), Polygon_2());
+
+  if (num_threads == 0) {
+    num_threads = std::thread::hardware_concurrency();
+  }
+  const size_t num_workers =
+      std::min(num_threads, query_points.size() / kMinQueriesPerWorker);
+  if (num_workers <= 1) {
+    for (size_t i = 0; i < query_points.size(); ++i) {
+      if (!oracle_.computeVisibilityPolygon(query_points[i],
+                                            &(*visibility_polygons)[i])) {
+        ROS_ERROR_STREAM("Cannot compute visibility polygon of query point "
+                         << query_points[i] << ".");
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // One contiguous block of queries and one worker oracle per thread. The
+  // workers get deep copies of their queries.
+  const std::vector<const VisibilityPolygonOracle*> workers =
+      getWorkers(num_workers);
+  std::vector<Point_2> queries;
+  queries.reserve(query_points.size());
+  for (const Point_2& q : query_points) queries.push_back(deepCopy(q));
+
+  const size_t block_size = (queries.size() + num_workers - 1) / num_workers;
+  std::atomic<bool> success(true);
+  parallelFor(num_workers, num_workers, [&](size_t block) {
+    const size_t begin = block * block_size;
+    const size_t end = std::min(begin + block_size, queries.size());
+    for (size_t i = begin; i < end && success; ++i) {
+      if (!workers[block]->computeVisibilityPolygon(
+              queries[i], &(*visibility_polygons)[i])) {
+        ROS_ERROR_STREAM("Cannot compute visibility polygon of query point "
+                         << queries[i] << ".");
+        success = false;
+      }
+    }
+  });
+
+  return success;
+}
+
+std::vector<const VisibilityPolygonOracle*>
+ParallelVisibilityPolygonOracle::getWorkers(size_t num_workers) const {
+  std::lock_guard<std::mutex> lock(workers_mutex_);
+
+  // Build the missing workers in parallel, each from its own deep copy.
+  const size_t num_built = workers_.size();
+  if (num_built < num_workers) {
+    std::vector<PolygonWithHoles> copies;
+    for (size_t i = num_built; i < num_workers; ++i)
+      copies.push_back(deepCopy(pwh_));
+    workers_.resize(num_workers);
+    parallelFor(copies.size(), copies.size(), [&](size_t i) {
+      workers_[num_built + i].reset(new VisibilityPolygonOracle(copies[i]));
+    });
+  }
+
+  std::vector<const VisibilityPolygonOracle*> workers(num_workers);
+  for (size_t i = 0; i < num_workers; ++i) workers[i] = workers_[i].get();
+  return workers;
+}
+
 }  // namespace polygon_coverage_planning
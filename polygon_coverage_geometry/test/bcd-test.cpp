@@ -4,6 +4,7 @@
 #include "polygon_coverage_geometry/bcd.h"
 #include "polygon_coverage_geometry/cgal_comm.h"
 #include "polygon_coverage_geometry/test_comm.h"
+#include "polygon_coverage_geometry/weakly_monotone.h"
 
 using namespace polygon_coverage_planning;
 
@@ -63,6 +64,110 @@ TEST(BctTest, computeBCD) {
   EXPECT_EQ(area, expected_area);
 }
 
+TEST(BctTest, ManyHoles) {
+  // A row of square holes. Every hole splits a cell and merges the two cells
+  // again.
+  const size_t kNumHoles = 20;
+  Polygon_2 outer;
+  outer.push_back(Point_2(0.0, 0.0));
+  outer.push_back(Point_2(3.0 * kNumHoles + 1.0, 0.0));
+  outer.push_back(Point_2(3.0 * kNumHoles + 1.0, 3.0));
+  outer.push_back(Point_2(0.0, 3.0));
+  PolygonWithHoles pwh(outer);
+  FT expected_area = outer.area();
+  for (size_t i = 0; i < kNumHoles; ++i) {
+    Polygon_2 hole;
+    hole.push_back(Point_2(3.0 * i + 1.0, 1.0));
+    hole.push_back(Point_2(3.0 * i + 1.0, 2.0));
+    hole.push_back(Point_2(3.0 * i + 3.0, 2.0));
+    hole.push_back(Point_2(3.0 * i + 3.0, 1.0));
+    expected_area += hole.area();
+    pwh.add_hole(hole);
+  }
+
+  std::vector<Polygon_2> bcd = computeBCD(pwh, Direction_2(1, 0));
+  EXPECT_EQ(bcd.size(), 3 * kNumHoles + 1);
+  FT area = 0.0;
+  for (const Polygon_2& p : bcd) {
+    EXPECT_EQ(p.size(), 4) << p;
+    area += p.area();
+  }
+  EXPECT_EQ(area, expected_area);
+}
+
+TEST(BctTest, SweepDirection) {
+  // Rotating the polygon and the direction by 90 degrees is exact. It must
+  // rotate the cells.
+  PolygonWithHoles pwh(createUltimateBCDTest<Polygon_2, PolygonWithHoles>());
+  const CGAL::Aff_transformation_2<K> rotation(CGAL::ROTATION,
+                                               Direction_2(0, 1), 1, 1e9);
+  PolygonWithHoles rotated_pwh(
+      CGAL::transform(rotation, pwh.outer_boundary()));
+  for (PolygonWithHoles::Hole_const_iterator hit = pwh.holes_begin();
+       hit != pwh.holes_end(); ++hit) {
+    rotated_pwh.add_hole(CGAL::transform(rotation, *hit));
+  }
+  std::vector<Polygon_2> bcd = computeBCD(pwh, Direction_2(1, 0));
+  std::vector<Polygon_2> rotated_bcd =
+      computeBCD(rotated_pwh, Direction_2(0, 1));
+  ASSERT_EQ(bcd.size(), rotated_bcd.size());
+  for (size_t i = 0; i < bcd.size(); ++i) {
+    EXPECT_EQ(CGAL::transform(rotation, bcd[i]), rotated_bcd[i]);
+  }
+
+  // Diagonal sweep. The cells are monotone perpendicular to the sweep.
+  PolygonWithHoles rectangle_in_rectangle(
+      createRectangleInRectangle<Polygon_2, PolygonWithHoles>());
+  FT expected_area = rectangle_in_rectangle.outer_boundary().area();
+  for (PolygonWithHoles::Hole_const_iterator hit =
+           rectangle_in_rectangle.holes_begin();
+       hit != rectangle_in_rectangle.holes_end(); ++hit) {
+    expected_area -= CGAL::abs(hit->area());
+  }
+  const Direction_2 dir(1, 1);
+  bcd = computeBCD(rectangle_in_rectangle, dir);
+  EXPECT_EQ(bcd.size(), 4);
+  FT area = 0.0;
+  const Line_2 x_axis(Point_2(CGAL::ORIGIN),
+                      dir.vector().perpendicular(CGAL::CLOCKWISE));
+  for (const Polygon_2& p : bcd) {
+    EXPECT_TRUE(isWeaklyMonotone(p, x_axis)) << p;
+    area += p.area();
+  }
+  EXPECT_EQ(area, expected_area);
+}
+
+TEST(BctTest, Adjacency) {
+  // The left cell and the right cell touch the lower and the upper cell.
+  PolygonWithHoles rectangle_in_rectangle(
+      createRectangleInRectangle<Polygon_2, PolygonWithHoles>());
+  std::vector<std::set<size_t>> adjacency;
+  std::vector<Polygon_2> bcd =
+      computeBCD(rectangle_in_rectangle, Direction_2(1, 0), &adjacency);
+  ASSERT_EQ(bcd.size(), 4);
+  ASSERT_EQ(adjacency.size(), bcd.size());
+  size_t num_adjacent = 0;
+  for (const std::set<size_t>& neighbors : adjacency) {
+    EXPECT_EQ(neighbors.size(), 2);
+    num_adjacent += neighbors.size();
+  }
+  EXPECT_EQ(num_adjacent, 2 * 4);
+
+  // The sweep finds the same neighbors as comparing all cell edges.
+  std::vector<std::set<size_t>> expected;
+  computeCellAdjacency(bcd, &expected);
+  EXPECT_EQ(adjacency, expected);
+
+  PolygonWithHoles pwh(createUltimateBCDTest<Polygon_2, PolygonWithHoles>());
+  bcd = computeBCD(pwh, Direction_2(1, 0), &adjacency);
+  computeCellAdjacency(bcd, &expected);
+  EXPECT_EQ(adjacency, expected);
+
+  bcd = computeBCD(pwh, Direction_2(1, 1), &adjacency);
+  computeCellAdjacency(bcd, &expected);
+  EXPECT_EQ(adjacency, expected);
+}
+
 int main(int argc, char** argv) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
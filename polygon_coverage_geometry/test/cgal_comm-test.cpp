@@ -67,6 +67,48 @@ TEST(CgalCommTest, projectPointOnHull) {
   EXPECT_EQ(p, projectPointOnHull(poly, p));
 }
 
+TEST(CgalCommTest, computeCellAdjacency) {
+  auto square = [](double x, double y) {
+    Polygon_2 poly;
+    poly.push_back(Point_2(x, y));
+    poly.push_back(Point_2(x + 1.0, y));
+    poly.push_back(Point_2(x + 1.0, y + 1.0));
+    poly.push_back(Point_2(x, y + 1.0));
+    return poly;
+  };
+  std::vector<Polygon_2> cells;
+  cells.push_back(square(0.0, 0.0));
+  // Shares half of the right edge.
+  cells.push_back(square(1.0, 0.5));
+  // Touches the first square only in a vertex.
+  cells.push_back(square(-1.0, -1.0));
+  // Far away.
+  cells.push_back(square(10.0, 10.0));
+
+  std::vector<std::set<size_t>> adjacency;
+  computeCellAdjacency(cells, &adjacency);
+  ASSERT_EQ(adjacency.size(), cells.size());
+  EXPECT_EQ(adjacency[0], std::set<size_t>({1}));
+  EXPECT_EQ(adjacency[1], std::set<size_t>({0}));
+  EXPECT_TRUE(adjacency[2].empty());
+  EXPECT_TRUE(adjacency[3].empty());
+}
+
+TEST(CgalCommTest, deepCopy) {
+  PolygonWithHoles rect_in_rect(
+      createRectangleInRectangle<Polygon_2, PolygonWithHoles>());
+  // A constructed point with an unevaluated exact representation.
+  const Point_2 p = CGAL::midpoint(Point_2(0.1, 0.2), Point_2(0.3, 0.7));
+
+  EXPECT_EQ(p, deepCopy(p));
+  EXPECT_EQ(rect_in_rect.outer_boundary(),
+            deepCopy(rect_in_rect.outer_boundary()));
+  const PolygonWithHoles copy = deepCopy(rect_in_rect);
+  EXPECT_EQ(rect_in_rect.outer_boundary(), copy.outer_boundary());
+  ASSERT_EQ(rect_in_rect.number_of_holes(), copy.number_of_holes());
+  EXPECT_EQ(*rect_in_rect.holes_begin(), *copy.holes_begin());
+}
+
 int main(int argc, char** argv) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
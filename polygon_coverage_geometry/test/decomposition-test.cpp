@@ -0,0 +1,110 @@
+#include <limits>
+#include <set>
+
+#include <gtest/gtest.h>
+
+#include "polygon_coverage_geometry/bcd.h"
+#include "polygon_coverage_geometry/cgal_comm.h"
+#include "polygon_coverage_geometry/decomposition.h"
+#include "polygon_coverage_geometry/test_comm.h"
+
+using namespace polygon_coverage_planning;
+
+TEST(DecompositionTest, findBestSweepDir) {
+  Polygon_2 rectangle;
+  rectangle.push_back(Point_2(0.0, 0.0));
+  rectangle.push_back(Point_2(3.0, 0.0));
+  rectangle.push_back(Point_2(3.0, 1.0));
+  rectangle.push_back(Point_2(0.0, 1.0));
+  Direction_2 best_dir;
+  EXPECT_DOUBLE_EQ(1.0, findBestSweepDir(rectangle, &best_dir));
+  EXPECT_EQ(CGAL::COLLINEAR,
+            CGAL::orientation(best_dir.vector(), Vector_2(1.0, 0.0)));
+
+  for (const Polygon_2& cell :
+       {rectangle, createDiamond<Polygon_2>(), createBCDCell<Polygon_2>()}) {
+    EXPECT_LE(computeMinAltitudeLowerBound(cell), findBestSweepDir(cell));
+  }
+}
+
+TEST(DecompositionTest, computeBestBCDFromPolygonWithHoles) {
+  for (const PolygonWithHoles& pwh :
+       {createRectangleInRectangle<Polygon_2, PolygonWithHoles>(),
+        createUltimateBCDTest<Polygon_2, PolygonWithHoles>(),
+        createSophisticatedPolygon<Polygon_2, PolygonWithHoles>()}) {
+    std::vector<Polygon_2> serial;
+    ASSERT_TRUE(computeBestBCDFromPolygonWithHoles(pwh, &serial, 1));
+    FT area = 0.0;
+    for (const Polygon_2& cell : serial) area += computeArea(cell);
+    EXPECT_EQ(computeArea(pwh), area);
+
+    // The best direction does not depend on the number of threads.
+    for (size_t num_threads : {2, 4, 0}) {
+      std::vector<Polygon_2> parallel;
+      ASSERT_TRUE(
+          computeBestBCDFromPolygonWithHoles(pwh, &parallel, num_threads));
+      EXPECT_EQ(serial, parallel) << num_threads;
+    }
+
+    // The adjacency of the best decomposition.
+    std::vector<Polygon_2> bcd;
+    std::vector<std::set<size_t>> adjacency, expected_adjacency;
+    ASSERT_TRUE(computeBestBCDFromPolygonWithHoles(pwh, &bcd, 0, &adjacency));
+    EXPECT_EQ(serial, bcd);
+    computeCellAdjacency(bcd, &expected_adjacency);
+    EXPECT_EQ(expected_adjacency, adjacency);
+  }
+}
+
+TEST(DecompositionTest, computeBestTCDFromPolygonWithHoles) {
+  for (const PolygonWithHoles& pwh :
+       {createRectangleInRectangle<Polygon_2, PolygonWithHoles>(),
+        createUltimateBCDTest<Polygon_2, PolygonWithHoles>(),
+        createSophisticatedPolygon<Polygon_2, PolygonWithHoles>()}) {
+    std::vector<Polygon_2> serial;
+    ASSERT_TRUE(computeBestTCDFromPolygonWithHoles(pwh, &serial, 1));
+    FT area = 0.0;
+    for (const Polygon_2& cell : serial) area += computeArea(cell);
+    EXPECT_EQ(computeArea(pwh), area);
+
+    // The best direction does not depend on the number of threads.
+    for (size_t num_threads : {2, 4, 0}) {
+      std::vector<Polygon_2> parallel;
+      ASSERT_TRUE(
+          computeBestTCDFromPolygonWithHoles(pwh, &parallel, num_threads));
+      EXPECT_EQ(serial, parallel) << num_threads;
+    }
+  }
+}
+
+TEST(DecompositionTest, PrunedMatchesExhaustive) {
+  for (const PolygonWithHoles& pwh :
+       {createRectangleInRectangle<Polygon_2, PolygonWithHoles>(),
+        createUltimateBCDTest<Polygon_2, PolygonWithHoles>(),
+        createSophisticatedPolygon<Polygon_2, PolygonWithHoles>()}) {
+    // Score every direction. Ties go to the first direction.
+    std::vector<Polygon_2> expected;
+    double best_sum = std::numeric_limits<double>::max();
+    for (const Direction_2& dir : findPerpEdgeDirections(pwh)) {
+      const std::vector<Polygon_2> bcd = computeBCD(pwh, dir);
+      double sum = 0.0;
+      for (const Polygon_2& cell : bcd) sum += findBestSweepDir(cell);
+      EXPECT_LE(computeDecompositionLowerBound(pwh, dir), sum);
+      if (sum < best_sum) {
+        best_sum = sum;
+        expected = bcd;
+      }
+    }
+
+    for (size_t num_threads : {1, 4}) {
+      std::vector<Polygon_2> bcd;
+      ASSERT_TRUE(computeBestBCDFromPolygonWithHoles(pwh, &bcd, num_threads));
+      EXPECT_EQ(expected, bcd) << num_threads;
+    }
+  }
+}
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
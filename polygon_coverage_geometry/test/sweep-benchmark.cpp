@@ -0,0 +1,91 @@
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+#include <CGAL/Cartesian_converter.h>
+
+#include "polygon_coverage_geometry/sweep.h"
+#include "polygon_coverage_geometry/test_comm.h"
+#include "polygon_coverage_geometry/weakly_monotone.h"
+
+using namespace polygon_coverage_planning;
+
+// Compares the sweep segment throughput of the exact kernel K and
+// InexactKernel, and the time to compute all sweeps with either kernel.
+
+const double kOffset = 0.01;
+const double kMaxSweepDistance = 0.1;
+const size_t kNumRepetitions = 100;
+
+typedef std::chrono::high_resolution_clock Clock;
+
+double computeMilliseconds(const Clock::time_point& start,
+                           const Clock::time_point& end) {
+  return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+int main() {
+  const CGAL::Cartesian_converter<K, InexactKernel> to_inexact;
+  for (const Polygon_2& poly :
+       {createDiamond<Polygon_2>(), createBCDCell<Polygon_2>()}) {
+    CGAL::Polygon_2<InexactKernel> inexact_poly;
+    for (VertexConstIterator it = poly.vertices_begin();
+         it != poly.vertices_end(); ++it) {
+      inexact_poly.push_back(to_inexact(*it));
+    }
+    const std::vector<Direction_2> dirs = getAllSweepableEdgeDirections(poly);
+
+    // Sweep segments only.
+    size_t num_segments = 0, num_inexact_segments = 0;
+    Clock::time_point t0 = Clock::now();
+    for (size_t i = 0; i < kNumRepetitions; ++i) {
+      for (const Direction_2& dir : dirs) {
+        std::vector<Segment_2> segments;
+        if (!computeSweepSegments(poly, kOffset, dir, &segments)) {
+          std::cerr << "Cannot compute exact sweep segments." << std::endl;
+          return 1;
+        }
+        num_segments += segments.size();
+      }
+    }
+    Clock::time_point t1 = Clock::now();
+    for (size_t i = 0; i < kNumRepetitions; ++i) {
+      for (const Direction_2& dir : dirs) {
+        std::vector<CGAL::Segment_2<InexactKernel>> segments;
+        if (!computeSweepSegments(inexact_poly, kOffset, to_inexact(dir),
+                                  &segments)) {
+          std::cerr << "Cannot compute inexact sweep segments." << std::endl;
+          return 1;
+        }
+        num_inexact_segments += segments.size();
+      }
+    }
+    Clock::time_point t2 = Clock::now();
+
+    // All sweeps, including the conversion to K and the visibility queries.
+    std::vector<std::vector<Point_2>> sweeps;
+    for (bool use_inexact_kernel : {false, true}) {
+      const Clock::time_point start = Clock::now();
+      if (!computeAllSweeps(poly, kMaxSweepDistance, &sweeps,
+                            use_inexact_kernel)) {
+        std::cerr << "Cannot compute all sweeps." << std::endl;
+        return 1;
+      }
+      std::cout << (use_inexact_kernel ? "Inexact" : "Exact")
+                << " kernel computed " << sweeps.size() << " sweeps in "
+                << computeMilliseconds(start, Clock::now()) << " ms."
+                << std::endl;
+    }
+
+    const double exact_ms = computeMilliseconds(t0, t1);
+    const double inexact_ms = computeMilliseconds(t1, t2);
+    std::cout << poly.size() << " vertices, " << dirs.size()
+              << " directions. Exact kernel: " << num_segments
+              << " segments in " << exact_ms << " ms ("
+              << num_segments / exact_ms << " per ms), inexact kernel: "
+              << num_inexact_segments << " segments in " << inexact_ms
+              << " ms (" << num_inexact_segments / inexact_ms << " per ms)."
+              << std::endl;
+  }
+  return 0;
+}
@@ -1,9 +1,13 @@
+#include <cmath>
+
+#include <CGAL/Cartesian_converter.h>
 #include <CGAL/is_y_monotone_2.h>
 #include <gtest/gtest.h>
 
 #include "polygon_coverage_geometry/cgal_comm.h"
 #include "polygon_coverage_geometry/sweep.h"
 #include "polygon_coverage_geometry/test_comm.h"
+#include "polygon_coverage_geometry/weakly_monotone.h"
 
 using namespace polygon_coverage_planning;
 
@@ -20,6 +24,168 @@ TEST(SweepTest, computeAllSweeps) {
   }
 }
 
+TEST(SweepTest, SharedSweepSegments) {
+  const double kMaxSweepDistance = 0.1;
+
+  Polygon_2 diamond(createDiamond<Polygon_2>());
+  std::vector<std::vector<Point_2>> cluster_sweeps;
+  EXPECT_TRUE(computeAllSweeps(diamond, kMaxSweepDistance, &cluster_sweeps));
+
+  // Same sweeps as computing every direction and orientation separately.
+  visibility_graph::VisibilityGraph vis_graph(diamond);
+  std::vector<Direction_2> dirs = getAllSweepableEdgeDirections(diamond);
+  ASSERT_EQ(4 * dirs.size(), cluster_sweeps.size());
+  for (size_t i = 0; i < dirs.size(); ++i) {
+    std::vector<Point_2> ccw, cw;
+    EXPECT_TRUE(computeSweep(diamond, vis_graph, kMaxSweepDistance, dirs[i],
+                             true, &ccw));
+    EXPECT_TRUE(computeSweep(diamond, vis_graph, kMaxSweepDistance, dirs[i],
+                             false, &cw));
+    EXPECT_EQ(ccw, cluster_sweeps[4 * i]);
+    EXPECT_EQ(cw, cluster_sweeps[4 * i + 2]);
+    std::reverse(ccw.begin(), ccw.end());
+    std::reverse(cw.begin(), cw.end());
+    EXPECT_EQ(ccw, cluster_sweeps[4 * i + 1]);
+    EXPECT_EQ(cw, cluster_sweeps[4 * i + 3]);
+  }
+}
+
+TEST(SweepTest, SweepSegmentFinder) {
+  for (const Polygon_2& poly :
+       {createDiamond<Polygon_2>(), createBCDCell<Polygon_2>()}) {
+    for (const Direction_2& dir : getAllSweepableEdgeDirections(poly)) {
+      SweepSegmentFinder<K> finder(poly, dir);
+      std::vector<Point_2> sorted_pts =
+          sortVerticesToLine(poly, Line_2(Point_2(CGAL::ORIGIN), dir));
+
+      // Sweep lines through all vertices and in between, up and down again.
+      std::vector<Line_2> lines;
+      for (size_t i = 0; i < sorted_pts.size(); ++i) {
+        lines.emplace_back(sorted_pts[i], dir);
+        if (i + 1 < sorted_pts.size()) {
+          lines.emplace_back(CGAL::midpoint(sorted_pts[i], sorted_pts[i + 1]),
+                             dir);
+        }
+      }
+      const std::vector<Line_2> lines_up = lines;
+      lines.insert(lines.end(), lines_up.rbegin(), lines_up.rend());
+      // Outside the polygon.
+      Vector_2 offset = sorted_pts.back() - sorted_pts.front();
+      lines.emplace_back(sorted_pts.back() + offset, dir);
+      lines.emplace_back(sorted_pts.front() - offset, dir);
+
+      for (const Line_2& l : lines) {
+        Segment_2 expected, segment;
+        const bool has_expected = findSweepSegment(poly, l, &expected);
+        EXPECT_EQ(has_expected, finder.findSweepSegment(l, &segment)) << l;
+        if (has_expected) EXPECT_EQ(expected, segment) << l;
+      }
+    }
+  }
+}
+
+TEST(SweepTest, InexactKernel) {
+  const double kOffset = 0.01;
+  const double kTolerance = 1.0e-9;
+
+  const CGAL::Cartesian_converter<K, InexactKernel> to_inexact;
+  for (const Polygon_2& poly :
+       {createDiamond<Polygon_2>(), createBCDCell<Polygon_2>()}) {
+    CGAL::Polygon_2<InexactKernel> inexact_poly;
+    for (VertexConstIterator it = poly.vertices_begin();
+         it != poly.vertices_end(); ++it) {
+      inexact_poly.push_back(to_inexact(*it));
+    }
+
+    for (const Direction_2& dir : getAllSweepableEdgeDirections(poly)) {
+      std::vector<Segment_2> segments;
+      ASSERT_TRUE(computeSweepSegments(poly, kOffset, dir, &segments));
+      std::vector<CGAL::Segment_2<InexactKernel>> inexact_segments;
+      ASSERT_TRUE(computeSweepSegments(inexact_poly, kOffset, to_inexact(dir),
+                                       &inexact_segments));
+
+      ASSERT_EQ(segments.size(), inexact_segments.size());
+      for (size_t i = 0; i < segments.size(); ++i) {
+        const CGAL::Segment_2<InexactKernel> s = to_inexact(segments[i]);
+        EXPECT_NEAR(0.0, CGAL::squared_distance(s.source(),
+                                                inexact_segments[i].source()),
+                    kTolerance);
+        EXPECT_NEAR(0.0, CGAL::squared_distance(s.target(),
+                                                inexact_segments[i].target()),
+                    kTolerance);
+      }
+    }
+  }
+}
+
+TEST(SweepTest, InexactSweeps) {
+  const double kMaxSweepDistance = 0.1;
+  const double kTolerance = 1.0e-6;
+
+  for (const Polygon_2& poly :
+       {createDiamond<Polygon_2>(), createBCDCell<Polygon_2>()}) {
+    std::vector<std::vector<Point_2>> exact_sweeps, inexact_sweeps;
+    ASSERT_TRUE(computeAllSweeps(poly, kMaxSweepDistance, &exact_sweeps));
+    ASSERT_TRUE(
+        computeAllSweeps(poly, kMaxSweepDistance, &inexact_sweeps, true));
+
+    // Same sweeps up to rounding, all waypoints in the polygon.
+    ASSERT_EQ(exact_sweeps.size(), inexact_sweeps.size());
+    for (size_t i = 0; i < exact_sweeps.size(); ++i) {
+      ASSERT_GE(inexact_sweeps[i].size(), 2);
+      EXPECT_NEAR(0.0,
+                  CGAL::to_double(CGAL::squared_distance(
+                      exact_sweeps[i].front(), inexact_sweeps[i].front())),
+                  kTolerance);
+      EXPECT_NEAR(0.0,
+                  CGAL::to_double(CGAL::squared_distance(
+                      exact_sweeps[i].back(), inexact_sweeps[i].back())),
+                  kTolerance);
+      double exact_length = 0.0, inexact_length = 0.0;
+      for (size_t j = 1; j < exact_sweeps[i].size(); ++j) {
+        exact_length += std::sqrt(CGAL::to_double(CGAL::squared_distance(
+            exact_sweeps[i][j - 1], exact_sweeps[i][j])));
+      }
+      for (size_t j = 1; j < inexact_sweeps[i].size(); ++j) {
+        inexact_length += std::sqrt(CGAL::to_double(CGAL::squared_distance(
+            inexact_sweeps[i][j - 1], inexact_sweeps[i][j])));
+      }
+      EXPECT_NEAR(exact_length, inexact_length, kTolerance);
+      for (const Point_2& p : inexact_sweeps[i]) {
+        EXPECT_TRUE(pointInPolygon(poly, p)) << p;
+      }
+    }
+  }
+}
+
+TEST(SweepTest, InexactPlateau) {
+  typedef InexactKernel::Point_2 InexactPoint;
+  // A rectangle rotated by 30 degrees. In floating point, its bottom and top
+  // edges are not exactly parallel to the sweep direction.
+  const double c = std::cos(M_PI / 6.0);
+  const double s = std::sin(M_PI / 6.0);
+  auto rotate = [c, s](double x, double y) {
+    return InexactPoint(c * x - s * y, s * x + c * y);
+  };
+  CGAL::Polygon_2<InexactKernel> rectangle;
+  rectangle.push_back(rotate(0.0, 0.0));
+  rectangle.push_back(rotate(3.0, 0.0));
+  rectangle.push_back(rotate(3.0, 1.0));
+  rectangle.push_back(rotate(0.0, 1.0));
+  const CGAL::Direction_2<InexactKernel> dir(rectangle.vertex(1) -
+                                             rectangle.vertex(0));
+
+  // Sweeps through the bottom and the top edge cover the whole edge.
+  SweepSegmentFinder<InexactKernel> finder(rectangle, dir);
+  for (size_t i : {0, 3}) {
+    CGAL::Segment_2<InexactKernel> segment;
+    ASSERT_TRUE(finder.findSweepSegment(
+        InexactKernel::Line_2(rectangle.vertex(i), dir), &segment))
+        << i;
+    EXPECT_NEAR(3.0, std::sqrt(segment.squared_length()), 1.0e-9) << i;
+  }
+}
+
 int main(int argc, char** argv) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -0,0 +1,136 @@
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include "polygon_coverage_geometry/cgal_comm.h"
+#include "polygon_coverage_geometry/test_comm.h"
+#include "polygon_coverage_geometry/visibility_graph.h"
+#include "polygon_coverage_geometry/visibility_polygon.h"
+
+using namespace polygon_coverage_planning;
+
+TEST(VisibilityGraphTest, ShortestPath) {
+  PolygonWithHoles pwh(
+      createRectangleInRectangle<Polygon_2, PolygonWithHoles>());
+
+  Point_2 start(-1.0, 3.0);
+  EXPECT_FALSE(pointInPolygon(pwh, start));
+  Point_2 goal(3.0, -1.0);
+  EXPECT_FALSE(pointInPolygon(pwh, goal));
+
+  visibility_graph::VisibilityGraph graph(pwh);
+  std::vector<Point_2> path;
+  EXPECT_TRUE(graph.solve(start, goal, &path));
+
+  std::vector<Point_2> expected_path = {Point_2(0, 2), Point_2(0.5, 1.25),
+                                        Point_2(2, 0)};
+  EXPECT_EQ(expected_path.size(), path.size());
+  for (size_t i = 0; i < path.size(); i++) {
+    EXPECT_EQ(expected_path[i], path[i]) << i;
+  }
+}
+
+double computePathLength(const std::vector<Point_2>& path) {
+  double length = 0.0;
+  for (size_t i = 1; i < path.size(); ++i) {
+    length += std::sqrt(
+        CGAL::to_double(Segment_2(path[i - 1], path[i]).squared_length()));
+  }
+  return length;
+}
+
+TEST(VisibilityGraphTest, QueryNode) {
+  PolygonWithHoles pwh(
+      createRectangleInRectangle<Polygon_2, PolygonWithHoles>());
+  visibility_graph::VisibilityGraph graph(pwh);
+  const size_t num_nodes = graph.size();
+  const size_t num_edges = graph.getNumberOfEdges();
+
+  const std::vector<Point_2> points = {Point_2(0.0, 2.0), Point_2(2.0, 0.0),
+                                       Point_2(0.75, 1.9), Point_2(0.75, 1.1),
+                                       Point_2(0.1, 0.1)};
+  std::vector<visibility_graph::QueryNode> query_nodes(points.size());
+  for (size_t i = 0; i < points.size(); ++i) {
+    Polygon_2 visibility;
+    ASSERT_TRUE(computeVisibilityPolygon(pwh, points[i], &visibility));
+    ASSERT_TRUE(graph.createQueryNode(points[i], visibility, &query_nodes[i]));
+  }
+
+  // The shortest path lengths between all points, computed by hand.
+  const std::vector<std::vector<double>> expected_lengths = {
+      {0.0, 2.853950237843, 0.756637297521, 1.192935413608, 1.902629759044},
+      {2.853950237843, 0.0, 2.307112031817, 1.665082580535, 1.902629759044},
+      {0.756637297521, 2.307112031817, 0.0, 1.083095189485, 1.989340279377},
+      {1.192935413608, 1.665082580535, 1.083095189485, 0.0, 1.192686044188},
+      {1.902629759044, 1.902629759044, 1.989340279377, 1.192686044188, 0.0}};
+
+  // Reuse the query nodes for all pairs. The graph is not modified.
+  for (size_t i = 0; i < points.size(); ++i) {
+    for (size_t j = 0; j < points.size(); ++j) {
+      std::vector<Point_2> path;
+      EXPECT_TRUE(graph.solve(query_nodes[i], query_nodes[j], &path));
+      EXPECT_NEAR(expected_lengths[i][j], computePathLength(path), 1e-9)
+          << i << " " << j;
+      ASSERT_LE(2, path.size());
+      EXPECT_EQ(points[i], path.front());
+      EXPECT_EQ(points[j], path.back());
+    }
+  }
+  EXPECT_EQ(num_nodes, graph.size());
+  EXPECT_EQ(num_edges, graph.getNumberOfEdges());
+
+  // Unique shortest paths past the hole vertices.
+  std::vector<Point_2> path;
+  EXPECT_TRUE(graph.solve(query_nodes[0], query_nodes[1], &path));
+  EXPECT_EQ(std::vector<Point_2>(
+                {Point_2(0.0, 2.0), Point_2(0.5, 1.25), Point_2(2.0, 0.0)}),
+            path);
+  EXPECT_TRUE(graph.solve(query_nodes[1], query_nodes[2], &path));
+  EXPECT_EQ(std::vector<Point_2>(
+                {Point_2(2.0, 0.0), Point_2(1.0, 1.75), Point_2(0.75, 1.9)}),
+            path);
+  EXPECT_TRUE(graph.solve(query_nodes[4], query_nodes[2], &path));
+  EXPECT_EQ(std::vector<Point_2>(
+                {Point_2(0.1, 0.1), Point_2(0.5, 1.75), Point_2(0.75, 1.9)}),
+            path);
+
+  // Around the hole. Both sides are equally short.
+  EXPECT_TRUE(graph.solve(query_nodes[2], query_nodes[3], &path));
+  EXPECT_EQ(4, path.size());
+
+  // Query outside the polygon.
+  visibility_graph::QueryNode outside;
+  EXPECT_FALSE(graph.createQueryNode(Point_2(3.0, 3.0), Polygon_2(), &outside));
+}
+
+TEST(VisibilityGraphTest, AllPairs) {
+  PolygonWithHoles pwh(
+      createRectangleInRectangle<Polygon_2, PolygonWithHoles>());
+  visibility_graph::VisibilityGraph graph(pwh);
+  visibility_graph::VisibilityGraph graph_all_pairs(pwh);
+  EXPECT_FALSE(graph_all_pairs.hasAllPairs());
+  EXPECT_TRUE(graph_all_pairs.precomputeAllPairs(2));
+  EXPECT_TRUE(graph_all_pairs.hasAllPairs());
+
+  const std::vector<Point_2> points = {Point_2(0.0, 2.0), Point_2(2.0, 0.0),
+                                       Point_2(0.75, 1.9), Point_2(0.75, 1.1),
+                                       Point_2(0.1, 0.1), Point_2(1.9, 1.9)};
+  for (const Point_2& start : points) {
+    for (const Point_2& goal : points) {
+      std::vector<Point_2> path, expected_path;
+      EXPECT_TRUE(graph.solve(start, goal, &expected_path));
+      EXPECT_TRUE(graph_all_pairs.solve(start, goal, &path));
+      EXPECT_NEAR(computePathLength(expected_path), computePathLength(path),
+                  1e-9)
+          << start << " " << goal;
+      ASSERT_LE(2, path.size());
+      EXPECT_EQ(start, path.front());
+      EXPECT_EQ(goal, path.back());
+    }
+  }
+}
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -1,3 +1,5 @@
+#include <thread>
+
 #include <CGAL/is_y_monotone_2.h>
 #include <gtest/gtest.h>
 
@@ -88,6 +90,128 @@ TEST(VisibilityPolygonTest, computeVisibilityPolygon) {
   EXPECT_EQ(Point_2(2, 0), *vit++);
 }
 
+TEST(VisibilityPolygonTest, VisibilityPolygonOracle) {
+  PolygonWithHoles rectangle_in_rectangle(
+      createRectangleInRectangle<Polygon_2, PolygonWithHoles>());
+  const VisibilityPolygonOracle oracle(rectangle_in_rectangle);
+
+  // Vertex, hole vertex, face, halfedge and hole halfedge queries.
+  const std::vector<Point_2> queries = {
+      Point_2(0.0, 0.0), Point_2(1.0, 1.25), Point_2(1.0, 0.5),
+      Point_2(1.0, 0.0), Point_2(0.75, 1.25)};
+  std::vector<Polygon_2> expected(queries.size());
+  for (size_t i = 0; i < queries.size(); ++i) {
+    EXPECT_TRUE(computeVisibilityPolygon(rectangle_in_rectangle, queries[i],
+                                         &expected[i]));
+  }
+
+  // Repeated queries on the same oracle.
+  for (size_t k = 0; k < 2; ++k) {
+    for (size_t i = 0; i < queries.size(); ++i) {
+      Polygon_2 visibility_polygon;
+      EXPECT_TRUE(
+          oracle.computeVisibilityPolygon(queries[i], &visibility_polygon));
+      EXPECT_EQ(expected[i], visibility_polygon) << queries[i];
+    }
+  }
+
+  // Concurrent queries.
+  std::vector<Polygon_2> results(4 * queries.size());
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < 4; ++t) {
+    threads.emplace_back([&oracle, &queries, &results, t]() {
+      for (size_t i = 0; i < queries.size(); ++i) {
+        oracle.computeVisibilityPolygon(queries[i],
+                                        &results[t * queries.size() + i]);
+      }
+    });
+  }
+  for (std::thread& thread : threads) thread.join();
+  for (size_t i = 0; i < results.size(); ++i) {
+    EXPECT_EQ(expected[i % queries.size()], results[i]) << i;
+  }
+}
+
+TEST(VisibilityPolygonTest, computeVisibilityPolygons) {
+  PolygonWithHoles rectangle_in_rectangle(
+      createRectangleInRectangle<Polygon_2, PolygonWithHoles>());
+
+  std::vector<Point_2> queries;
+  for (double x = 0.0; x <= 2.0; x += 0.25) {
+    for (double y = 0.0; y <= 1.0; y += 0.25) {
+      queries.emplace_back(x, y);
+    }
+  }
+  std::vector<Polygon_2> expected(queries.size());
+  for (size_t i = 0; i < queries.size(); ++i) {
+    EXPECT_TRUE(computeVisibilityPolygon(rectangle_in_rectangle, queries[i],
+                                         &expected[i]));
+  }
+
+  for (size_t num_threads : {1, 3, 0}) {
+    std::vector<Polygon_2> visibility_polygons;
+    EXPECT_TRUE(computeVisibilityPolygons(rectangle_in_rectangle, queries,
+                                          &visibility_polygons, num_threads));
+    EXPECT_EQ(expected, visibility_polygons) << num_threads;
+  }
+
+  std::vector<Polygon_2> visibility_polygons;
+  EXPECT_TRUE(computeVisibilityPolygons(rectangle_in_rectangle, {},
+                                        &visibility_polygons));
+  EXPECT_TRUE(visibility_polygons.empty());
+}
+
+TEST(VisibilityPolygonTest, ParallelVisibilityPolygonOracle) {
+  PolygonWithHoles rectangle_in_rectangle(
+      createRectangleInRectangle<Polygon_2, PolygonWithHoles>());
+  const ParallelVisibilityPolygonOracle oracle(rectangle_in_rectangle);
+
+  std::vector<Point_2> queries;
+  for (double x = 0.0; x <= 2.0; x += 0.25) {
+    for (double y = 0.0; y <= 1.0; y += 0.25) {
+      queries.emplace_back(x, y);
+    }
+  }
+  std::vector<Polygon_2> expected(queries.size());
+  for (size_t i = 0; i < queries.size(); ++i) {
+    EXPECT_TRUE(computeVisibilityPolygon(rectangle_in_rectangle, queries[i],
+                                         &expected[i]));
+  }
+
+  // Single queries, small batches and batches that reuse the worker oracles.
+  Polygon_2 visibility_polygon;
+  EXPECT_TRUE(oracle.computeVisibilityPolygon(queries[7], &visibility_polygon));
+  EXPECT_EQ(expected[7], visibility_polygon);
+  const std::vector<Point_2> small_batch(queries.begin(), queries.begin() + 3);
+  std::vector<Polygon_2> visibility_polygons;
+  EXPECT_TRUE(oracle.computeVisibilityPolygons(small_batch,
+                                               &visibility_polygons, 4));
+  EXPECT_EQ(std::vector<Polygon_2>(expected.begin(), expected.begin() + 3),
+            visibility_polygons);
+  for (size_t num_threads : {2, 4, 3, 0}) {
+    EXPECT_TRUE(oracle.computeVisibilityPolygons(queries, &visibility_polygons,
+                                                 num_threads));
+    EXPECT_EQ(expected, visibility_polygons) << num_threads;
+  }
+
+  // Concurrent batches on the same oracle. Every thread owns its queries.
+  std::vector<std::vector<Point_2>> thread_queries(3);
+  for (std::vector<Point_2>& q : thread_queries) {
+    for (const Point_2& p : queries) q.push_back(deepCopy(p));
+  }
+  std::vector<std::vector<Polygon_2>> results(thread_queries.size());
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < results.size(); ++t) {
+    threads.emplace_back([&oracle, &thread_queries, &results, t]() {
+      oracle.computeVisibilityPolygons(thread_queries[t], &results[t], 2);
+    });
+  }
+  for (std::thread& thread : threads) thread.join();
+  for (const std::vector<Polygon_2>& result : results) {
+    EXPECT_EQ(expected, result);
+  }
+}
+
 int main(int argc, char** argv) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -1,6 +1,7 @@
 #ifndef MAV_2D_COVERAGE_PLANNING_GRAPHS_GTSPP_PRODUCT_GRAPH_H_
 #define MAV_2D_COVERAGE_PLANNING_GRAPHS_GTSPP_PRODUCT_GRAPH_H_
 
+#include <chrono>
 #include <limits>
 #include <vector>
 
@@ -8,9 +9,13 @@
 #include "mav_2d_coverage_planning/graphs/sweep_plan_graph.h"
 #include "mav_coverage_graph_solvers/boolean_lattice.h"
 #include "mav_coverage_graph_solvers/graph_base.h"
+#include "mav_coverage_graph_solvers/gtsp_solver.h"
 
 namespace mav_coverage_planning {
 namespace gtspp_product_graph {
+// The default wall-clock budget of a product graph search [s].
+const double kDefaultMaxTime = 200.0;
+
 // Internal node property. Stores the product graph information, i.e., the
 // corresponding sweep plan graph ID and boolean lattice ID.
 struct NodeProperty {
@@ -45,11 +50,15 @@ class GtsppProductGraph : public GraphBase<NodeProperty, EdgeProperty> {
                     const boolean_lattice::BooleanLattice* boolean_lattice)
       : GraphBase(),
         sweep_plan_graph_(sweep_plan_graph),
-        boolean_lattice_(boolean_lattice) {}
+        boolean_lattice_(boolean_lattice),
+        use_astar_(false),
+        budget_(kDefaultMaxTime),
+        deadline_(std::chrono::steady_clock::time_point::max()) {}
 
   // Compute the product graph given sweep plan graph and boolean lattice.
   virtual bool create() override;
-  // Allocate nodes but do not create edges.
+  // Do not allocate any nodes or edges. solveOnline() generates them
+  // implicitly.
   bool createOnline();
   virtual void clear() override;
   // Add a start node.
@@ -69,13 +78,29 @@ class GtsppProductGraph : public GraphBase<NodeProperty, EdgeProperty> {
       const boolean_lattice::BooleanLattice* boolean_lattice) {
     boolean_lattice_ = boolean_lattice;
   }
+  // Use A* search with an admissible cluster heuristic instead of Dijkstra.
+  inline void setUseAStar(bool use_astar) { use_astar_ = use_astar; }
+  inline bool getUseAStar() const { return use_astar_; }
+  // Limit the wall-clock time to create and search the graph. When the budget
+  // is exhausted, the search returns the path to the expanded node that
+  // covers the most clusters, greedily completed to the goal.
+  inline void setBudget(const GtspBudget& budget) { budget_ = budget; }
+  inline const GtspBudget& getBudget() const { return budget_; }
 
-  // Solve the graph with Dijsktra search.
+  // Solve the graph with Dijsktra or A* search. Falls back to the implicit
+  // search if adding start and goal exhausts the budget.
+  // incumbent: optional, receives the sweep plan graph solution including
+  // start and goal and its cost in milli units.
   bool solve(const Point_2& start, const Point_2& goal,
-             std::vector<Point_2>* waypoints) const;
-  // Build the graph while performing Dijkstra search.
+             std::vector<Point_2>* waypoints,
+             GtspIncumbent* incumbent = nullptr) const;
+  // Generate the graph implicitly while performing Dijkstra or A* search.
+  // num_expanded: optional number of expanded product graph nodes.
+  // incumbent: same as in solve().
   bool solveOnline(const Point_2& start, const Point_2& goal,
-                   std::vector<Point_2>* waypoints) const;
+                   std::vector<Point_2>* waypoints,
+                   size_t* num_expanded = nullptr,
+                   GtspIncumbent* incumbent = nullptr) const;
   // Given a solution, get the concatenated sweep plan graph waypoints.
   bool getWaypoints(const Solution& solution,
                     std::vector<Point_2>* waypoints) const;
@@ -84,6 +109,27 @@ class GtsppProductGraph : public GraphBase<NodeProperty, EdgeProperty> {
   // Nodes are connected based on E1 or E2 criterion.
   bool addEdges();
 
+  // The heuristic of all product graph nodes. Only the graph goal is
+  // supported.
+  virtual bool calculateHeuristic(size_t goal,
+                                  Heuristic* heuristic) const override;
+  // Lower bounds on the cost to leave a sweep or a cluster.
+  // min_out: the cheapest outgoing sweep plan graph edge of every sweep.
+  // min_cluster: the cheapest min_out of every regular cluster.
+  bool computeHeuristicBounds(std::vector<double>* min_out,
+                              std::vector<double>* min_cluster) const;
+  // h(c, u) = min_out(u) + sum_{k not in c, k != cluster(u)} min_cluster(k)
+  // Every cluster k that still needs to be visited is left by one distinct
+  // sweep plan graph edge, as is u itself, unless u is the goal. Thus h is
+  // admissible. It is also consistent: E2 edges do not change h. E1 edges
+  // (c, u) -> (c, v) cost at least min_out(u) and
+  // h(c, v) = h(c, u) - min_out(u) + min_out(v) - min_cluster(cluster(v))
+  //         >= h(c, u) - min_out(u).
+  double computeHeuristic(size_t boolean_lattice_id,
+                          size_t sweep_plan_graph_id,
+                          const std::vector<double>& min_out,
+                          const std::vector<double>& min_cluster) const;
+
   // E1: Two vertices u, v are connected inside the same "combination set" c if
   // - they share the same boolean lattice node (c=c') AND
   // - they are connected in the original sweep plan graph ((u,v) \in E) AND
@@ -92,8 +138,7 @@ class GtsppProductGraph : public GraphBase<NodeProperty, EdgeProperty> {
   bool isE1(const EdgeId& edge_id) const;
   bool isE1(size_t from_boolean_lattice_id, size_t to_boolean_lattice_id,
             size_t from_sweep_plan_graph_id, size_t to_sweep_plan_graph_id,
-            const std::set<size_t>& cluster_set, size_t from_sweep_cluster,
-            size_t to_sweep_cluster) const;
+            size_t from_sweep_cluster, size_t to_sweep_cluster) const;
 
   // E2: Two vertices are connected between two "combination sets" c, c' if
   // - the covering node c is different from c' AND
@@ -105,23 +150,53 @@ class GtsppProductGraph : public GraphBase<NodeProperty, EdgeProperty> {
   bool isE2(const EdgeId& edge_id) const;
   bool isE2(size_t from_sweep_plan_graph_id, size_t to_sweep_plan_graph_id,
             size_t from_boolean_lattice_id, size_t to_boolean_lattice_id,
-            const std::set<size_t>& from_cluster_set,
-            const std::set<size_t>& to_cluster_set, size_t sweep_cluster) const;
+            size_t sweep_cluster) const;
 
-  const boolean_lattice::NodeProperty* getBooleanLatticeNodeProperty(
-      size_t node_id) const;
   const sweep_plan_graph::NodeProperty* getSweepPlanGraphNodeProperty(
       size_t node_id) const;
   bool getSweepPlanGraphEdgeCost(const EdgeId& edge_id, double* cost) const;
   bool getBooleanLatticeEdgeCost(const EdgeId& edge_id, double* cost) const;
 
-  // Create the graph while solving Dijkstra.
-  bool createDijkstra(Solution* solution);
+  // Dijkstra or A* search on the implicit product graph until the deadline.
+  // Returns the sweep plan graph solution.
+  bool solveImplicit(const std::chrono::steady_clock::time_point& deadline,
+                     Solution* sweep_plan_solution, size_t* num_expanded,
+                     GtspIncumbent* incumbent) const;
+  // Translate a product graph solution into sweep plan graph indices.
+  bool getSweepPlanSolution(const Solution& solution,
+                            Solution* sweep_plan_solution) const;
 
   // Corresponding sweep plan graph.
   const sweep_plan_graph::SweepPlanGraph* sweep_plan_graph_;
   // Corresponding boolean lattice.
   const boolean_lattice::BooleanLattice* boolean_lattice_;
+  // Use A* instead of Dijkstra search.
+  bool use_astar_;
+  // Time limit.
+  GtspBudget budget_;
+  // The deadline to add start and goal node.
+  std::chrono::steady_clock::time_point deadline_;
+};
+
+// The product graph search as GTSP solver. Every tour passes one node s of the
+// smallest cluster. For every s, the search finds the cheapest path from s
+// through all other clusters back to s on the implicit product of the cost
+// matrix and the boolean lattice of the remaining clusters. When the deadline
+// expires, the best tour so far is returned, see GtsppProductGraph::setBudget.
+// Supports at most BooleanLattice::kMaxNumClusters + 1 clusters.
+class GtsppProductGraphSolver : public GtspSolver {
+ public:
+  // use_astar: Search with A* instead of Dijkstra.
+  GtsppProductGraphSolver(bool use_astar = false) : use_astar_(use_astar) {}
+
+ protected:
+  bool solveTask(const std::vector<std::vector<int>>& m,
+                 const std::vector<std::vector<int>>& clusters,
+                 const Clock::time_point& deadline, std::vector<int>* solution,
+                 GtspIncumbent* incumbent) const override;
+
+ private:
+  bool use_astar_;
 };
 }  // namespace gtspp_product_graph
 }  // namespace mav_coverage_planning
@@ -2,6 +2,7 @@
 #define MAV_2D_COVERAGE_PLANNING_GRAPHS_SWEEP_PLAN_GRAPH_H_
 
 #include <mav_coverage_graph_solvers/graph_base.h>
+#include <mav_coverage_graph_solvers/gtsp_solver.h>
 #include <mav_coverage_planning_comm/cgal_definitions.h>
 
 #include "mav_2d_coverage_planning/cost_functions/path_cost_functions.h"
@@ -30,12 +31,8 @@ struct NodeProperty {
   size_t cluster;                  // The cluster these waypoints are covering.
   std::vector<Polygon> visibility_polygons;  // The visibility polygons at start
                                              // and goal of sweep.
-
-  // Checks whether this node property is non-optimal compared to any node
-  // in node_properties.
-  bool isNonOptimal(const visibility_graph::VisibilityGraph& visibility_graph,
-                    const std::vector<NodeProperty>& node_properties,
-                    const PathCostFunctionType& cost_function) const;
+  // Start and goal of sweep connected to the visibility graph.
+  std::vector<visibility_graph::QueryNode> visibility_queries;
 };
 
 // Internal edge property storage, i.e., shortest path.
@@ -48,6 +45,14 @@ struct EdgeProperty {
   double cost;                     // The shortest path length.
 };
 
+// Statistics of pruning non-optimal sweeps.
+struct PruningStatistics {
+  PruningStatistics() : num_sweeps(0), num_pruned(0), num_path_queries(0) {}
+  size_t num_sweeps;        // Number of sweeps before pruning.
+  size_t num_pruned;        // Number of pruned sweeps.
+  size_t num_path_queries;  // Number of shortest path queries.
+};
+
 // The adjacency graph contains all sweep plans (and waypoints) and its
 // interconnections (edges). It is a dense, asymmetric, bidirectional graph.
 class SweepPlanGraph : public GraphBase<NodeProperty, EdgeProperty> {
@@ -61,18 +66,34 @@ class SweepPlanGraph : public GraphBase<NodeProperty, EdgeProperty> {
         cost_function_(cost_function),
         polygon_clusters_(polygon_clusters),
         sweep_distance_(sweep_distance),
-        sweep_single_direction_(sweep_single_direction) {
+        sweep_single_direction_(sweep_single_direction),
+        defer_edges_(false) {
     is_created_ = create();  // Auto-create.
   }
-  SweepPlanGraph() : GraphBase() {}
+  SweepPlanGraph() : GraphBase(), defer_edges_(false) {}
 
   // Compute the sweep paths for each given cluster and create the adjacency
   // graph out of these.
   virtual bool create() override;
 
-  // Solve the GTSP using GK MA.
+  // Solve the GTSP using gtsp_solver. Uses GK MA without budget if no solver
+  // is given. Pass a budgeted solver to bound the solve time, e.g., a
+  // MemeticGtspSolver or a GtsppProductGraphSolver. These return their best
+  // tour so far when the budget is exhausted.
+  // incumbent: optional, receives the best tour so far in node ids of the
+  // graph with start and goal, e.g., to monitor the solve from another thread.
   bool solve(const Point_2& start, const Point_2& goal,
-             std::vector<Point_2>* waypoints) const;
+             std::vector<Point_2>* waypoints,
+             const GtspSolver* gtsp_solver = nullptr,
+             GtspIncumbent* incumbent = nullptr) const;
+
+  // Add start and goal node in their own clusters and freeze the graph. To be
+  // called on a temporary copy of the created graph.
+  bool addStartAndGoal(const Point_2& start, const Point_2& goal);
+  inline size_t getNumClusters() const { return polygon_clusters_.size(); }
+  inline const PruningStatistics& getPruningStatistics() const {
+    return pruning_statistics_;
+  }
 
   // Given a solution, get the concatenated 2D waypoints.
   bool getWaypoints(const Solution& solution,
@@ -88,9 +109,32 @@ class SweepPlanGraph : public GraphBase<NodeProperty, EdgeProperty> {
     std::vector<Point_2> waypoints({waypoint});
     return createNodeProperty(cluster, &waypoints, node);
   }
+  // Same as createNodeProperty for many sweeps. The start and goal visibility
+  // polygons of all sweeps are computed on num_threads threads (0: all
+  // hardware threads). Single sweeps and small batches are answered by the
+  // cached visibility oracle of the visibility graph.
+  bool createNodeProperties(size_t cluster,
+                            std::vector<std::vector<Point_2>>* sweeps,
+                            std::vector<NodeProperty>* nodes,
+                            size_t num_threads = 0) const;
 
  private:
   virtual bool addEdges() override;
+  // Compute, create and prune the sweep plans of a single cluster on
+  // num_threads threads. Only thread-safe if the kernel is thread-safe, see
+  // kIsKernelThreadSafe.
+  bool createClusterNodes(size_t cluster, size_t num_threads,
+                          std::vector<NodeProperty>* node_properties,
+                          PruningStatistics* statistics) const;
+  // Remove all sweeps of a cluster that are non-optimal compared to another
+  // sweep of the same cluster.
+  bool pruneNonOptimal(size_t num_threads,
+                       std::vector<NodeProperty>* node_properties,
+                       PruningStatistics* statistics) const;
+  // Compute all edges between the nodes in parallel and add them. Used
+  // instead of addEdges when creating the graph. Fails if any edge or cost
+  // cannot be computed. Runs on one thread if the kernel is not thread-safe.
+  bool addAllEdges();
   bool computeEdge(const EdgeId& edge_id, EdgeProperty* edge_property) const;
   // Calculate cost to go to node.
   // cost = from_sweep_cost + cost(from_end, to_start)
@@ -104,15 +148,8 @@ class SweepPlanGraph : public GraphBase<NodeProperty, EdgeProperty> {
   // - edge is not between start and goal.
   bool isConnected(const EdgeId& edge_id) const;
 
-  // Compute the start and goal visibility polygon of a sweep. Also resets the
-  // start and goal vertex in case they are not inside the polygon.
-  bool computeStartAndGoalVisibility(
-      const Polygon& polygon, std::vector<Point_2>* sweep,
-      std::vector<Polygon>* visibility_polygons) const;
-
-  // Projects vertex into polygon and computes its visibility polygon.
-  bool computeVisibility(const Polygon& polygon, Point_2* vertex,
-                         Polygon* visibility_polygon) const;
+  // Projects vertex into polygon if it is outside.
+  void projectIntoPolygon(const Polygon& polygon, Point_2* vertex) const;
 
   visibility_graph::VisibilityGraph
       visibility_graph_;                   // The visibility to compute edges.
@@ -120,6 +157,8 @@ class SweepPlanGraph : public GraphBase<NodeProperty, EdgeProperty> {
   std::vector<Polygon> polygon_clusters_;  // The polygon clusters.
   double sweep_distance_;                  // The max. sweep distance.
   bool sweep_single_direction_;
+  PruningStatistics pruning_statistics_;  // Of the last create().
+  bool defer_edges_;  // addEdges does not add edges during bulk creation.
 };
 
 }  // namespace sweep_plan_graph
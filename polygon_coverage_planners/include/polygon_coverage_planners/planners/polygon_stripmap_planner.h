@@ -21,6 +21,9 @@ class PolygonStripmapPlanner {
     bool offset_polygons;
     DecompositionType decomposition_type;
     bool sweep_single_direction;
+    // The GTSP solver. Uses GK MA without budget if not set. Must be
+    // reentrant if the planner is shared between threads.
+    std::shared_ptr<GtspSolver> gtsp_solver;
   };
 
   // Create a sweep plan for a 2D polygon with holes.
@@ -32,9 +35,13 @@ class PolygonStripmapPlanner {
   // Solve the resulting generalized traveling salesman problem.
   // start: the start point.
   // goal: the goal point.
-  // solution: the solution waypoints.
+  // solution: the solution waypoints. The best solution so far, if the
+  // solver budget is exhausted.
+  // incumbent: optional, receives the best tour so far in sweep plan graph
+  // node ids, e.g., to monitor the solve from another thread.
   bool solve(const Point_2& start, const Point_2& goal,
-             std::vector<Point_2>* solution) const;
+             std::vector<Point_2>* solution,
+             GtspIncumbent* incumbent = nullptr) const;
 
   inline bool isInitialized() const { return is_initialized_; }
 
@@ -42,9 +49,12 @@ class PolygonStripmapPlanner {
     return decomposition_;
   }
 
-  // Check which decomposition cells are adjacent. Return whether each cell has
-  // at least one neighbor.
+  // Check which decomposition cells are adjacent, i.e., share a boundary
+  // segment. Return whether each cell has at least one neighbor.
   bool updateDecompositionAdjacency();
+  // Same with the adjacency reported by the decomposition, one entry per cell.
+  bool updateDecompositionAdjacency(
+      const std::vector<std::set<size_t>>& adjacency);
 
   bool offsetDecomposition();
 
@@ -58,7 +68,8 @@ class PolygonStripmapPlanner {
   virtual bool setupSolver() { return true; };
   // Default: Heuristic GTSPP solver.
   virtual bool runSolver(const Point_2& start, const Point_2& goal,
-                         std::vector<Point_2>* solution) const;
+                         std::vector<Point_2>* solution,
+                         GtspIncumbent* incumbent) const;
 
   virtual bool sweepAroundObstacles(std::vector<Point_2>* solution) const;
 
@@ -10,8 +10,17 @@ namespace mav_coverage_planning {
 
 class PolygonStripmapPlannerExact : public PolygonStripmapPlanner {
  public:
-  PolygonStripmapPlannerExact(const Settings& settings)
-      : PolygonStripmapPlanner(settings) {}
+  // use_astar: Solve the product graph with A* instead of Dijkstra search.
+  PolygonStripmapPlannerExact(const Settings& settings, bool use_astar = false)
+      : PolygonStripmapPlanner(settings),
+        use_astar_(use_astar),
+        budget_(gtspp_product_graph::kDefaultMaxTime) {}
+
+  // Limit the wall-clock time of the product graph search.
+  inline void setBudget(const GtspBudget& budget) {
+    budget_ = budget;
+    gtspp_product_graph_.setBudget(budget);
+  }
 
  protected:
   virtual bool preprocess();
@@ -21,12 +30,15 @@ class PolygonStripmapPlannerExact : public PolygonStripmapPlanner {
 
  private:
   bool runSolver(const Point_2& start, const Point_2& goal,
-                 std::vector<Point_2>* solution) const override;
+                 std::vector<Point_2>* solution,
+                 GtspIncumbent* incumbent) const override;
   bool setupSolver() override;
 
   // A boolean lattice to represent all possible convex polygon visiting
   // combinations.
   boolean_lattice::BooleanLattice boolean_lattice_;
+  bool use_astar_;
+  GtspBudget budget_;
 };
 }  // namespace mav_coverage_planning
 
@@ -0,0 +1,28 @@
+#ifndef MAV_2D_COVERAGE_PLANNING_PLANNERS_POLYGON_STRIPMAP_PLANNER_EXACT_DP_H_
+#define MAV_2D_COVERAGE_PLANNING_PLANNERS_POLYGON_STRIPMAP_PLANNER_EXACT_DP_H_
+
+#include "mav_2d_coverage_planning/planners/polygon_stripmap_planner.h"
+
+namespace mav_coverage_planning {
+
+// Solves the GTSPP exactly with a dynamic program over (visited cluster set,
+// last sweep) directly on the sweep plan graph costs. No product graph is
+// built.
+class PolygonStripmapPlannerExactDp : public PolygonStripmapPlanner {
+ public:
+  // num_threads: Number of threads to evaluate the dynamic program. 0 uses all
+  // hardware threads.
+  PolygonStripmapPlannerExactDp(const Settings& settings,
+                                size_t num_threads = 0)
+      : PolygonStripmapPlanner(settings), num_threads_(num_threads) {}
+
+ private:
+  bool runSolver(const Point_2& start, const Point_2& goal,
+                 std::vector<Point_2>* solution,
+                 GtspIncumbent* incumbent) const override;
+
+  size_t num_threads_;
+};
+}  // namespace mav_coverage_planning
+
+#endif  // MAV_2D_COVERAGE_PLANNING_PLANNERS_POLYGON_STRIPMAP_PLANNER_EXACT_DP_H_
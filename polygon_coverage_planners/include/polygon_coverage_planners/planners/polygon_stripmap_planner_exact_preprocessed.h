@@ -8,12 +8,14 @@ namespace mav_coverage_planning {
 class PolygonStripmapPlannerExactPreprocessed
     : public PolygonStripmapPlannerExact {
  public:
-  PolygonStripmapPlannerExactPreprocessed(const Settings& settings)
-      : PolygonStripmapPlannerExact(settings) {}
+  PolygonStripmapPlannerExactPreprocessed(const Settings& settings,
+                                          bool use_astar = false)
+      : PolygonStripmapPlannerExact(settings, use_astar) {}
 
  private:
   bool runSolver(const Point_2& start, const Point_2& goal,
-                 std::vector<Point_2>* solution) const override;
+                 std::vector<Point_2>* solution,
+                 GtspIncumbent* incumbent) const override;
   // Precompute product graph. Allows multiple queries.
   bool preprocess() override;
 };
@@ -17,7 +17,11 @@ double computeEuclideanPathCost(const std::vector<Point_2>& path) {
 }
 
 double computeEuclideanSegmentCost(const Point_2& from, const Point_2& to) {
-  return std::sqrt(CGAL::to_double(Segment_2(from, to).squared_length()));
+  // Evaluate in double. Constructing an exact segment only to round its
+  // length is the dominant cost when pricing many sweep edges.
+  const double dx = CGAL::to_double(to.x()) - CGAL::to_double(from.x());
+  const double dy = CGAL::to_double(to.y()) - CGAL::to_double(from.y());
+  return std::sqrt(dx * dx + dy * dy);
 }
 
 double computeVelocityRampPathCost(const std::vector<Point_2>& path,
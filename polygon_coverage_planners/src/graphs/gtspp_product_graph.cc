@@ -1,12 +1,374 @@
 #include <glog/logging.h>
+#include <algorithm>
+#include <bitset>
 #include <chrono>
+#include <cmath>
+#include <functional>
+#include <iterator>
+#include <queue>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "mav_2d_coverage_planning/graphs/gtspp_product_graph.h"
 
 namespace mav_coverage_planning {
 namespace gtspp_product_graph {
+namespace {
+typedef std::chrono::steady_clock Clock;
+
+// The sweep plan graph as clustered graph of searchProductGraph().
+class SweepPlanGraphView {
+ public:
+  SweepPlanGraphView(const sweep_plan_graph::SweepPlanGraph& graph)
+      : graph_(graph) {}
+
+  inline size_t size() const { return graph_.size(); }
+  inline size_t getStartIdx() const { return graph_.getStartIdx(); }
+  inline size_t getGoalIdx() const { return graph_.getGoalIdx(); }
+  inline size_t getCluster(size_t node_id) const {
+    const sweep_plan_graph::NodeProperty* node_property =
+        graph_.getNodeProperty(node_id);
+    return node_property == nullptr ? std::numeric_limits<size_t>::max()
+                                    : node_property->cluster;
+  }
+  template <class Visitor>
+  inline void forEachNeighbor(size_t node_id, const Visitor& visitor) const {
+    graph_.forEachNeighbor(node_id, visitor);
+  }
+
+ private:
+  const sweep_plan_graph::SweepPlanGraph& graph_;
+};
+
+// A GTSP cost matrix as clustered graph of searchProductGraph(). The path
+// starts at node start and ends at an additional goal node, i.e., a copy of
+// start with id m.size(). The other nodes of the start cluster are excluded.
+class GtspMatrixView {
+ public:
+  // cluster_ids: the boolean lattice cluster of every node. max for nodes of
+  // the start cluster and nodes without cluster.
+  GtspMatrixView(const std::vector<std::vector<int>>& m,
+                 const std::vector<size_t>& cluster_ids, size_t num_clusters,
+                 size_t start)
+      : m_(m),
+        cluster_ids_(cluster_ids),
+        num_clusters_(num_clusters),
+        start_(start) {}
+
+  inline size_t size() const { return m_.size() + 1; }
+  inline size_t getStartIdx() const { return start_; }
+  inline size_t getGoalIdx() const { return m_.size(); }
+  inline size_t getCluster(size_t node_id) const {
+    if (node_id == getStartIdx()) return num_clusters_;
+    if (node_id == getGoalIdx()) return num_clusters_ + 1;
+    return cluster_ids_[node_id];
+  }
+  template <class Visitor>
+  void forEachNeighbor(size_t node_id, const Visitor& visitor) const {
+    if (node_id == getGoalIdx()) return;
+    const std::vector<int>& row = m_[node_id];
+    for (size_t to = 0; to < row.size(); ++to) {
+      if (to == node_id || to == start_ ||
+          cluster_ids_[to] == std::numeric_limits<size_t>::max() ||
+          row[to] == std::numeric_limits<int>::max()) {
+        continue;
+      }
+      if (!visitor(to, static_cast<double>(row[to]))) return;
+    }
+    // Closing the tour.
+    if (node_id != start_ && row[start_] != std::numeric_limits<int>::max()) {
+      visitor(getGoalIdx(), static_cast<double>(row[start_]));
+    }
+  }
+
+ private:
+  const std::vector<std::vector<int>>& m_;
+  const std::vector<size_t>& cluster_ids_;
+  size_t num_clusters_;
+  size_t start_;
+};
+
+// See GtsppProductGraph::computeHeuristicBounds.
+template <class ClusteredGraph>
+void computeProductHeuristicBounds(const ClusteredGraph& graph,
+                                   size_t num_clusters,
+                                   std::vector<double>* min_out,
+                                   std::vector<double>* min_cluster) {
+  CHECK_NOTNULL(min_out);
+  CHECK_NOTNULL(min_cluster);
+  const double kInfinity = std::numeric_limits<double>::max();
+  min_out->assign(graph.size(), kInfinity);
+  min_cluster->assign(num_clusters, kInfinity);
+  for (size_t u = 0; u < graph.size(); ++u) {
+    graph.forEachNeighbor(u, [min_out, u](size_t v, double cost) {
+      (*min_out)[u] = std::min((*min_out)[u], cost);
+      return true;
+    });
+    // No outgoing edge, e.g., goal.
+    if ((*min_out)[u] == kInfinity) {
+      (*min_out)[u] = 0.0;
+    }
+
+    const size_t cluster = graph.getCluster(u);
+    if (cluster < min_cluster->size()) {
+      (*min_cluster)[cluster] =
+          std::min((*min_cluster)[cluster], (*min_out)[u]);
+    }
+  }
+  // Clusters without sweeps are unreachable. Zero stays admissible.
+  for (double& bound : *min_cluster) {
+    if (bound == kInfinity) bound = 0.0;
+  }
+}
+
+// See GtsppProductGraph::computeHeuristic.
+template <class ClusteredGraph>
+double computeProductHeuristic(const ClusteredGraph& graph,
+                               const boolean_lattice::BooleanLattice& lattice,
+                               size_t lattice_id, size_t node_id,
+                               const std::vector<double>& min_out,
+                               const std::vector<double>& min_cluster) {
+  const size_t cluster = graph.getCluster(node_id);
+  double h = min_out[node_id];
+  for (size_t k = 0; k < min_cluster.size(); ++k) {
+    if (k != cluster && !lattice.includesCluster(lattice_id, k)) {
+      h += min_cluster[k];
+    }
+  }
+  return h;
+}
+
+// Extend a path from the graph start by the cheapest edge into a cluster that
+// has not been visited, yet, until all num_clusters regular clusters are
+// visited. Then go to the goal. Returns false at a dead end.
+template <class ClusteredGraph>
+bool completeGreedily(const ClusteredGraph& graph, size_t num_clusters,
+                      Solution* path) {
+  CHECK_NOTNULL(path);
+  std::vector<bool> is_visited(num_clusters, false);
+  size_t num_visited = 0;
+  for (size_t node_id : *path) {
+    const size_t cluster = graph.getCluster(node_id);
+    if (cluster < num_clusters && !is_visited[cluster]) {
+      is_visited[cluster] = true;
+      num_visited++;
+    }
+  }
+
+  while (path->back() != graph.getGoalIdx()) {
+    const bool is_complete = num_visited == num_clusters;
+    size_t best = std::numeric_limits<size_t>::max();
+    double best_cost = std::numeric_limits<double>::max();
+    graph.forEachNeighbor(path->back(), [&](size_t to, double cost) {
+      const size_t cluster = graph.getCluster(to);
+      const bool is_candidate =
+          is_complete ? to == graph.getGoalIdx()
+                      : cluster < num_clusters && !is_visited[cluster];
+      if (is_candidate && cost < best_cost) {
+        best = to;
+        best_cost = cost;
+      }
+      return true;
+    });
+    if (best == std::numeric_limits<size_t>::max()) {
+      return false;
+    }
+    path->push_back(best);
+    if (!is_complete) {
+      is_visited[graph.getCluster(best)] = true;
+      num_visited++;
+    }
+  }
+  return true;
+}
 
-const double kTimeOut = 200.0;
+// Dijkstra or A* search on the implicit product of a clustered graph and the
+// boolean lattice of its clusters. The product node id is
+// boolean_lattice_id * graph.size() + node_id. Successors are generated on
+// expansion:
+// E1: all graph neighbors that are not covered, yet, if the node's own
+// cluster is covered.
+// E2: the single lattice successor that covers the node's cluster, if it is
+// not covered, yet.
+// path: the graph nodes from start to goal. When the deadline expires, the
+// path to the expanded node that covers the most clusters is completed
+// greedily.
+// is_optimal: optional, whether the search finished before the deadline.
+// num_expanded: optional number of expanded product graph nodes.
+template <class ClusteredGraph>
+bool searchProductGraph(const ClusteredGraph& graph,
+                        const boolean_lattice::BooleanLattice& lattice,
+                        bool use_astar, const Clock::time_point& deadline,
+                        Solution* path, bool* is_optimal,
+                        size_t* num_expanded) {
+  CHECK_NOTNULL(path);
+  path->clear();
+  const size_t num_nodes = graph.size();
+  if (num_nodes == 0 ||
+      lattice.size() > std::numeric_limits<size_t>::max() / num_nodes) {
+    LOG(ERROR) << "Invalid product graph size.";
+    return false;
+  }
+  const size_t start_idx =
+      lattice.getStartIdx() * num_nodes + graph.getStartIdx();
+  const size_t goal_idx = lattice.getGoalIdx() * num_nodes + graph.getGoalIdx();
+
+  // A* heuristic. Zero for Dijkstra.
+  std::vector<double> min_out, min_cluster;
+  if (use_astar) {
+    computeProductHeuristicBounds(graph, lattice.getNumOriginalClusters(),
+                                  &min_out, &min_cluster);
+  }
+  auto heuristic = [&](size_t idx) {
+    return use_astar
+               ? computeProductHeuristic(graph, lattice, idx / num_nodes,
+                                         idx % num_nodes, min_out, min_cluster)
+               : 0.0;
+  };
+
+  // https://en.wikipedia.org/wiki/Dijkstra%27s_algorithm
+  // Initialization. Only touched nodes are stored.
+  typedef std::pair<double, size_t> QueueEntry;
+  std::priority_queue<QueueEntry, std::vector<QueueEntry>,
+                      std::greater<QueueEntry>>
+      open_set;                           // Nodes to evaluate.
+  std::unordered_set<size_t> closed_set;  // Nodes already evaluated.
+  std::unordered_map<size_t, size_t> came_from;  // Previous node on path.
+  std::unordered_map<size_t, double> cost;       // Optimal cost from start.
+  cost[start_idx] = 0.0;
+  open_set.push(QueueEntry(heuristic(start_idx), start_idx));
+
+  auto relax = [&](size_t current, size_t neighbor, double edge_cost) {
+    if (closed_set.count(neighbor) > 0) {
+      return;  // Ignore already evaluated neighbors.
+    }
+    const double tentative_cost = cost[current] + edge_cost;
+    std::unordered_map<size_t, double>::iterator it = cost.find(neighbor);
+    if (it != cost.end() && tentative_cost >= it->second) {
+      return;  // This is not a better path to neighbor.
+    }
+    // This path is the best path to neighbor until now.
+    came_from[neighbor] = current;
+    cost[neighbor] = tentative_cost;
+    open_set.push(QueueEntry(tentative_cost + heuristic(neighbor), neighbor));
+  };
+
+  // The expanded node that covers the most clusters, the cheapest on ties.
+  size_t best_expanded = start_idx;
+  size_t best_num_covered = 0;
+  bool is_expired = false;
+  while (!open_set.empty()) {
+    if (!closed_set.empty() && Clock::now() > deadline) {
+      is_expired = true;
+      break;
+    }
+    // Pop vertex with lowest score from open set.
+    const size_t current = open_set.top().second;
+    open_set.pop();
+    if (!closed_set.insert(current).second) {
+      continue;  // Outdated entry.
+    }
+    if (current == goal_idx) {  // Reached goal.
+      break;
+    }
+
+    // Generate all neighbors.
+    const size_t lattice_id = current / num_nodes;
+    const size_t node_id = current % num_nodes;
+    if (lattice.isRegularNode(lattice_id)) {
+      const size_t num_covered = std::bitset<64>(lattice_id).count();
+      if (num_covered > best_num_covered ||
+          (num_covered == best_num_covered &&
+           cost[current] < cost[best_expanded])) {
+        best_expanded = current;
+        best_num_covered = num_covered;
+      }
+    }
+    const size_t cluster = graph.getCluster(node_id);
+    if (lattice.includesCluster(lattice_id, cluster)) {
+      // E1 edges.
+      graph.forEachNeighbor(node_id, [&](size_t to_node_id, double edge_cost) {
+        if (!lattice.includesCluster(lattice_id,
+                                     graph.getCluster(to_node_id))) {
+          relax(current, lattice_id * num_nodes + to_node_id, edge_cost);
+        }
+        return true;
+      });
+    } else {
+      // E2 edge.
+      const size_t to_lattice_id = lattice.getSuccessor(lattice_id, cluster);
+      if (to_lattice_id != std::numeric_limits<size_t>::max()) {
+        double edge_cost = -1.0;
+        if (!lattice.getEdgeCost(EdgeId(lattice_id, to_lattice_id),
+                                 &edge_cost)) {
+          return false;
+        }
+        relax(current, to_lattice_id * num_nodes + node_id, edge_cost);
+      }
+    }
+  }
+  if (num_expanded != nullptr) {
+    *num_expanded = closed_set.size();
+  }
+  if (is_optimal != nullptr) {
+    *is_optimal = !is_expired;
+  }
+  const size_t last = is_expired ? best_expanded : goal_idx;
+  if (closed_set.count(last) == 0) {
+    return false;
+  }
+
+  // Translate the product graph path into graph nodes. E2 edges stay at the
+  // same node.
+  Solution solution = {last};
+  for (std::unordered_map<size_t, size_t>::const_iterator it =
+           came_from.find(last);
+       it != came_from.end(); it = came_from.find(it->second)) {
+    solution.push_back(it->second);
+  }
+  for (Solution::const_reverse_iterator it = solution.rbegin();
+       it != solution.rend(); ++it) {
+    const size_t node_id = *it % num_nodes;
+    if (path->empty() || path->back() != node_id) {
+      path->push_back(node_id);
+    }
+  }
+
+  LOG(INFO) << (use_astar ? "A*" : "Dijkstra") << " expanded "
+            << closed_set.size() << " nodes of the implicit product graph.";
+  if (is_expired) {
+    LOG(WARNING) << "Product graph search exhausted its budget. Completing the "
+                    "best partial path greedily.";
+    return completeGreedily(graph, lattice.getNumOriginalClusters(), path);
+  }
+  return true;
+}
+
+// The cost of a sweep plan graph path in milli units.
+int64_t computeMilliCost(const sweep_plan_graph::SweepPlanGraph& graph,
+                         const Solution& sweep_plan_solution) {
+  double cost = 0.0;
+  for (size_t i = 0; i + 1 < sweep_plan_solution.size(); ++i) {
+    double edge_cost = 0.0;
+    if (!graph.getEdgeCost(
+            EdgeId(sweep_plan_solution[i], sweep_plan_solution[i + 1]),
+            &edge_cost)) {
+      return std::numeric_limits<int64_t>::max();
+    }
+    cost += edge_cost;
+  }
+  return static_cast<int64_t>(std::round(cost * kToMilli));
+}
+
+void updateIncumbent(const sweep_plan_graph::SweepPlanGraph& graph,
+                     const Solution& sweep_plan_solution,
+                     GtspIncumbent* incumbent) {
+  if (incumbent == nullptr) return;
+  incumbent->update(std::vector<int>(sweep_plan_solution.begin(),
+                                     sweep_plan_solution.end()),
+                    computeMilliCost(graph, sweep_plan_solution));
+}
+}  // namespace
 
 bool GtsppProductGraph::create() {
   if (sweep_plan_graph_ == nullptr || boolean_lattice_ == nullptr) {
@@ -25,9 +387,10 @@ bool GtsppProductGraph::create() {
       }
     }
   }
+  freeze();
 
   LOG(INFO) << "Created GTSPP product graph with " << graph_.size()
-            << " nodes and " << edge_properties_.size() << " edges.";
+            << " nodes and " << getNumberOfEdges() << " edges.";
   is_created_ = true;
   return true;
 }
@@ -38,21 +401,9 @@ bool GtsppProductGraph::createOnline() {
     return false;
   }
 
-  graph_.resize(boolean_lattice_->size() * sweep_plan_graph_->size());
-
-  for (size_t lattice_id = 0; lattice_id < boolean_lattice_->size();
-       ++lattice_id) {
-    for (size_t sweep_id = 0; sweep_id < sweep_plan_graph_->size();
-         ++sweep_id) {
-      // Add node without edges.
-      const size_t idx = lattice_id * sweep_plan_graph_->size() + sweep_id;
-      node_properties_.insert(
-          std::make_pair(idx, NodeProperty(sweep_id, lattice_id)));
-    }
-  }
-
-  LOG(INFO) << "Created GTSPP product graph with " << graph_.size()
-            << " nodes without edges.";
+  LOG(INFO) << "Created implicit GTSPP product graph with "
+            << boolean_lattice_->size() * sweep_plan_graph_->size()
+            << " nodes.";
   is_created_ = true;
   return true;
 }
@@ -67,13 +418,10 @@ bool GtsppProductGraph::addStartNode(const NodeProperty& node_property) {
   if (boolean_lattice_ == nullptr) {
     return false;
   }
-  auto start_time = std::chrono::high_resolution_clock::now();
   for (size_t lattice_id = 0; lattice_id < boolean_lattice_->size();
        ++lattice_id) {
-    auto current_time = std::chrono::high_resolution_clock::now();
-    std::chrono::duration<double> elapsed = current_time - start_time;
-    if (elapsed.count() > kTimeOut) {
-      LOG(ERROR) << "Timout addStartNode.";
+    if (Clock::now() > deadline_) {
+      LOG(WARNING) << "Timeout addStartNode.";
       return false;
     }
     if (lattice_id == boolean_lattice_->getStartIdx()) {
@@ -92,13 +440,10 @@ bool GtsppProductGraph::addGoalNode(const NodeProperty& node_property) {
   if (boolean_lattice_ == nullptr) {
     return false;
   }
-  auto start_time = std::chrono::high_resolution_clock::now();
   for (size_t lattice_id = 0; lattice_id < boolean_lattice_->size();
        ++lattice_id) {
-    auto current_time = std::chrono::high_resolution_clock::now();
-    std::chrono::duration<double> elapsed = current_time - start_time;
-    if (elapsed.count() > kTimeOut) {
-      LOG(ERROR) << "Timout addGoalNode.";
+    if (Clock::now() > deadline_) {
+      LOG(WARNING) << "Timeout addGoalNode.";
       return false;
     }
     if (lattice_id == boolean_lattice_->getGoalIdx()) {
@@ -114,10 +459,15 @@ bool GtsppProductGraph::addGoalNode(const NodeProperty& node_property) {
 bool GtsppProductGraph::addGoalNode() { return addGoalNode(NodeProperty()); }
 
 bool GtsppProductGraph::solve(const Point_2& start, const Point_2& goal,
-                              std::vector<Point_2>* waypoints) const {
+                              std::vector<Point_2>* waypoints,
+                              GtspIncumbent* incumbent) const {
+  CHECK_NOTNULL(waypoints);
+  waypoints->clear();
+
   if (!is_created_) {
     return false;
   }
+  const Clock::time_point deadline = budget_.computeDeadline();
   // Create copies of graphs to add start and goal.
   GtsppProductGraph temp_gtspp_product_graph = *this;
   sweep_plan_graph::SweepPlanGraph temp_sweep_plan_graph = *sweep_plan_graph_;
@@ -141,31 +491,59 @@ bool GtsppProductGraph::solve(const Point_2& start, const Point_2& goal,
       !temp_sweep_plan_graph.addGoalNode(goal_sweep_node)) {
     return false;
   }
+  temp_sweep_plan_graph.freeze();
 
   temp_gtspp_product_graph.setSweepPlanGraph(&temp_sweep_plan_graph);
   temp_gtspp_product_graph.setBooleanLattice(&temp_boolean_lattice);
+  temp_gtspp_product_graph.deadline_ = deadline;
+  Solution sweep_plan_solution;
   if (!temp_gtspp_product_graph.addStartNode() ||
       !temp_gtspp_product_graph.addGoalNode()) {
-    return false;
+    if (Clock::now() <= deadline) {
+      return false;
+    }
+    // Search the best partial solution implicitly instead.
+    GtsppProductGraph implicit_graph(&temp_sweep_plan_graph,
+                                     &temp_boolean_lattice);
+    implicit_graph.setUseAStar(use_astar_);
+    return implicit_graph.solveImplicit(deadline, &sweep_plan_solution,
+                                        nullptr, incumbent) &&
+           temp_sweep_plan_graph.getWaypoints(sweep_plan_solution, waypoints);
   }
+  temp_gtspp_product_graph.freeze();
 
-  // Solve graph using Dijkstra.
+  // Solve graph using A* or Dijkstra.
   Solution solution;
-  if (!temp_gtspp_product_graph.solveDijkstra(&solution)) {
+  if (use_astar_) {
+    if (!temp_gtspp_product_graph.solveAStar(&solution)) {
+      LOG(ERROR) << "A* failed.";
+      return false;
+    }
+  } else if (!temp_gtspp_product_graph.solveDijkstra(&solution)) {
     LOG(ERROR) << "Dijkstra failed.";
     return false;
   }
 
-  return temp_gtspp_product_graph.getWaypoints(solution, waypoints);
+  if (!temp_gtspp_product_graph.getSweepPlanSolution(solution,
+                                                     &sweep_plan_solution)) {
+    return false;
+  }
+  updateIncumbent(temp_sweep_plan_graph, sweep_plan_solution, incumbent);
+  return temp_sweep_plan_graph.getWaypoints(sweep_plan_solution, waypoints);
 }
 
 bool GtsppProductGraph::solveOnline(const Point_2& start, const Point_2& goal,
-                                    std::vector<Point_2>* waypoints) const {
+                                    std::vector<Point_2>* waypoints,
+                                    size_t* num_expanded,
+                                    GtspIncumbent* incumbent) const {
   CHECK_NOTNULL(waypoints);
   waypoints->clear();
 
+  if (!is_created_) {
+    return false;
+  }
+  const Clock::time_point deadline = budget_.computeDeadline();
   // Create temporary graph structure.
-  GtsppProductGraph temp_gtspp_product_graph = *this;
   sweep_plan_graph::SweepPlanGraph temp_sweep_plan_graph = *sweep_plan_graph_;
   boolean_lattice::BooleanLattice temp_boolean_lattice = *boolean_lattice_;
 
@@ -187,22 +565,20 @@ bool GtsppProductGraph::solveOnline(const Point_2& start, const Point_2& goal,
       !temp_sweep_plan_graph.addGoalNode(goal_sweep_node)) {
     return false;
   }
+  temp_sweep_plan_graph.freeze();
 
-  temp_gtspp_product_graph.setSweepPlanGraph(&temp_sweep_plan_graph);
-  temp_gtspp_product_graph.setBooleanLattice(&temp_boolean_lattice);
-  if (!temp_gtspp_product_graph.addStartNode() ||
-      !temp_gtspp_product_graph.addGoalNode()) {
-    return false;
-  }
-
-  // Create graph while solving Dijkstra.
-  Solution solution;
-  if (!temp_gtspp_product_graph.createDijkstra(&solution)) {
-    LOG(ERROR) << "Dijkstra failed.";
+  // Generate graph while solving Dijkstra.
+  GtsppProductGraph temp_gtspp_product_graph(&temp_sweep_plan_graph,
+                                             &temp_boolean_lattice);
+  temp_gtspp_product_graph.setUseAStar(use_astar_);
+  Solution sweep_plan_solution;
+  if (!temp_gtspp_product_graph.solveImplicit(deadline, &sweep_plan_solution,
+                                              num_expanded, incumbent)) {
+    LOG(ERROR) << (use_astar_ ? "A*" : "Dijkstra") << " failed.";
     return false;
   }
 
-  return temp_gtspp_product_graph.getWaypoints(solution, waypoints);
+  return temp_sweep_plan_graph.getWaypoints(sweep_plan_solution, waypoints);
 }
 
 bool GtsppProductGraph::getWaypoints(const Solution& solution,
@@ -210,12 +586,21 @@ bool GtsppProductGraph::getWaypoints(const Solution& solution,
   CHECK_NOTNULL(waypoints);
   waypoints->clear();
 
+  Solution sweep_plan_solution;
+  return getSweepPlanSolution(solution, &sweep_plan_solution) &&
+         sweep_plan_graph_->getWaypoints(sweep_plan_solution, waypoints);
+}
+
+bool GtsppProductGraph::getSweepPlanSolution(
+    const Solution& solution, Solution* sweep_plan_solution) const {
+  CHECK_NOTNULL(sweep_plan_solution);
+  sweep_plan_solution->clear();
+
   if (sweep_plan_graph_ == nullptr) {
     LOG(ERROR) << "Sweep plan graph not set.";
     return false;
   }
   // Translate product graph solution in sweep plan graph indices.
-  Solution sweep_plan_solution;
   for (size_t i = 0; i < solution.size() - 1; ++i) {
     // Access edge and node properties.
     const EdgeId edge_id(solution[i], solution[i + 1]);
@@ -229,15 +614,14 @@ bool GtsppProductGraph::getWaypoints(const Solution& solution,
 
     // Check edge type (E1) and add to solution.
     if (edge_property->type == EdgeProperty::Type::kE1) {
-      if (sweep_plan_solution.empty()) {
-        sweep_plan_solution.push_back(from_node_property->sweep_plan_graph_id);
+      if (sweep_plan_solution->empty()) {
+        sweep_plan_solution->push_back(
+            from_node_property->sweep_plan_graph_id);
       }
-      sweep_plan_solution.push_back(to_node_property->sweep_plan_graph_id);
+      sweep_plan_solution->push_back(to_node_property->sweep_plan_graph_id);
     }
   }
-
-  // Get waypoints.
-  return sweep_plan_graph_->getWaypoints(sweep_plan_solution, waypoints);
+  return true;
 }
 
 bool GtsppProductGraph::addEdges() {
@@ -291,84 +675,70 @@ bool GtsppProductGraph::isE1(const EdgeId& edge_id) const {
   // Access node properties.
   const NodeProperty* from = getNodeProperty(edge_id.first);
   const NodeProperty* to = getNodeProperty(edge_id.second);
-  const boolean_lattice::NodeProperty* c =
-      getBooleanLatticeNodeProperty(edge_id.first);
   const sweep_plan_graph::NodeProperty* from_v =
       getSweepPlanGraphNodeProperty(edge_id.first);
   const sweep_plan_graph::NodeProperty* to_v =
       getSweepPlanGraphNodeProperty(edge_id.second);
-  if (from == nullptr || to == nullptr || c == nullptr || from_v == nullptr ||
-      to_v == nullptr || sweep_plan_graph_ == nullptr) {
+  if (from == nullptr || to == nullptr || from_v == nullptr ||
+      to_v == nullptr || sweep_plan_graph_ == nullptr ||
+      boolean_lattice_ == nullptr) {
     return false;  // Bad access.
   }
 
   return isE1(from->boolean_lattice_id, to->boolean_lattice_id,
               from->sweep_plan_graph_id, to->sweep_plan_graph_id,
-              c->visited_clusters, from_v->cluster, to_v->cluster);
+              from_v->cluster, to_v->cluster);
 }
 
 bool GtsppProductGraph::isE1(size_t from_boolean_lattice_id,
                              size_t to_boolean_lattice_id,
                              size_t from_sweep_plan_graph_id,
                              size_t to_sweep_plan_graph_id,
-                             const std::set<size_t>& cluster_set,
                              size_t from_sweep_cluster,
                              size_t to_sweep_cluster) const {
   return from_boolean_lattice_id == to_boolean_lattice_id  // Same lattice node.
          && sweep_plan_graph_->edgeExists(EdgeId(
                 from_sweep_plan_graph_id,
                 to_sweep_plan_graph_id))  // Sweep plan graph edge exists.
-         && cluster_set.count(from_sweep_cluster) >
-                0  // From vertex is covered already.
-         && cluster_set.count(to_sweep_cluster) ==
-                0;  // To vertex is not covered, yet.
+         && boolean_lattice_->includesCluster(
+                from_boolean_lattice_id,
+                from_sweep_cluster)  // From vertex is covered already.
+         && !boolean_lattice_->includesCluster(
+                from_boolean_lattice_id,
+                to_sweep_cluster);  // To vertex is not covered, yet.
 }
 
 bool GtsppProductGraph::isE2(const EdgeId& edge_id) const {
   // Access node properties.
   const NodeProperty* from = getNodeProperty(edge_id.first);
   const NodeProperty* to = getNodeProperty(edge_id.second);
-  const boolean_lattice::NodeProperty* from_c =
-      getBooleanLatticeNodeProperty(edge_id.first);
-  const boolean_lattice::NodeProperty* to_c =
-      getBooleanLatticeNodeProperty(edge_id.second);
   const sweep_plan_graph::NodeProperty* v =
       getSweepPlanGraphNodeProperty(edge_id.first);
-  if (from == nullptr || to == nullptr || from_c == nullptr ||
-      to_c == nullptr || v == nullptr || boolean_lattice_ == nullptr) {
+  if (from == nullptr || to == nullptr || v == nullptr ||
+      boolean_lattice_ == nullptr) {
     return false;  // Bad access.
   }
 
   return isE2(from->sweep_plan_graph_id, to->sweep_plan_graph_id,
-              from->boolean_lattice_id, to->boolean_lattice_id,
-              from_c->visited_clusters, to_c->visited_clusters, v->cluster);
+              from->boolean_lattice_id, to->boolean_lattice_id, v->cluster);
 }
 
 bool GtsppProductGraph::isE2(size_t from_sweep_plan_graph_id,
                              size_t to_sweep_plan_graph_id,
                              size_t from_boolean_lattice_id,
                              size_t to_boolean_lattice_id,
-                             const std::set<size_t>& from_cluster_set,
-                             const std::set<size_t>& to_cluster_set,
                              size_t sweep_cluster) const {
   return from_sweep_plan_graph_id ==
              to_sweep_plan_graph_id  // Same sweep plan graph node.
          && boolean_lattice_->edgeExists(
                 EdgeId(from_boolean_lattice_id,
                        to_boolean_lattice_id))  // Boolean lattice edge exists.
-         && from_cluster_set.count(sweep_cluster) ==
-                0  // Vertex is not in visited clusters of from_c.
-         && to_cluster_set.count(sweep_cluster) >
-                0;  // Vertex is in visited clusters of to_c.
-}
-
-const boolean_lattice::NodeProperty*
-GtsppProductGraph::getBooleanLatticeNodeProperty(size_t node_id) const {
-  const NodeProperty* node_property = getNodeProperty(node_id);
-  if (boolean_lattice_ == nullptr || node_property == nullptr) {
-    return nullptr;
-  }
-  return boolean_lattice_->getNodeProperty(node_property->boolean_lattice_id);
+         && !boolean_lattice_->includesCluster(
+                from_boolean_lattice_id,
+                sweep_cluster)  // Vertex is not in visited clusters of from_c.
+         && boolean_lattice_->includesCluster(
+                to_boolean_lattice_id,
+                sweep_cluster);  // Vertex is in visited clusters of to_c.
 }
 
 const sweep_plan_graph::NodeProperty*
@@ -414,85 +784,135 @@ bool GtsppProductGraph::getBooleanLatticeEdgeCost(const EdgeId& edge_id,
   return boolean_lattice_->getEdgeCost(boolean_lattice_edge, cost);
 }
 
-bool GtsppProductGraph::createDijkstra(Solution* solution) {
-  CHECK_NOTNULL(solution);
-  solution->clear();
-  if (!nodeExists(start_idx_) || !nodeExists(goal_idx_)) {
+bool GtsppProductGraph::solveImplicit(const Clock::time_point& deadline,
+                                      Solution* sweep_plan_solution,
+                                      size_t* num_expanded,
+                                      GtspIncumbent* incumbent) const {
+  CHECK_NOTNULL(sweep_plan_solution);
+  sweep_plan_solution->clear();
+  if (sweep_plan_graph_ == nullptr || boolean_lattice_ == nullptr) {
+    LOG(ERROR) << "Sweep plan graph or boolean lattice not set.";
     return false;
   }
-  clearEdges();
 
-  // https://en.wikipedia.org/wiki/Dijkstra%27s_algorithm
-  // Initialization.
-  std::set<size_t> open_set = {start_idx_};  // Nodes to evaluate.
-  std::set<size_t> closed_set;               // Nodes already evaluated.
-  std::map<size_t, size_t> came_from;  // Get previous node on optimal path.
-  std::map<size_t, double> cost;       // Optimal cost from start.
-  for (size_t i = 0; i < graph_.size(); i++) {
-    cost[i] = std::numeric_limits<double>::max();
+  if (!searchProductGraph(SweepPlanGraphView(*sweep_plan_graph_),
+                          *boolean_lattice_, use_astar_, deadline,
+                          sweep_plan_solution, nullptr, num_expanded)) {
+    return false;
   }
-  cost[start_idx_] = 0.0;
+  updateIncumbent(*sweep_plan_graph_, *sweep_plan_solution, incumbent);
+  return true;
+}
 
-  auto start_time = std::chrono::high_resolution_clock::now();
-  while (!open_set.empty()) {
-    auto current_time = std::chrono::high_resolution_clock::now();
-    std::chrono::duration<double> elapsed = current_time - start_time;
-    if (elapsed.count() > kTimeOut) {
-      LOG(ERROR) << "Timout createDijkstra.";
+bool GtsppProductGraph::calculateHeuristic(size_t goal,
+                                           Heuristic* heuristic) const {
+  CHECK_NOTNULL(heuristic);
+  heuristic->clear();
+  if (goal != goal_idx_) {
+    LOG(ERROR) << "Heuristic only available for the graph goal.";
+    return false;
+  }
+
+  std::vector<double> min_out, min_cluster;
+  if (!computeHeuristicBounds(&min_out, &min_cluster)) {
+    return false;
+  }
+  for (size_t i = 0; i < graph_.size(); ++i) {
+    const NodeProperty* node_property = getNodeProperty(i);
+    if (node_property == nullptr) {
       return false;
     }
-    // Pop vertex with lowest score from open set.
-    size_t current = *std::min_element(
-        open_set.begin(), open_set.end(),
-        [&cost](size_t i, size_t j) { return cost[i] < cost[j]; });
-    if (current == goal_idx_) {  // Reached goal.
-      *solution = reconstructSolution(came_from, current);
-      return true;
-    }
-    open_set.erase(current);
-    closed_set.insert(current);
+    (*heuristic)[i] = computeHeuristic(node_property->boolean_lattice_id,
+                                       node_property->sweep_plan_graph_id,
+                                       min_out, min_cluster);
+  }
+  return true;
+}
 
-    // Create all neighbors.
-    for (size_t adj_id = 0; adj_id < graph_.size(); ++adj_id) {
-      const EdgeId forwards_edge_id(current, adj_id);
-      // E1 edges.
-      if (isE1(forwards_edge_id)) {
-        double temp_cost = -1.0;
-        EdgeProperty edge_property(EdgeProperty::Type::kE1);
-        if (!getSweepPlanGraphEdgeCost(forwards_edge_id, &temp_cost) ||
-            !addEdge(forwards_edge_id, edge_property, temp_cost)) {
-          return false;
-        }
-      } else if (isE2(forwards_edge_id)) {
-        double temp_cost = -1.0;
-        EdgeProperty edge_property(EdgeProperty::Type::kE2);
-        if (!getBooleanLatticeEdgeCost(forwards_edge_id, &temp_cost) ||
-            !addEdge(forwards_edge_id, edge_property, temp_cost)) {
-          return false;
-        }
-      }
-    }
+bool GtsppProductGraph::computeHeuristicBounds(
+    std::vector<double>* min_out, std::vector<double>* min_cluster) const {
+  if (sweep_plan_graph_ == nullptr || boolean_lattice_ == nullptr) {
+    LOG(ERROR) << "Sweep plan graph or boolean lattice not set.";
+    return false;
+  }
+  computeProductHeuristicBounds(SweepPlanGraphView(*sweep_plan_graph_),
+                                boolean_lattice_->getNumOriginalClusters(),
+                                min_out, min_cluster);
+  return true;
+}
 
-    // Check all neighbors.
-    for (const std::pair<size_t, double>& n : graph_[current]) {
-      if (closed_set.count(n.first) > 0) {
-        continue;  // Ignore already evaluated neighbors.
-      }
-      open_set.insert(n.first);  // Add to open set if not already in.
-
-      // The distance from start to a neighbor.
-      const double tentative_cost = cost[current] + n.second;
-      if (tentative_cost >= cost[n.first]) {
-        continue;  // This is not a better path to n.
-      } else {
-        // This path is the best path to n until now.
-        came_from[n.first] = current;
-        cost[n.first] = tentative_cost;
-      }
+double GtsppProductGraph::computeHeuristic(
+    size_t boolean_lattice_id, size_t sweep_plan_graph_id,
+    const std::vector<double>& min_out,
+    const std::vector<double>& min_cluster) const {
+  return computeProductHeuristic(SweepPlanGraphView(*sweep_plan_graph_),
+                                 *boolean_lattice_, boolean_lattice_id,
+                                 sweep_plan_graph_id, min_out, min_cluster);
+}
+
+bool GtsppProductGraphSolver::solveTask(
+    const std::vector<std::vector<int>>& m,
+    const std::vector<std::vector<int>>& clusters,
+    const Clock::time_point& deadline, std::vector<int>* solution,
+    GtspIncumbent* incumbent) const {
+  CHECK_NOTNULL(solution);
+  solution->clear();
+
+  // Every tour passes the smallest cluster.
+  size_t start_cluster = 0;
+  for (size_t c = 1; c < clusters.size(); ++c) {
+    if (clusters[c].size() < clusters[start_cluster].size()) {
+      start_cluster = c;
     }
   }
+  if (clusters.size() == 1) {
+    solution->push_back(clusters[start_cluster].front());
+    if (incumbent) incumbent->update(*solution, 0);
+    return true;
+  }
+  const size_t num_clusters = clusters.size() - 1;
+  if (num_clusters > boolean_lattice::BooleanLattice::kMaxNumClusters) {
+    LOG(ERROR) << "Too many clusters for the boolean lattice: "
+               << clusters.size();
+    return false;
+  }
+
+  // The remaining clusters are the regular lattice clusters.
+  std::vector<size_t> cluster_ids(m.size(),
+                                  std::numeric_limits<size_t>::max());
+  size_t cluster_id = 0;
+  for (size_t c = 0; c < clusters.size(); ++c) {
+    if (c == start_cluster) continue;
+    for (int v : clusters[c]) cluster_ids[v] = cluster_id;
+    cluster_id++;
+  }
+  boolean_lattice::BooleanLattice lattice(num_clusters);
+  if (!lattice.addStartNode() || !lattice.addGoalNode()) {
+    return false;
+  }
 
-  return false;
+  int64_t best_cost = std::numeric_limits<int64_t>::max();
+  for (size_t i = 0; i < clusters[start_cluster].size(); ++i) {
+    if (i > 0 && Clock::now() > deadline) {
+      break;
+    }
+    const GtspMatrixView graph(m, cluster_ids, num_clusters,
+                               clusters[start_cluster][i]);
+    Solution path;
+    if (!searchProductGraph(graph, lattice, use_astar_, deadline, &path,
+                            nullptr, nullptr)) {
+      continue;
+    }
+    // Drop the goal, i.e., the copy of the start node.
+    const std::vector<int> tour(path.begin(), std::prev(path.end()));
+    const int64_t cost = computeCost(m, tour);
+    if (cost < best_cost) {
+      *solution = tour;
+      best_cost = cost;
+      if (incumbent) incumbent->update(tour, cost);
+    }
+  }
+  return !solution->empty();
 }
 
 }  // namespace gtspp_product_graph
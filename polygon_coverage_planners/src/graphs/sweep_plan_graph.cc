@@ -1,120 +1,206 @@
 #include "mav_2d_coverage_planning/graphs/sweep_plan_graph.h"
 
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <thread>
+
 #include <glog/logging.h>
 
 #include <mav_coverage_planning_comm/timing.h>
 
 #include <mav_coverage_graph_solvers/gk_ma.h>
+#include <mav_coverage_graph_solvers/parallel_for.h>
+#include <polygon_coverage_geometry/cgal_comm.h>
 #include "mav_2d_coverage_planning/geometry/sweep.h"
 
 namespace mav_coverage_planning {
 namespace sweep_plan_graph {
 
-bool NodeProperty::isNonOptimal(
-    const visibility_graph::VisibilityGraph& visibility_graph,
-    const std::vector<NodeProperty>& node_properties,
-    const PathCostFunctionType& cost_function) const {
-  if (waypoints.empty()) {
-    LOG(WARNING) << "Node does not have waypoints.";
+bool SweepPlanGraph::create() {
+  clear();
+  // All edges are shortest paths in the same visibility graph.
+  timing::Timer timer_all_pairs("visibility_all_pairs");
+  if (!visibility_graph_.precomputeAllPairs()) {
+    LOG(ERROR) << "Cannot precompute visibility graph shortest paths.";
     return false;
   }
-
-  for (const NodeProperty& node_property : node_properties) {
-    if (node_property.waypoints.empty()) {
-      LOG(WARNING) << "Comparison node does not have waypoints.";
-      continue;
+  timer_all_pairs.Stop();
+  pruning_statistics_ = PruningStatistics();
+
+  // Create and prune the sweep plans of all clusters in parallel. The threads
+  // not needed for the clusters are used within the clusters. The clusters
+  // share the decomposition and the visibility graph, i.e., they are only
+  // created in parallel if the kernel is thread-safe.
+  timing::Timer timer_cluster_nodes("cluster_nodes");
+  const size_t num_clusters = polygon_clusters_.size();
+  const size_t num_threads =
+      std::max<size_t>(1, std::thread::hardware_concurrency());
+  const size_t num_cluster_threads = std::min(
+      polygon_coverage_planning::getKernelThreads(num_threads), num_clusters);
+  const size_t num_threads_per_cluster = std::max<size_t>(
+      1, num_threads / std::max<size_t>(1, num_cluster_threads));
+  std::vector<std::vector<NodeProperty>> cluster_nodes(num_clusters);
+  std::vector<PruningStatistics> cluster_statistics(num_clusters);
+  std::vector<char> is_cluster_created(num_clusters, false);
+  parallelFor(num_clusters, num_cluster_threads, [&](size_t cluster) {
+    is_cluster_created[cluster] =
+        createClusterNodes(cluster, num_threads_per_cluster,
+                           &cluster_nodes[cluster],
+                           &cluster_statistics[cluster]);
+  });
+  timer_cluster_nodes.Stop();
+
+  // Merge in cluster order. The edges are added in bulk.
+  defer_edges_ = true;
+  for (size_t cluster = 0; cluster < num_clusters; ++cluster) {
+    if (!is_cluster_created[cluster]) {
+      defer_edges_ = false;
+      return false;
     }
-    if (node_property.cluster == cluster) {
-      std::vector<Point_2> path_front_front, path_back_back;
-      if (!visibility_graph.solve(
-              waypoints.front(), visibility_polygons.front(),
-              node_property.waypoints.front(),
-              node_property.visibility_polygons.front(), &path_front_front) ||
-          !visibility_graph.solve(node_property.waypoints.back(),
-                                  node_property.visibility_polygons.back(),
-                                  waypoints.back(), visibility_polygons.back(),
-                                  &path_back_back)) {
-        continue;
-      }
-      if (cost_function(path_front_front) + node_property.cost +
-              cost_function(path_back_back) <
-          cost) {
-        return true;
+    pruning_statistics_.num_sweeps += cluster_statistics[cluster].num_sweeps;
+    pruning_statistics_.num_pruned += cluster_statistics[cluster].num_pruned;
+    pruning_statistics_.num_path_queries +=
+        cluster_statistics[cluster].num_path_queries;
+    for (const NodeProperty& node_property : cluster_nodes[cluster]) {
+      if (!addNode(node_property)) {
+        defer_edges_ = false;
+        return false;
       }
     }
   }
-  return false;
+  defer_edges_ = false;
+
+  timing::Timer timer_edge_creation("edge_creation");
+  if (!addAllEdges()) {
+    return false;
+  }
+  timer_edge_creation.Stop();
+  freeze();
+
+  LOG(INFO) << "Created sweep plan graph with " << graph_.size()
+            << " nodes and " << getNumberOfEdges() << " edges.";
+  LOG(INFO) << "Pruned " << pruning_statistics_.num_pruned << " of "
+            << pruning_statistics_.num_sweeps << " nodes.";
+  is_created_ = true;
+  return true;
 }
 
-bool SweepPlanGraph::create() {
-  clear();
-  size_t num_sweep_plans = 0;
-  // Create sweep plans for each cluster.
-  for (size_t cluster = 0; cluster < polygon_clusters_.size(); ++cluster) {
-    // Compute all cluster sweeps.
-    std::vector<std::vector<Point_2>> cluster_sweeps;
-    timing::Timer timer_line_sweeps("line_sweeps");
-    if (sweep_single_direction_) {
-      Direction_2 best_dir;
-      polygon_clusters_[cluster].findMinAltitude(polygon_clusters_[cluster],
-                                                 &best_dir);
-      visibility_graph::VisibilityGraph vis_graph(polygon_clusters_[cluster]);
-      const Polygon_2& poly =
-          polygon_clusters_[cluster].getPolygon().outer_boundary();
-      cluster_sweeps.resize(1);
-      if (!computeSweep(poly, vis_graph, sweep_distance_, best_dir, true,
-                        &cluster_sweeps.front())) {
-        LOG(ERROR) << "Cannot compute single sweep for cluster: " << cluster;
-        return false;
-      }
-    } else {
-      if (!computeAllSweeps(polygon_clusters_[cluster], sweep_distance_,
-                            &cluster_sweeps)) {
-        LOG(ERROR) << "Cannot create all sweep plans for cluster " << cluster;
-        return false;
-      }
+bool SweepPlanGraph::createClusterNodes(
+    size_t cluster, size_t num_threads,
+    std::vector<NodeProperty>* node_properties,
+    PruningStatistics* statistics) const {
+  CHECK_NOTNULL(node_properties);
+  CHECK_NOTNULL(statistics);
+
+  // Compute all cluster sweeps.
+  std::vector<std::vector<Point_2>> cluster_sweeps;
+  if (sweep_single_direction_) {
+    Direction_2 best_dir;
+    polygon_clusters_[cluster].findMinAltitude(polygon_clusters_[cluster],
+                                               &best_dir);
+    visibility_graph::VisibilityGraph vis_graph(polygon_clusters_[cluster]);
+    const Polygon_2& poly =
+        polygon_clusters_[cluster].getPolygon().outer_boundary();
+    cluster_sweeps.resize(1);
+    if (!computeSweep(poly, vis_graph, sweep_distance_, best_dir, true,
+                      &cluster_sweeps.front())) {
+      LOG(ERROR) << "Cannot compute single sweep for cluster: " << cluster;
+      return false;
     }
-    num_sweep_plans += cluster_sweeps.size();
-    timer_line_sweeps.Stop();
-
-    // Create node properties.
-    timing::Timer timer_node_creation("node_creation");
-    std::vector<NodeProperty> node_properties;
-    node_properties.resize(cluster_sweeps.size());
-    for (size_t i = 0; i < node_properties.size(); ++i) {
-      NodeProperty node;
-      if (!createNodeProperty(cluster, &cluster_sweeps[i], &node)) {
-        return false;
-      }
-      node_properties[i] = node;
+  } else {
+    if (!computeAllSweeps(polygon_clusters_[cluster], sweep_distance_,
+                          &cluster_sweeps)) {
+      LOG(ERROR) << "Cannot create all sweep plans for cluster " << cluster;
+      return false;
     }
-    timer_node_creation.Stop();
-
-    timing::Timer timer_pruning("pruning");
-    // Prune nodes that are definitely not optimal.
-    std::vector<NodeProperty>::iterator new_end = std::remove_if(
-        node_properties.begin(), node_properties.end(),
-        [node_properties, this](const NodeProperty& node_property) {
-          return node_property.isNonOptimal(visibility_graph_, node_properties,
-                                            cost_function_);
-        });
-    node_properties.erase(new_end, node_properties.end());
-    timer_pruning.Stop();
-
-    // For each remaining sweep create a node.
-    timing::Timer timer_edge_creation("edge_creation");
-    for (const NodeProperty& node_property : node_properties) {
-      if (!addNode(node_property)) {
-        return false;
+  }
+
+  // Create node properties.
+  if (!createNodeProperties(cluster, &cluster_sweeps, node_properties,
+                            num_threads)) {
+    return false;
+  }
+
+  // Prune nodes that are definitely not optimal.
+  return pruneNonOptimal(num_threads, node_properties, statistics);
+}
+
+bool SweepPlanGraph::pruneNonOptimal(
+    size_t num_threads, std::vector<NodeProperty>* node_properties,
+    PruningStatistics* statistics) const {
+  CHECK_NOTNULL(node_properties);
+  CHECK_NOTNULL(statistics);
+  const size_t num_nodes = node_properties->size();
+  for (const NodeProperty& node_property : *node_properties) {
+    if (node_property.waypoints.empty() ||
+        node_property.visibility_queries.empty()) {
+      LOG(ERROR) << "Node does not have waypoints.";
+      return false;
+    }
+  }
+
+  // The cost between the starts and between the goals of all sweeps of the
+  // cluster, computed once in parallel if the kernel is thread-safe.
+  // front_front[i * num_nodes + j]: cost from start i to start j.
+  // back_back[i * num_nodes + j]: cost from goal i to goal j.
+  const double kInfinity = std::numeric_limits<double>::max();
+  std::vector<double> front_front(num_nodes * num_nodes, kInfinity);
+  std::vector<double> back_back(num_nodes * num_nodes, kInfinity);
+  num_threads = polygon_coverage_planning::getKernelThreads(num_threads);
+  parallelFor(num_nodes * num_nodes, num_threads, [&](size_t k) {
+    const size_t i = k / num_nodes;
+    const size_t j = k % num_nodes;
+    if (i == j) {
+      front_front[k] = back_back[k] = 0.0;
+      return;
+    }
+    const NodeProperty& from = (*node_properties)[i];
+    const NodeProperty& to = (*node_properties)[j];
+    std::vector<Point_2> path;
+    if (visibility_graph_.solve(from.visibility_queries.front(),
+                                to.visibility_queries.front(), &path)) {
+      front_front[k] = cost_function_(path);
+    }
+    if (visibility_graph_.solve(from.visibility_queries.back(),
+                                to.visibility_queries.back(), &path)) {
+      back_back[k] = cost_function_(path);
+    }
+  });
+
+  // Sweep i is non-optimal if going from its start to the start of sweep j,
+  // executing sweep j and going from the goal of sweep j to the goal of sweep i
+  // is cheaper than sweep i. All sweeps are compared to the unpruned set.
+  std::vector<char> is_non_optimal(num_nodes, false);
+  for (size_t i = 0; i < num_nodes; ++i) {
+    const double cost = (*node_properties)[i].cost;
+    for (size_t j = 0; j < num_nodes && !is_non_optimal[i]; ++j) {
+      const double to_j = front_front[i * num_nodes + j];
+      const double from_j = back_back[j * num_nodes + i];
+      if (i == j || to_j == kInfinity || from_j == kInfinity) {
+        continue;
       }
+      is_non_optimal[i] = to_j + (*node_properties)[j].cost + from_j < cost;
     }
-    timer_edge_creation.Stop();
   }
 
-  LOG(INFO) << "Created sweep plan graph with " << graph_.size()
-            << " nodes and " << edge_properties_.size() << " edges.";
-  LOG(INFO) << "Pruned " << num_sweep_plans - graph_.size() << " nodes.";
-  is_created_ = true;
+  size_t num_remaining = 0;
+  for (size_t i = 0; i < num_nodes; ++i) {
+    if (!is_non_optimal[i]) {
+      if (num_remaining != i) {
+        (*node_properties)[num_remaining] = std::move((*node_properties)[i]);
+      }
+      ++num_remaining;
+    }
+  }
+  node_properties->resize(num_remaining);
+
+  statistics->num_sweeps += num_nodes;
+  statistics->num_pruned += num_nodes - num_remaining;
+  statistics->num_path_queries += 2 * num_nodes * (num_nodes - 1);
+  LOG(INFO) << "Pruned " << num_nodes - num_remaining << " of " << num_nodes
+            << " sweeps using " << 2 * num_nodes * (num_nodes - 1)
+            << " shortest path queries.";
   return true;
 }
 
@@ -162,15 +248,79 @@ bool SweepPlanGraph::createNodeProperty(size_t cluster,
   CHECK_NOTNULL(waypoints);
   CHECK_NOTNULL(node);
 
-  std::vector<Polygon> visibility_polygons;
-  if (!computeStartAndGoalVisibility(visibility_graph_.getPolygon(), waypoints,
-                                     &visibility_polygons)) {
+  std::vector<std::vector<Point_2>> sweeps({*waypoints});
+  std::vector<NodeProperty> nodes;
+  if (!createNodeProperties(cluster, &sweeps, &nodes)) {
+    return false;
+  }
+  *waypoints = sweeps.front();
+  *node = nodes.front();
+
+  return true;
+}
+
+bool SweepPlanGraph::createNodeProperties(
+    size_t cluster, std::vector<std::vector<Point_2>>* sweeps,
+    std::vector<NodeProperty>* nodes, size_t num_threads) const {
+  CHECK_NOTNULL(sweeps);
+  CHECK_NOTNULL(nodes);
+  nodes->clear();
+
+  // Collect the start and goal of every sweep. A closed sweep has one query.
+  const Polygon& polygon = visibility_graph_.getPolygon();
+  std::vector<Point_2> queries;
+  std::vector<size_t> num_queries(sweeps->size());
+  queries.reserve(2 * sweeps->size());
+  for (size_t i = 0; i < sweeps->size(); ++i) {
+    std::vector<Point_2>& sweep = (*sweeps)[i];
+    if (sweep.empty()) {
+      LOG(ERROR) << "Sweep is empty.";
+      return false;
+    }
+    if (sweep.front() == sweep.back()) {
+      projectIntoPolygon(polygon, &sweep.front());
+      sweep.back() = sweep.front();
+      num_queries[i] = 1;
+    } else {
+      projectIntoPolygon(polygon, &sweep.front());
+      projectIntoPolygon(polygon, &sweep.back());
+      num_queries[i] = 2;
+    }
+    queries.push_back(sweep.front());
+    if (num_queries[i] == 2) {
+      queries.push_back(sweep.back());
+    }
+  }
+
+  // Compute all visibility polygons in parallel.
+  std::vector<Polygon_2> visibility;
+  if (!visibility_graph_.computeVisibility(queries, &visibility,
+                                           num_threads)) {
     LOG(ERROR) << "Cannot compute start and goal visibility graph.";
     return false;
   }
 
-  *node =
-      NodeProperty(*waypoints, cost_function_, cluster, visibility_polygons);
+  nodes->resize(sweeps->size());
+  for (size_t i = 0, q = 0; i < sweeps->size(); q += num_queries[i++]) {
+    std::vector<Polygon> visibility_polygons;
+    for (size_t j = q; j < q + num_queries[i]; ++j) {
+      visibility_polygons.push_back(Polygon(visibility[j]));
+    }
+    NodeProperty& node = (*nodes)[i];
+    node = NodeProperty((*sweeps)[i], cost_function_, cluster,
+                        visibility_polygons);
+
+    // Connect start and goal to the visibility graph once for all queries.
+    node.visibility_queries.resize(num_queries[i]);
+    for (size_t j = 0; j < num_queries[i]; ++j) {
+      if (!visibility_graph_.createQueryNode(queries[q + j], visibility[q + j],
+                                             &node.visibility_queries[j])) {
+        LOG(ERROR) << "Cannot connect " << queries[q + j]
+                   << " to the visibility graph.";
+        return false;
+      }
+    }
+  }
 
   return true;
 }
@@ -181,6 +331,10 @@ bool SweepPlanGraph::addEdges() {
     return false;
   }
 
+  if (defer_edges_) {
+    return true;  // Added in bulk by addAllEdges.
+  }
+
   const size_t new_id = graph_.size() - 1;
   for (size_t adj_id = 0; adj_id < new_id; ++adj_id) {
     EdgeId forwards_edge_id(new_id, adj_id);
@@ -207,6 +361,47 @@ bool SweepPlanGraph::addEdges() {
   return true;
 }
 
+bool SweepPlanGraph::addAllEdges() {
+  // Collect all potential edges.
+  std::vector<EdgeId> edge_ids;
+  for (size_t from = 0; from < graph_.size(); ++from) {
+    for (size_t to = 0; to < graph_.size(); ++to) {
+      const EdgeId edge_id(from, to);
+      if (from != to && isConnected(edge_id)) {
+        edge_ids.push_back(edge_id);
+      }
+    }
+  }
+
+  // Compute the shortest paths in parallel. Every edge id writes its own
+  // table entry. The node properties are shared between the threads, i.e.,
+  // this needs a thread-safe kernel.
+  std::vector<EdgeProperty> edge_properties(edge_ids.size());
+  std::vector<double> costs(edge_ids.size(), -1.0);
+  const size_t num_threads = polygon_coverage_planning::getKernelThreads(0);
+  std::atomic<bool> success(true);
+  parallelFor(edge_ids.size(), num_threads, [&](size_t i) {
+    if (!success) {
+      return;
+    }
+    if (!computeEdge(edge_ids[i], &edge_properties[i]) ||
+        !computeCost(edge_ids[i], edge_properties[i], &costs[i])) {
+      success = false;
+    }
+  });
+  if (!success) {
+    LOG(ERROR) << "Cannot compute all sweep plan graph edges.";
+    return false;
+  }
+
+  for (size_t i = 0; i < edge_ids.size(); ++i) {
+    if (!addEdge(edge_ids[i], edge_properties[i], costs[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
 bool SweepPlanGraph::computeEdge(const EdgeId& edge_id,
                                  EdgeProperty* edge_property) const {
   CHECK_NOTNULL(edge_property);
@@ -220,16 +415,16 @@ bool SweepPlanGraph::computeEdge(const EdgeId& edge_id,
 
   // Calculate shortest path.
   if (from_node_property->waypoints.empty() ||
-      to_node_property->waypoints.empty()) {
+      to_node_property->waypoints.empty() ||
+      from_node_property->visibility_queries.empty() ||
+      to_node_property->visibility_queries.empty()) {
     LOG(ERROR) << "Waypoints in node property are empty.";
     return false;
   }
 
   std::vector<Point_2> shortest_path;
-  if (!visibility_graph_.solve(from_node_property->waypoints.back(),
-                               from_node_property->visibility_polygons.back(),
-                               to_node_property->waypoints.front(),
-                               to_node_property->visibility_polygons.front(),
+  if (!visibility_graph_.solve(from_node_property->visibility_queries.back(),
+                               to_node_property->visibility_queries.front(),
                                &shortest_path)) {
     LOG(ERROR) << "Cannot compute shortest path from "
                << from_node_property->waypoints.back() << " to "
@@ -272,7 +467,9 @@ bool SweepPlanGraph::isConnected(const EdgeId& edge_id) const {
 }
 
 bool SweepPlanGraph::solve(const Point_2& start, const Point_2& goal,
-                           std::vector<Point_2>* waypoints) const {
+                           std::vector<Point_2>* waypoints,
+                           const GtspSolver* gtsp_solver,
+                           GtspIncumbent* incumbent) const {
   CHECK_NOTNULL(waypoints);
   waypoints->clear();
 
@@ -283,39 +480,34 @@ bool SweepPlanGraph::solve(const Point_2& start, const Point_2& goal,
 
   // Create temporary copies to add start and goal.
   SweepPlanGraph temp_gtsp_graph = *this;
-
-  NodeProperty start_node, goal_node;
-  if (!createNodeProperty(polygon_clusters_.size(), start, &start_node) ||
-      !createNodeProperty(polygon_clusters_.size() + 1, goal, &goal_node)) {
-    return false;
-  }
-
-  if (!temp_gtsp_graph.addStartNode(start_node) ||
-      !temp_gtsp_graph.addGoalNode(goal_node)) {
-    LOG(ERROR) << "Cannot add start and goal.";
+  if (!temp_gtsp_graph.addStartAndGoal(start, goal)) {
     return false;
   }
-  const size_t goal_idx = temp_gtsp_graph.size() - 1;
-  const size_t start_idx = temp_gtsp_graph.size() - 2;
+  const size_t goal_idx = temp_gtsp_graph.getGoalIdx();
+  const size_t start_idx = temp_gtsp_graph.getStartIdx();
 
-  // Solve using GK MA.
+  // Solve the GTSPP as GTSP. The free edge from goal to start closes the
+  // cycle.
   std::vector<std::vector<int>> m = temp_gtsp_graph.getAdjacencyMatrix();
+  m[goal_idx][start_idx] = 0;
   std::vector<std::vector<int>> clusters;
   if (!temp_gtsp_graph.getClusters(&clusters)) {
     LOG(ERROR) << "Cannot get clusters.";
     return false;
   }
-  gk_ma::Task task(m, clusters);
-  gk_ma::GkMa& solver = gk_ma::GkMa::getInstance();
-  solver.setSolver(task);
+  // Default to GK MA.
+  static const gk_ma::GkMaSolver kGkMaSolver = gk_ma::GkMaSolver();
+  if (gtsp_solver == nullptr) {
+    gtsp_solver = &kGkMaSolver;
+  }
 
+  std::vector<int> solution_int;
   LOG(INFO) << "Start solving GTSP";
-  if (!solver.solve()) {
-    LOG(ERROR) << "GkMa solution failed.";
+  if (!gtsp_solver->solve(m, clusters, &solution_int, incumbent)) {
+    LOG(ERROR) << "GTSP solution failed.";
     return false;
   }
   LOG(INFO) << "Finished solving GTSP";
-  std::vector<int> solution_int = solver.getSolution();
   Solution solution(solution_int.size());
   std::copy(solution_int.begin(), solution_int.end(), solution.begin());
 
@@ -340,6 +532,22 @@ bool SweepPlanGraph::solve(const Point_2& start, const Point_2& goal,
   return true;
 }
 
+bool SweepPlanGraph::addStartAndGoal(const Point_2& start,
+                                     const Point_2& goal) {
+  NodeProperty start_node, goal_node;
+  if (!createNodeProperty(polygon_clusters_.size(), start, &start_node) ||
+      !createNodeProperty(polygon_clusters_.size() + 1, goal, &goal_node)) {
+    return false;
+  }
+
+  if (!addStartNode(start_node) || !addGoalNode(goal_node)) {
+    LOG(ERROR) << "Cannot add start and goal.";
+    return false;
+  }
+  freeze();
+  return true;
+}
+
 bool SweepPlanGraph::getWaypoints(const Solution& solution,
                                   std::vector<Point_2>* waypoints) const {
   CHECK_NOTNULL(waypoints);
@@ -373,40 +581,13 @@ bool SweepPlanGraph::getWaypoints(const Solution& solution,
   return true;
 }
 
-bool SweepPlanGraph::computeStartAndGoalVisibility(
-    const Polygon& polygon, std::vector<Point_2>* sweep,
-    std::vector<Polygon>* visibility_polygons) const {
-  CHECK_NOTNULL(sweep);
-  CHECK_NOTNULL(visibility_polygons);
-  visibility_polygons->resize(2);
-
-  if (sweep->front() == sweep->back()) {
-    visibility_polygons->resize(1);
-    if (!computeVisibility(polygon, &sweep->front(),
-                           &visibility_polygons->front())) {
-      return false;
-    } else {
-      sweep->back() = sweep->front();
-      return true;
-    }
-  } else {
-    visibility_polygons->resize(2);
-    return computeVisibility(polygon, &sweep->front(),
-                             &visibility_polygons->front()) &&
-           computeVisibility(polygon, &sweep->back(),
-                             &visibility_polygons->back());
-  }
-}
-
-bool SweepPlanGraph::computeVisibility(const Polygon& polygon, Point_2* vertex,
-                                       Polygon* visibility_polygon) const {
+void SweepPlanGraph::projectIntoPolygon(const Polygon& polygon,
+                                        Point_2* vertex) const {
   CHECK_NOTNULL(vertex);
-  CHECK_NOTNULL(visibility_polygon);
 
   *vertex = polygon.pointInPolygon(*vertex)
                 ? *vertex
                 : polygon.projectPointOnHull(*vertex);
-  return polygon.computeVisibilityPolygon(*vertex, visibility_polygon);
 }
 
 }  // namespace sweep_plan_graph
@@ -1,9 +1,9 @@
 #include "mav_2d_coverage_planning/planners/polygon_stripmap_planner.h"
-#include <CGAL/Boolean_set_operations_2.h>
 #include <glog/logging.h>
 #include <cmath>
 
 #include <mav_coverage_planning_comm/timing.h>
+#include <polygon_coverage_geometry/cgal_comm.h>
 
 namespace mav_coverage_planning {
 
@@ -15,10 +15,11 @@ bool PolygonStripmapPlanner::setup() {
 
   // Create decomposition.
   timing::Timer timer_decom("decomposition");
+  std::vector<std::set<size_t>> adjacency;
   switch (settings_.decomposition_type) {
     case DecompositionType::kBoustrophedeon: {
       if (!settings_.polygon.computeBestBCDFromPolygonWithHoles(
-              &decomposition_)) {
+              &decomposition_, 0, &adjacency)) {
         LOG(ERROR) << "Cannot compute boustrophedeon decomposition.";
         is_initialized_ = false;
       } else {
@@ -47,8 +48,13 @@ bool PolygonStripmapPlanner::setup() {
   }
   timer_decom.Stop();
 
+  // The BCD sweep reports the cell adjacency. Other decompositions are
+  // checked for shared boundary segments.
   timing::Timer timer_poly_adj("polygon_adjacency");
-  if (!updateDecompositionAdjacency()) {
+  const bool is_connected = adjacency.size() == decomposition_.size()
+                                ? updateDecompositionAdjacency(adjacency)
+                                : updateDecompositionAdjacency();
+  if (!is_connected) {
     LOG(ERROR) << "Decomposition not fully connected.";
     is_initialized_ = false;
   }
@@ -86,15 +92,22 @@ bool PolygonStripmapPlanner::setup() {
 }
 
 bool PolygonStripmapPlanner::updateDecompositionAdjacency() {
-  for (size_t i = 0; i < decomposition_.size() - 1; ++i) {
-    for (size_t j = i + 1; j < decomposition_.size(); ++j) {
-      PolygonWithHoles joined;
-      if (CGAL::join(decomposition_[i].getPolygon(),
-                     decomposition_[j].getPolygon(), joined)) {
-        decomposition_adjacency_[i].emplace(j);
-        decomposition_adjacency_[j].emplace(i);
-      }
-    }
+  // Cells are adjacent if they share a boundary segment.
+  std::vector<Polygon_2> cells(decomposition_.size());
+  for (size_t i = 0; i < decomposition_.size(); ++i) {
+    cells[i] = decomposition_[i].getPolygon().outer_boundary();
+  }
+  std::vector<std::set<size_t>> adjacency;
+  polygon_coverage_planning::computeCellAdjacency(cells, &adjacency);
+  return updateDecompositionAdjacency(adjacency);
+}
+
+bool PolygonStripmapPlanner::updateDecompositionAdjacency(
+    const std::vector<std::set<size_t>>& adjacency) {
+  CHECK_EQ(adjacency.size(), decomposition_.size());
+  decomposition_adjacency_.clear();
+  for (size_t i = 0; i < adjacency.size(); ++i) {
+    if (!adjacency[i].empty()) decomposition_adjacency_[i] = adjacency[i];
   }
 
   // Check connectivity.
@@ -116,12 +129,6 @@ bool PolygonStripmapPlanner::offsetDecomposition() {
          it != decomposition_adjacency_[i].end(); it++) {
       const Polygon_2& cell = decomposition_[i].getPolygon().outer_boundary();
       const size_t num_edges_cell = cell.size();
-      // If they do not touch anymore, skip.
-      PolygonWithHoles joined;
-      if (!CGAL::join(decomposition_[i].getPolygon(),
-                      decomposition_[*it].getPolygon(), joined))
-        continue;
-
       const Polygon_2& neighbor =
           decomposition_[*it].getPolygon().outer_boundary();
       const size_t num_edges_neighbor = neighbor.size();
@@ -134,6 +141,9 @@ bool PolygonStripmapPlanner::offsetDecomposition() {
           if (std::find(offsetted_segments.begin(), offsetted_segments.end(),
                         neighbor.edge(neighbor_e)) != offsetted_segments.end())
             continue;  // Already offsetted this segment.
+          if (!CGAL::do_overlap(cell.edge(cell_e).bbox(),
+                                neighbor.edge(neighbor_e).bbox()))
+            continue;
           // If segments intersect, offset polygon.
           CGAL::cpp11::result_of<Intersect_2(Segment_2, Segment_2)>::type
               result = CGAL::intersection(cell.edge(cell_e),
@@ -184,7 +194,8 @@ bool PolygonStripmapPlanner::offsetDecomposition() {
 }
 
 bool PolygonStripmapPlanner::solve(const Point_2& start, const Point_2& goal,
-                                   std::vector<Point_2>* solution) const {
+                                   std::vector<Point_2>* solution,
+                                   GtspIncumbent* incumbent) const {
   timing::Timer timer_solve("solve");
   CHECK_NOTNULL(solution);
   solution->clear();
@@ -203,7 +214,7 @@ bool PolygonStripmapPlanner::solve(const Point_2& start, const Point_2& goal,
                                ? goal
                                : settings_.polygon.projectPointOnHull(goal);
 
-  if (!runSolver(start_new, goal_new, solution)) {
+  if (!runSolver(start_new, goal_new, solution, incumbent)) {
     LOG(ERROR) << "Failed solving graph.";
     return false;
   }
@@ -258,11 +269,14 @@ bool PolygonStripmapPlanner::sweepAroundObstacles(
 
 bool PolygonStripmapPlanner::runSolver(const Point_2& start,
                                        const Point_2& goal,
-                                       std::vector<Point_2>* solution) const {
+                                       std::vector<Point_2>* solution,
+                                       GtspIncumbent* incumbent) const {
   CHECK_NOTNULL(solution);
 
-  LOG(INFO) << "Start solving GTSP using GK MA.";
-  return sweep_plan_graph_.solve(start, goal, solution);
+  LOG(INFO) << "Start solving GTSP using "
+            << (settings_.gtsp_solver ? "native solver." : "GK MA.");
+  return sweep_plan_graph_.solve(start, goal, solution,
+                                 settings_.gtsp_solver.get(), incumbent);
 }
 
 }  // namespace mav_coverage_planning
@@ -16,6 +16,8 @@ bool PolygonStripmapPlannerExact::setupSolver() {
   LOG(INFO) << "Initializing product graph.";
   gtspp_product_graph_ = gtspp_product_graph::GtsppProductGraph(
       &sweep_plan_graph_, &boolean_lattice_);
+  gtspp_product_graph_.setUseAStar(use_astar_);
+  gtspp_product_graph_.setBudget(budget_);
 
   return preprocess();
 }
@@ -31,12 +33,13 @@ bool PolygonStripmapPlannerExact::preprocess() {
 
 
 bool PolygonStripmapPlannerExact::runSolver(
-    const Point_2& start, const Point_2& goal,
-    std::vector<Point_2>* solution) const {
+    const Point_2& start, const Point_2& goal, std::vector<Point_2>* solution,
+    GtspIncumbent* incumbent) const {
   CHECK_NOTNULL(solution);
 
   LOG(INFO) << "Start solving GTSP using exact solver without preprocessing.";
-  return gtspp_product_graph_.solveOnline(start, goal, solution);
+  return gtspp_product_graph_.solveOnline(start, goal, solution, nullptr,
+                                          incumbent);
 }
 
 }  // namespace mav_coverage_planning
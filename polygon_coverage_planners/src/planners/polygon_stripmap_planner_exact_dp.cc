@@ -0,0 +1,67 @@
+#include "mav_2d_coverage_planning/planners/polygon_stripmap_planner_exact_dp.h"
+
+#include <glog/logging.h>
+#include <cmath>
+#include <limits>
+
+#include <mav_coverage_graph_solvers/held_karp.h>
+
+namespace mav_coverage_planning {
+
+bool PolygonStripmapPlannerExactDp::runSolver(
+    const Point_2& start, const Point_2& goal, std::vector<Point_2>* solution,
+    GtspIncumbent* incumbent) const {
+  CHECK_NOTNULL(solution);
+
+  // Create temporary copy to add start and goal.
+  sweep_plan_graph::SweepPlanGraph temp_sweep_plan_graph = sweep_plan_graph_;
+  if (!temp_sweep_plan_graph.addStartAndGoal(start, goal)) {
+    return false;
+  }
+
+  // Dense cost matrix.
+  const size_t num_nodes = temp_sweep_plan_graph.size();
+  std::vector<std::vector<double>> cost(
+      num_nodes,
+      std::vector<double>(num_nodes, std::numeric_limits<double>::max()));
+  for (size_t i = 0; i < num_nodes; ++i) {
+    temp_sweep_plan_graph.forEachNeighbor(i, [&cost, i](size_t j, double c) {
+      cost[i][j] = c;
+      return true;
+    });
+  }
+
+  // Clusters without start and goal cluster.
+  std::vector<std::vector<int>> clusters_int;
+  if (!temp_sweep_plan_graph.getClusters(&clusters_int)) {
+    LOG(ERROR) << "Cannot get clusters.";
+    return false;
+  }
+  std::vector<std::vector<size_t>> clusters(
+      temp_sweep_plan_graph.getNumClusters());
+  for (size_t i = 0; i < clusters.size(); ++i) {
+    clusters[i].assign(clusters_int[i].begin(), clusters_int[i].end());
+  }
+
+  LOG(INFO) << "Start solving GTSP using exact dynamic program.";
+  Solution dp_solution;
+  HeldKarp held_karp(num_threads_);
+  if (!held_karp.solve(cost, clusters, temp_sweep_plan_graph.getStartIdx(),
+                       temp_sweep_plan_graph.getGoalIdx(), &dp_solution)) {
+    LOG(ERROR) << "Dynamic program failed.";
+    return false;
+  }
+  // The dynamic program runs to completion. Report the optimum.
+  if (incumbent) {
+    double tour_cost = 0.0;
+    for (size_t i = 0; i + 1 < dp_solution.size(); ++i) {
+      tour_cost += cost[dp_solution[i]][dp_solution[i + 1]];
+    }
+    incumbent->update(std::vector<int>(dp_solution.begin(), dp_solution.end()),
+                      static_cast<int64_t>(std::round(tour_cost * kToMilli)));
+  }
+
+  return temp_sweep_plan_graph.getWaypoints(dp_solution, solution);
+}
+
+}  // namespace mav_coverage_planning
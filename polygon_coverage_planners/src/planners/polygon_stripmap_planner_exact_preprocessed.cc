@@ -14,12 +14,12 @@ bool PolygonStripmapPlannerExactPreprocessed::preprocess() {
 }
 
 bool PolygonStripmapPlannerExactPreprocessed::runSolver(
-    const Point_2& start, const Point_2& goal,
-    std::vector<Point_2>* solution) const {
+    const Point_2& start, const Point_2& goal, std::vector<Point_2>* solution,
+    GtspIncumbent* incumbent) const {
   CHECK_NOTNULL(solution);
 
   LOG(INFO) << "Start solving GTSP using exact solver with preprocessing.";
-  return gtspp_product_graph_.solve(start, goal, solution);
+  return gtspp_product_graph_.solve(start, goal, solution, incumbent);
 }
 
 }  // namespace mav_coverage_planning
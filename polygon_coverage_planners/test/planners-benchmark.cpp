@@ -0,0 +1,96 @@
+#include <cstdlib>
+#include <iostream>
+
+#include <CGAL/Random.h>
+#include <glog/logging.h>
+
+#include "mav_2d_coverage_planning/cost_functions/path_cost_functions.h"
+#include "mav_2d_coverage_planning/planners/polygon_stripmap_planner_exact.h"
+#include "mav_2d_coverage_planning/geometry/polygon.h"
+#include "mav_2d_coverage_planning/tests/test_helpers.h"
+#include "mav_2d_coverage_planning/sensor_models/frustum.h"
+
+using namespace mav_coverage_planning;
+
+// Prints the number of product graph nodes that Dijkstra and A* search expand
+// on random polygons.
+
+const double kPolygonDiameterMin = 20.0;
+const double kPolygonDiameterMax = 100.0;
+const double kAltitudeMin = 0.5;
+const double kAltitudeMax = 30.0;
+const double kFOVCameraRadMin = M_PI / 12.0;
+const double kFOVCameraRadMax = M_PI - 0.1;
+const double kMinViewOverlapMin = 0.0;
+const double kMinViewOverlapMax = 0.99;
+const int kNumPolygons = 1e2;
+const int kMaxPolySize = 10;
+const size_t kSeed = 123456;
+
+// Exposes the product graph to compare the number of expanded nodes.
+class PlannerExactExpansions : public PolygonStripmapPlannerExact {
+ public:
+  PlannerExactExpansions(const Settings& settings)
+      : PolygonStripmapPlannerExact(settings) {}
+
+  bool solve(const Point_2& start, const Point_2& goal, bool use_astar,
+             std::vector<Point_2>* waypoints, size_t* num_expanded) const {
+    gtspp_product_graph::GtsppProductGraph product_graph =
+        gtspp_product_graph_;
+    product_graph.setUseAStar(use_astar);
+    return product_graph.solveOnline(start, goal, waypoints, num_expanded);
+  }
+};
+
+int main(int argc, char** argv) {
+  google::InitGoogleLogging(argv[0]);
+  CGAL::Random random(kSeed);
+  std::srand(kSeed);
+  size_t num_expanded_dijkstra = 0;
+  size_t num_expanded_astar = 0;
+
+  std::cout << "polygon, vertices, dijkstra, astar" << std::endl;
+  for (int i = 0; i < kNumPolygons; i++) {
+    double r =
+        createRandomDouble(kPolygonDiameterMin, kPolygonDiameterMax) / 2.0;
+    Polygon polygon(
+        createRandomSimplePolygon<Polygon_2, K>(r, random, kMaxPolySize));
+    if (polygon.getPolygon().outer_boundary().size() <= 2) continue;
+
+    PolygonStripmapPlanner::Settings settings;
+    settings.polygon = polygon;
+    settings.offset_polygons = true;
+    settings.decomposition_type = DecompositionType::kBoustrophedeon;
+    settings.path_cost_function =
+        std::bind(&computeEuclideanPathCost, std::placeholders::_1);
+    settings.sensor_model = std::make_shared<Frustum>(
+        createRandomDouble(kAltitudeMin, kAltitudeMax),
+        createRandomDouble(kFOVCameraRadMin, kFOVCameraRadMax),
+        createRandomDouble(kMinViewOverlapMin, kMinViewOverlapMax));
+    PlannerExactExpansions planner(settings);
+    if (!planner.setup()) {
+      LOG(ERROR) << "Failed to set up planner for polygon " << i << ".";
+      continue;
+    }
+
+    const Point_2 start(CGAL::ORIGIN);
+    const Point_2 goal(CGAL::ORIGIN);
+    std::vector<Point_2> waypoints;
+    size_t expanded_dijkstra = 0, expanded_astar = 0;
+    if (!planner.solve(start, goal, false, &waypoints, &expanded_dijkstra) ||
+        !planner.solve(start, goal, true, &waypoints, &expanded_astar)) {
+      LOG(ERROR) << "Failed to solve polygon " << i << ".";
+      continue;
+    }
+    std::cout << i << ", " << polygon.getPolygon().outer_boundary().size()
+              << ", " << expanded_dijkstra << ", " << expanded_astar
+              << std::endl;
+    num_expanded_dijkstra += expanded_dijkstra;
+    num_expanded_astar += expanded_astar;
+  }
+
+  std::cout << "Expanded product graph nodes. Dijkstra: "
+            << num_expanded_dijkstra << ", A*: " << num_expanded_astar
+            << std::endl;
+  return 0;
+}
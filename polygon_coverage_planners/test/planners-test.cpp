@@ -2,10 +2,13 @@
 
 #include <gtest/gtest.h>
 #include <CGAL/Random.h>
+#include <mav_coverage_graph_solvers/exact_gtsp_solver.h>
+#include <mav_coverage_graph_solvers/memetic_gtsp_solver.h>
 
 #include "mav_2d_coverage_planning/cost_functions/path_cost_functions.h"
 #include "mav_2d_coverage_planning/planners/polygon_stripmap_planner.h"
 #include "mav_2d_coverage_planning/planners/polygon_stripmap_planner_exact.h"
+#include "mav_2d_coverage_planning/planners/polygon_stripmap_planner_exact_dp.h"
 #include "mav_2d_coverage_planning/planners/polygon_stripmap_planner_exact_preprocessed.h"
 #include "mav_2d_coverage_planning/geometry/polygon.h"
 #include "mav_2d_coverage_planning/tests/test_helpers.h"
@@ -27,6 +30,21 @@ const int kNumPolygons = 1e2;
 const size_t kSeed = 123456;
 const double kNear = 1e-3;
 
+// Exposes the product graph to compare the number of expanded nodes.
+class PlannerExactExpansions : public PolygonStripmapPlannerExact {
+ public:
+  PlannerExactExpansions(const Settings& settings)
+      : PolygonStripmapPlannerExact(settings) {}
+
+  bool solve(const Point_2& start, const Point_2& goal, bool use_astar,
+             std::vector<Point_2>* waypoints, size_t* num_expanded) const {
+    gtspp_product_graph::GtsppProductGraph product_graph =
+        gtspp_product_graph_;
+    product_graph.setUseAStar(use_astar);
+    return product_graph.solveOnline(start, goal, waypoints, num_expanded);
+  }
+};
+
 // Given a set of polygons run all planners.
 void runPlanners(const std::vector<Polygon>& polygons) {
   for (const Polygon& p : polygons) {
@@ -46,30 +64,72 @@ void runPlanners(const std::vector<Polygon>& polygons) {
 
     // Create planners.
     PolygonStripmapPlanner planner_gk_ma(settings);
+    PolygonStripmapPlanner::Settings settings_memetic = settings;
+    settings_memetic.gtsp_solver = std::make_shared<MemeticGtspSolver>();
+    PolygonStripmapPlanner planner_memetic(settings_memetic);
+    PolygonStripmapPlanner::Settings settings_exact_gtsp = settings;
+    settings_exact_gtsp.gtsp_solver = std::make_shared<ExactGtspSolver>();
+    PolygonStripmapPlanner planner_exact_gtsp(settings_exact_gtsp);
+    PolygonStripmapPlanner::Settings settings_product_graph = settings;
+    settings_product_graph.gtsp_solver =
+        std::make_shared<gtspp_product_graph::GtsppProductGraphSolver>(true);
+    PolygonStripmapPlanner planner_product_graph(settings_product_graph);
+    // Anytime: returns the greedily completed best partial solution.
+    PolygonStripmapPlannerExact planner_exact_budget(settings);
+    planner_exact_budget.setBudget(GtspBudget(0.0));
     PolygonStripmapPlannerExact planner_exact(settings);
     PolygonStripmapPlannerExactPreprocessed planner_exact_preprocessed(
         settings);
+    PolygonStripmapPlannerExactDp planner_exact_dp(settings);
+    PolygonStripmapPlannerExactPreprocessed planner_exact_astar(settings,
+                                                                true);
 
     EXPECT_TRUE(planner_gk_ma.setup());
+    EXPECT_TRUE(planner_memetic.setup());
+    EXPECT_TRUE(planner_exact_gtsp.setup());
+    EXPECT_TRUE(planner_product_graph.setup());
+    EXPECT_TRUE(planner_exact_budget.setup());
     EXPECT_TRUE(planner_exact.setup());
     EXPECT_TRUE(planner_exact_preprocessed.setup());
+    EXPECT_TRUE(planner_exact_dp.setup());
+    EXPECT_TRUE(planner_exact_astar.setup());
     EXPECT_TRUE(planner_gk_ma.isInitialized());
+    EXPECT_TRUE(planner_memetic.isInitialized());
+    EXPECT_TRUE(planner_exact_gtsp.isInitialized());
+    EXPECT_TRUE(planner_product_graph.isInitialized());
+    EXPECT_TRUE(planner_exact_budget.isInitialized());
     EXPECT_TRUE(planner_exact.isInitialized());
     EXPECT_TRUE(planner_exact_preprocessed.isInitialized());
+    EXPECT_TRUE(planner_exact_dp.isInitialized());
+    EXPECT_TRUE(planner_exact_astar.isInitialized());
 
-    std::vector<Point_2> waypoints_gk_ma, waypoints_exact,
-        waypoints_exact_preprocessed;
+    std::vector<Point_2> waypoints_gk_ma, waypoints_memetic,
+        waypoints_exact_gtsp, waypoints_exact,
+        waypoints_exact_preprocessed, waypoints_exact_dp, waypoints_exact_astar,
+        waypoints_product_graph, waypoints_exact_budget;
     Point_2 start = Point_2(CGAL::ORIGIN);
     Point_2 goal = Point_2(CGAL::ORIGIN);
 
     EXPECT_TRUE(planner_gk_ma.solve(start, goal, &waypoints_gk_ma));
+    EXPECT_TRUE(planner_memetic.solve(start, goal, &waypoints_memetic));
+    EXPECT_TRUE(
+        planner_exact_gtsp.solve(start, goal, &waypoints_exact_gtsp));
+    EXPECT_TRUE(
+        planner_product_graph.solve(start, goal, &waypoints_product_graph));
+    EXPECT_TRUE(
+        planner_exact_budget.solve(start, goal, &waypoints_exact_budget));
     EXPECT_TRUE(planner_exact.solve(start, goal, &waypoints_exact));
     EXPECT_TRUE(planner_exact_preprocessed.solve(
         start, goal, &waypoints_exact_preprocessed));
+    EXPECT_TRUE(planner_exact_dp.solve(start, goal, &waypoints_exact_dp));
+    EXPECT_TRUE(
+        planner_exact_astar.solve(start, goal, &waypoints_exact_astar));
 
     EXPECT_LT(2, waypoints_gk_ma.size());
+    EXPECT_LT(2, waypoints_memetic.size());
     EXPECT_LT(2, waypoints_exact.size());
     EXPECT_LT(2, waypoints_exact_preprocessed.size());
+    EXPECT_LT(2, waypoints_exact_dp.size());
 
     // Start and goal may lie outside of polygon.
     EXPECT_TRUE(settings.polygon.pointsInPolygon(
@@ -82,8 +142,21 @@ void runPlanners(const std::vector<Polygon>& polygons) {
 
     EXPECT_EQ(settings.path_cost_function(waypoints_exact),
               settings.path_cost_function(waypoints_exact_preprocessed));
+    EXPECT_NEAR(settings.path_cost_function(waypoints_exact),
+                settings.path_cost_function(waypoints_exact_dp), kNear);
+    EXPECT_NEAR(settings.path_cost_function(waypoints_exact),
+                settings.path_cost_function(waypoints_exact_astar), kNear);
     EXPECT_NEAR(settings.path_cost_function(waypoints_gk_ma),
                 settings.path_cost_function(waypoints_exact), kNear);
+    EXPECT_NEAR(settings.path_cost_function(waypoints_memetic),
+                settings.path_cost_function(waypoints_exact), kNear);
+    EXPECT_NEAR(settings.path_cost_function(waypoints_exact_gtsp),
+                settings.path_cost_function(waypoints_exact), kNear);
+    EXPECT_NEAR(settings.path_cost_function(waypoints_product_graph),
+                settings.path_cost_function(waypoints_exact), kNear);
+    EXPECT_LT(2, waypoints_exact_budget.size());
+    EXPECT_GE(settings.path_cost_function(waypoints_exact_budget),
+              settings.path_cost_function(waypoints_exact) - kNear);
   }
 }
 
@@ -120,6 +193,54 @@ TEST(StripmapPlannerTest, RandomSimplePolygon) {
   runPlanners(polygons);
 }
 
+TEST(StripmapPlannerTest, AStarExpansions) {
+  CGAL::Random random(kSeed);
+  std::srand(kSeed);
+  size_t num_expanded_dijkstra = 0;
+  size_t num_expanded_astar = 0;
+
+  for (size_t i = 0; i < kNumPolygons; i++) {
+    double r =
+        createRandomDouble(kPolygonDiameterMin, kPolygonDiameterMax) / 2.0;
+    const int kMaxPolySize = 10;
+    Polygon polygon(
+        createRandomSimplePolygon<Polygon_2, K>(r, random, kMaxPolySize));
+    if (polygon.getPolygon().outer_boundary().size() <= 2) continue;
+
+    PolygonStripmapPlanner::Settings settings;
+    settings.polygon = polygon;
+    settings.offset_polygons = true;
+    settings.decomposition_type = DecompositionType::kBoustrophedeon;
+    settings.path_cost_function =
+        std::bind(&computeEuclideanPathCost, std::placeholders::_1);
+    settings.sensor_model = std::make_shared<Frustum>(
+        createRandomDouble(kAltitudeMin, kAltitudeMax),
+        createRandomDouble(kFOVCameraRadMin, kFOVCameraRadMax),
+        createRandomDouble(kMinViewOverlapMin, kMinViewOverlapMax));
+    PlannerExactExpansions planner(settings);
+    ASSERT_TRUE(planner.setup());
+
+    const Point_2 start(CGAL::ORIGIN);
+    const Point_2 goal(CGAL::ORIGIN);
+    std::vector<Point_2> waypoints_dijkstra, waypoints_astar;
+    size_t expanded_dijkstra = 0, expanded_astar = 0;
+    ASSERT_TRUE(planner.solve(start, goal, false, &waypoints_dijkstra,
+                              &expanded_dijkstra));
+    ASSERT_TRUE(
+        planner.solve(start, goal, true, &waypoints_astar, &expanded_astar));
+    EXPECT_NEAR(computeEuclideanPathCost(waypoints_dijkstra),
+                computeEuclideanPathCost(waypoints_astar), kNear);
+    // Both searches at least expand the start and the goal.
+    EXPECT_GE(expanded_dijkstra, 2);
+    EXPECT_GE(expanded_astar, 2);
+    num_expanded_dijkstra += expanded_dijkstra;
+    num_expanded_astar += expanded_astar;
+  }
+
+  EXPECT_GT(num_expanded_astar, 0);
+  EXPECT_LE(num_expanded_astar, num_expanded_dijkstra);
+}
+
 int main(int argc, char** argv) {
   testing::InitGoogleTest(&argc, argv);
   google::InitGoogleLogging(argv[0]);
@@ -1,23 +1,16 @@
 #ifndef POLYGON_COVERAGE_SOLVERS_BOOLEAN_LATTICE_H_
 #define POLYGON_COVERAGE_SOLVERS_BOOLEAN_LATTICE_H_
 
-#include <set>
+#include <cstdint>
+#include <limits>
+#include <vector>
 
 #include "polygon_coverage_solvers/graph_base.h"
 
 namespace polygon_coverage_planning {
 namespace boolean_lattice {
-// Internal node property. Stores the set of visited clusters.
-struct NodeProperty {
-  NodeProperty() {}
-  NodeProperty(const std::set<size_t>& visited_clusters)
-      : visited_clusters(visited_clusters) {}
-  std::set<size_t> visited_clusters;
-  inline bool includesCluster(size_t cluster) const {
-    return visited_clusters.count(cluster) > 0;
-  }
-};
-struct EdgeProperty {};
+// A set of visited clusters encoded as bitmask.
+typedef uint64_t ClusterMask;
 
 // A boolean lattice stores the sets of already visited clusters / polygons. The
 // sets are connected in a directed graph with zero edge cost. It starts off
@@ -26,49 +19,95 @@ struct EdgeProperty {};
 // https://en.wiktionary.org/wiki/Boolean_lattice and
 // M. Rice, V. Tsotras, "Exact Graph Search Algorithms for Generalized
 // Traveling Salesman Path Problems"
-class BooleanLattice : public GraphBase<NodeProperty, EdgeProperty> {
+//
+// The lattice is implicit. The node id of a regular node is the bitmask of its
+// visited clusters, i.e., ids [0 .. 2^n-1]. A node is connected to all nodes
+// that set exactly one more bit. No adjacency is stored.
+// The start node has id 2^n and visits no cluster. Once it is added, all
+// regular nodes additionally include the start cluster and the start node is
+// connected to the regular node 0.
+// The goal node has id 2^n+1 and visits all clusters including start and goal
+// cluster. It is connected from the regular node 2^n-1.
+class BooleanLattice {
  public:
+  // The maximum number of clusters excluding start and goal cluster.
+  static const size_t kMaxNumClusters = 62;
+
   // num_polygons: Number of polygons to visit, excluding start and goal
   // cluster.
   BooleanLattice(size_t num_clusters)
-      : GraphBase(),
+      : num_original_clusters_(num_clusters),
         num_clusters_(num_clusters),
         start_cluster_(0),
-        goal_cluster_(0) {
-    sorted_original_clusters_.resize(num_clusters_);
-    std::iota(sorted_original_clusters_.begin(),
-              sorted_original_clusters_.end(), 0);
-    is_created_ = create(); // Auto-create.
+        goal_cluster_(0),
+        start_idx_(std::numeric_limits<size_t>::max()),
+        goal_idx_(std::numeric_limits<size_t>::max()),
+        is_created_(false) {
+    is_created_ = create();  // Auto-create.
   }
-  BooleanLattice() : GraphBase() {}
+  BooleanLattice() : BooleanLattice(0) { is_created_ = false; }
 
-  virtual void clear() override;
+  void clear();
   // Create a boolean lattice with num_clusters_ possible clusters.
-  virtual bool create() override;
-  virtual bool addStartNode(const NodeProperty& node_property)
-      override;  // To be called after create().
-  // Convenience method as NodeProperty argument is ignored anyways.
+  bool create();
+  // To be called after create().
   bool addStartNode();
-  virtual bool addGoalNode(const NodeProperty& node_property)
-      override;  // To be called after create().
-  // Convenience method as NodeProperty argument is ignored anyways.
+  // To be called after create().
   bool addGoalNode();
 
+  inline bool isInitialized() const { return is_created_; }
+  inline size_t size() const {
+    return getNumRegularNodes() + hasStartNode() + hasGoalNode();
+  }
+  inline size_t getStartIdx() const { return start_idx_; }
+  inline size_t getGoalIdx() const { return goal_idx_; }
   inline size_t getStartCluster() const { return start_cluster_; }
   inline size_t getGoalCluster() const { return goal_cluster_; }
+  // Number of clusters excluding start and goal.
+  inline size_t getNumOriginalClusters() const {
+    return num_original_clusters_;
+  }
+  // Number of regular nodes, i.e., 2^n.
+  inline size_t getNumRegularNodes() const {
+    return static_cast<size_t>(1) << num_original_clusters_;
+  }
+  inline bool isRegularNode(size_t node_id) const {
+    return node_id < getNumRegularNodes();
+  }
 
- private:
-  virtual bool addEdges() override;
+  inline bool nodeExists(size_t node_id) const {
+    return isRegularNode(node_id) ||
+           (hasStartNode() && node_id == start_idx_) ||
+           (hasGoalNode() && node_id == goal_idx_);
+  }
+  // Whether the visited set of node_id includes cluster.
+  bool includesCluster(size_t node_id, size_t cluster) const;
+  // Whether node_id visits exactly one more cluster than its predecessor.
+  bool edgeExists(const EdgeId& edge_id) const;
+  bool getEdgeCost(const EdgeId& edge_id, double* cost) const;
+  // All nodes that visit exactly one more cluster.
+  void getSuccessors(size_t node_id, std::vector<size_t>* successors) const;
+  // The successor that additionally visits cluster. Returns max if it does not
+  // exist.
+  size_t getSuccessor(size_t node_id, size_t cluster) const;
 
-  // A node is predecessor of another node, if
-  // - the node contains one combination element less than the other AND
-  // - the node combination is a subset of the other node
-  bool isConnected(const EdgeId& edge_id);
+ private:
+  inline bool hasStartNode() const {
+    return start_idx_ != std::numeric_limits<size_t>::max();
+  }
+  inline bool hasGoalNode() const {
+    return goal_idx_ != std::numeric_limits<size_t>::max();
+  }
+  // The regular node that visits all original clusters.
+  inline size_t getFullNode() const { return getNumRegularNodes() - 1; }
 
-  std::vector<size_t> sorted_original_clusters_; // E.g., [0, 1, 2, ..., n-1].
+  size_t num_original_clusters_;  // Number of clusters without start and goal.
   size_t num_clusters_;   // Total number of clusters including start and goal.
   size_t start_cluster_;  // Unique start cluster.
   size_t goal_cluster_;   // Unique goal cluster.
+  size_t start_idx_;
+  size_t goal_idx_;
+  bool is_created_;
 };
 }  // namespace boolean_lattice
 }  // namespace polygon_coverage_planning
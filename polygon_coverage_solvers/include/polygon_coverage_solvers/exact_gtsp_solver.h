@@ -0,0 +1,33 @@
+#ifndef POLYGON_COVERAGE_SOLVERS_EXACT_GTSP_SOLVER_H_
+#define POLYGON_COVERAGE_SOLVERS_EXACT_GTSP_SOLVER_H_
+
+#include <vector>
+
+#include "polygon_coverage_solvers/gtsp_solver.h"
+#include "polygon_coverage_solvers/held_karp.h"
+
+namespace polygon_coverage_planning {
+
+// Exact GTSP solver. Every cycle passes one node s of the smallest cluster.
+// For every s, the cheapest path from s back to s through all other clusters
+// is found with the Held-Karp dynamic program. The deadline is checked between
+// two start nodes; the best cycle so far is returned when it expires.
+// Supports at most HeldKarp::kMaxNumClusters + 1 clusters.
+class ExactGtspSolver : public GtspSolver {
+ public:
+  // num_threads: 0 uses all hardware threads.
+  ExactGtspSolver(size_t num_threads = 0) : held_karp_(num_threads) {}
+
+ protected:
+  bool solveTask(const std::vector<std::vector<int>>& m,
+                 const std::vector<std::vector<int>>& clusters,
+                 const Clock::time_point& deadline, std::vector<int>* solution,
+                 GtspIncumbent* incumbent) const override;
+
+ private:
+  HeldKarp held_karp_;
+};
+
+}  // namespace polygon_coverage_planning
+
+#endif  // POLYGON_COVERAGE_SOLVERS_EXACT_GTSP_SOLVER_H_
@@ -6,6 +6,8 @@
 
 #include <mono/metadata/object.h>
 
+#include "polygon_coverage_solvers/gtsp_solver.h"
+
 // Interfaces with the GK MA GTSP solver.
 namespace polygon_coverage_planning {
 namespace gk_ma {
@@ -31,15 +33,26 @@ class GkMa {
   GkMa(GkMa const&) = delete;
   void operator=(GkMa const&) = delete;
 
-  void setSolver(const std::string& file, bool binary);
-  void setSolver(const Task& task);
+  bool setSolver(const std::string& file, bool binary);
+  bool setSolver(const Task& task);
   bool solve();
   inline std::vector<int> getSolution() const { return solution_; }
+  // The cost matrix and clusters of the task set last, e.g., loaded from file.
+  bool getTask(std::vector<std::vector<int>>* m,
+               std::vector<std::vector<int>>* clusters) const;
 
  private:
   GkMa();
   ~GkMa();
 
+  // Register the calling thread with the Mono runtime. Required before
+  // invoking managed code from any thread but the one that created the domain.
+  void attachThread() const;
+
+  // The cost matrix as one flat, row-major int[].
+  MonoArray* matrixToFlatMonoArray(
+      const std::vector<std::vector<int>>& in) const;
+  // The clusters as jagged int[][]. Every row is copied at once.
   MonoArray* vectorOfVectorToMonoArray(
       const std::vector<std::vector<int>>& in) const;
 
@@ -47,8 +60,30 @@ class GkMa {
   MonoObject* solver_;
   MonoClass* solver_class_;
 
+  // Method handles, looked up once at construction.
+  MonoMethod* ctor_file_;     // OurSolver(string, bool)
+  MonoMethod* ctor_task_;     // OurSolver(int[], int, int[][], bool)
+  MonoMethod* solve_;         // Solve()
+  MonoMethod* get_solution_;  // int[] Solution { get; }
+  MonoMethod* get_flat_weights_;   // int[] FlatWeights { get; }
+  MonoMethod* get_task_clusters_;  // int[][] TaskClusters { get; }
+
   std::vector<int> solution_;
 };
+
+// GtspSolver adapter of the GkMa singleton. Concurrent solves are serialized.
+// GK MA cannot be interrupted and only reports its final tour. With a finite
+// budget, GK MA runs on a worker thread and solve() returns at the deadline
+// at the latest. If GK MA has not finished by then, the tour already stored in
+// the incumbent is returned, if any, and the worker finishes in the
+// background. Pass a budgeted MemeticGtspSolver for best-so-far tours.
+class GkMaSolver : public GtspSolver {
+ protected:
+  bool solveTask(const std::vector<std::vector<int>>& m,
+                 const std::vector<std::vector<int>>& clusters,
+                 const Clock::time_point& deadline, std::vector<int>* solution,
+                 GtspIncumbent* incumbent) const override;
+};
 }  // namespace gk_ma
 }  // namespace polygon_coverage_planning
 
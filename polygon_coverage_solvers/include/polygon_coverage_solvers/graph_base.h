@@ -3,7 +3,9 @@
 
 #include <cmath>
 #include <limits>
+#include <functional>
 #include <map>
+#include <unordered_map>
 #include <vector>
 
 // Utilities to create graphs.
@@ -23,6 +25,17 @@ typedef std::vector<std::map<size_t, double>> Graph;
 // second: to node
 typedef std::pair<size_t, size_t> EdgeId;
 
+// Hash of an edge id.
+struct EdgeIdHash {
+  inline size_t operator()(const EdgeId& edge_id) const {
+    // Boost hash_combine.
+    size_t seed = std::hash<size_t>()(edge_id.first);
+    seed ^= std::hash<size_t>()(edge_id.second) + 0x9e3779b9 + (seed << 6) +
+            (seed >> 2);
+    return seed;
+  }
+};
+
 // An edge.
 typedef std::pair<EdgeId, double> Edge;
 
@@ -34,19 +47,28 @@ typedef std::vector<size_t> Solution;
 // second: heuristic cost to goal
 typedef std::map<size_t, double> Heuristic;
 
+// The open set implementation used in Dijkstra and A* search.
+// kLinearScan: Ordered set, scanned for the lowest cost node.
+// kBinaryHeap: Indexed binary heap. Same solution as kLinearScan.
+// kRadixHeap: Monotone radix heap on milli int costs. Optimal w.r.t. the
+// costs rounded to three decimal digits.
+enum SearchEngine { kLinearScan = 0, kBinaryHeap, kRadixHeap };
+
 // The base graph class.
 template <class NodeProperty, class EdgeProperty>
 class GraphBase {
  public:
-  // A map from graph node id to node properties.
-  using NodeProperties = std::map<size_t, NodeProperty>;
-  // A map from graph edge id to edge properties.
-  using EdgeProperties = std::map<EdgeId, EdgeProperty>;
+  // The node properties indexed by graph node id.
+  using NodeProperties = std::vector<NodeProperty>;
+  // A hash map from graph edge id to edge properties.
+  using EdgeProperties = std::unordered_map<EdgeId, EdgeProperty, EdgeIdHash>;
 
   GraphBase()
       : start_idx_(std::numeric_limits<size_t>::max()),
         goal_idx_(std::numeric_limits<size_t>::max()),
-        is_created_(false){};
+        is_created_(false),
+        search_engine_(SearchEngine::kBinaryHeap),
+        is_frozen_(false){};
 
   // Add a node.
   bool addNode(const NodeProperty& node_property);
@@ -59,13 +81,27 @@ class GraphBase {
   void clearEdges();
   // Create graph given the internal settings.
   virtual bool create() = 0;
+  // Compact the adjacency into compressed sparse row (CSR) arrays and release
+  // the adjacency and edge property maps. All read-only queries use the CSR
+  // arrays afterwards. Adding nodes or edges thaws the graph again.
+  void freeze();
 
   inline size_t size() const { return graph_.size(); }
-  inline size_t getNumberOfEdges() const { return edge_properties_.size(); }
-  inline void reserve(size_t size) { graph_.reserve(size); }
+  inline size_t getNumberOfEdges() const {
+    return is_frozen_ ? csr_targets_.size() : edge_properties_.size();
+  }
+  inline void reserve(size_t size) {
+    graph_.reserve(size);
+    node_properties_.reserve(size);
+  }
   inline size_t getStartIdx() const { return start_idx_; }
   inline size_t getGoalIdx() const { return goal_idx_; }
   inline size_t isInitialized() const { return is_created_; }
+  inline void setSearchEngine(SearchEngine search_engine) {
+    search_engine_ = search_engine;
+  }
+  inline SearchEngine getSearchEngine() const { return search_engine_; }
+  inline bool isFrozen() const { return is_frozen_; }
 
   bool nodeExists(size_t node_id) const;
   bool nodePropertyExists(size_t node_id) const;
@@ -76,6 +112,11 @@ class GraphBase {
   const NodeProperty* getNodeProperty(size_t node_id) const;
   const EdgeProperty* getEdgeProperty(const EdgeId& edge_id) const;
 
+  // Call visitor(neighbor_id, cost) for all outgoing edges of node_id. The
+  // visitor returns false to stop the iteration. Returns false if stopped.
+  template <class Visitor>
+  bool forEachNeighbor(size_t node_id, const Visitor& visitor) const;
+
   // Solve the graph with Dijkstra using arbitrary start and goal index.
   bool solveDijkstra(size_t start, size_t goal, Solution* solution) const;
   // Solve the graph with Dijkstra using internal start and goal index.
@@ -107,8 +148,15 @@ class GraphBase {
   bool addEdge(const EdgeId& edge_id, const EdgeProperty& edge_property,
                double cost);
 
+  // Restore the adjacency and edge property maps from the CSR arrays.
+  void thaw();
+  // Returns the CSR position of an edge or max if it does not exist.
+  size_t findCsrPosition(const EdgeId& edge_id) const;
+
   Solution reconstructSolution(const std::map<size_t, size_t>& came_from,
                                size_t current) const;
+  Solution reconstructSolution(const std::vector<size_t>& came_from,
+                               size_t current) const;
 
   Graph graph_;
   // Map to store all node properties. Key is the graph node id.
@@ -118,6 +166,32 @@ class GraphBase {
   size_t start_idx_;
   size_t goal_idx_;
   bool is_created_;
+  SearchEngine search_engine_;
+
+  // Frozen CSR adjacency. The neighbors of node i are stored in
+  // [csr_offsets_[i], csr_offsets_[i + 1]) sorted by id.
+  bool is_frozen_;
+  std::vector<size_t> csr_offsets_;
+  std::vector<size_t> csr_targets_;
+  std::vector<double> csr_costs_;
+  std::vector<EdgeProperty> csr_edge_properties_;
+
+ private:
+  // The original search implementations that scan the open set for the
+  // lowest cost node.
+  bool solveDijkstraLinearScan(size_t start, size_t goal,
+                               Solution* solution) const;
+  bool solveAStarLinearScan(size_t start, size_t goal,
+                            const Heuristic& heuristic,
+                            Solution* solution) const;
+  // Dijkstra (heuristic == nullptr) or A* search using an indexed binary heap
+  // and flat cost arrays.
+  bool solveBinaryHeap(size_t start, size_t goal, const Heuristic* heuristic,
+                       Solution* solution) const;
+  // Dijkstra (heuristic == nullptr) or A* search on milli int costs using a
+  // monotone radix heap and flat cost arrays.
+  bool solveRadixHeap(size_t start, size_t goal, const Heuristic* heuristic,
+                      Solution* solution) const;
 };
 }  // namespace polygon_coverage_planning
 
@@ -0,0 +1,85 @@
+#ifndef POLYGON_COVERAGE_SOLVERS_GTSP_SOLVER_H_
+#define POLYGON_COVERAGE_SOLVERS_GTSP_SOLVER_H_
+
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <vector>
+
+namespace polygon_coverage_planning {
+
+// The limits of a solve. A solver that reaches a limit returns the best
+// solution found so far.
+struct GtspBudget {
+  GtspBudget(double max_time = std::numeric_limits<double>::infinity(),
+             size_t max_generations = std::numeric_limits<size_t>::max())
+      : max_time(max_time), max_generations(max_generations) {}
+  // The deadline of a solve starting now. Saturates for unlimited budgets.
+  std::chrono::steady_clock::time_point computeDeadline() const;
+  double max_time;         // Wall-clock time [s].
+  size_t max_generations;  // Only applies to evolutionary solvers.
+};
+
+// The best solution found so far. A running solver updates it whenever it
+// finds a better tour. Other threads may read it at any time, e.g., to return
+// a plan before a deadline.
+class GtspIncumbent {
+ public:
+  GtspIncumbent() : cost_(std::numeric_limits<int64_t>::max()) {}
+
+  // Replace the incumbent if cost is lower. Returns whether it was replaced.
+  bool update(const std::vector<int>& tour, int64_t cost);
+  // Returns false if no tour was found, yet.
+  bool get(std::vector<int>* tour, int64_t* cost = nullptr) const;
+  void clear();
+
+ private:
+  mutable std::mutex mutex_;
+  std::vector<int> tour_;
+  int64_t cost_;
+};
+
+// Interface of generalized traveling salesman problem (GTSP) solvers.
+// Implementations must be reentrant, i.e., solve() may be called concurrently
+// from multiple threads on the same solver.
+class GtspSolver {
+ public:
+  virtual ~GtspSolver() {}
+
+  // Find a short cycle that visits exactly one node of every cluster.
+  // m: the square, possibly asymmetric cost matrix. Non-existing edges have
+  // cost std::numeric_limits<int>::max().
+  // clusters: the node ids of every cluster. Every node belongs to at most one
+  // cluster.
+  // solution: the node ids of the cycle, one per cluster.
+  // incumbent: optional best tour so far, updated while solving.
+  bool solve(const std::vector<std::vector<int>>& m,
+             const std::vector<std::vector<int>>& clusters,
+             std::vector<int>* solution,
+             GtspIncumbent* incumbent = nullptr) const;
+
+  inline void setBudget(const GtspBudget& budget) { budget_ = budget; }
+  inline const GtspBudget& getBudget() const { return budget_; }
+
+  // The cost of a cycle. std::numeric_limits<int64_t>::max() if an edge does
+  // not exist.
+  static int64_t computeCost(const std::vector<std::vector<int>>& m,
+                             const std::vector<int>& tour);
+
+ protected:
+  typedef std::chrono::steady_clock Clock;
+
+  // Solve a valid task. Return the best solution when reaching the deadline.
+  virtual bool solveTask(const std::vector<std::vector<int>>& m,
+                         const std::vector<std::vector<int>>& clusters,
+                         const Clock::time_point& deadline,
+                         std::vector<int>* solution,
+                         GtspIncumbent* incumbent) const = 0;
+
+  GtspBudget budget_;
+};
+
+}  // namespace polygon_coverage_planning
+
+#endif  // POLYGON_COVERAGE_SOLVERS_GTSP_SOLVER_H_
@@ -0,0 +1,49 @@
+#ifndef POLYGON_COVERAGE_SOLVERS_HELD_KARP_H_
+#define POLYGON_COVERAGE_SOLVERS_HELD_KARP_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "polygon_coverage_solvers/graph_base.h"
+
+namespace polygon_coverage_planning {
+
+// Exact generalized traveling salesman path problem (GTSPP) solver. A
+// Held-Karp style dynamic program over (visited cluster set, last node):
+// cost(S, w) = min_{v in S \ c(w)} cost(S \ c(w), v) + c(v, w)
+// The cluster sets are processed layer by layer with increasing number of
+// clusters. Only the costs of the previous layer are kept in memory. All sets
+// of one layer are evaluated in parallel.
+// Time: O(2^n N^2), memory: O(2^n N) for the parent pointers, with n clusters
+// and N nodes.
+// Held, Michael, and Richard M. Karp. "A dynamic programming approach to
+// sequencing problems." Journal of the SIAM 10.1 (1962): 196-210.
+class HeldKarp {
+ public:
+  // A bitmask of clusters.
+  typedef uint64_t ClusterMask;
+  // The maximum number of clusters excluding start and goal.
+  static const size_t kMaxNumClusters = 32;
+
+  // num_threads: 0 uses all hardware threads.
+  HeldKarp(size_t num_threads = 0) : num_threads_(num_threads) {}
+
+  // Find the cheapest path from start to goal that visits exactly one node of
+  // every cluster.
+  // cost: the dense, possibly asymmetric cost matrix. Non-existing edges have
+  // cost std::numeric_limits<double>::max().
+  // clusters: the node ids of every cluster, excluding start and goal.
+  // solution: start, one node per cluster, goal.
+  bool solve(const std::vector<std::vector<double>>& cost,
+             const std::vector<std::vector<size_t>>& clusters, size_t start,
+             size_t goal, Solution* solution) const;
+
+  inline void setNumThreads(size_t num_threads) { num_threads_ = num_threads; }
+
+ private:
+  size_t num_threads_;
+};
+
+}  // namespace polygon_coverage_planning
+
+#endif  // POLYGON_COVERAGE_SOLVERS_HELD_KARP_H_
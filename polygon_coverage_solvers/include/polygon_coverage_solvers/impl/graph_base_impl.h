@@ -7,20 +7,22 @@
 #include <ros/assert.h>
 #include <ros/console.h>
 
+#include "polygon_coverage_solvers/priority_queue.h"
+
 namespace polygon_coverage_planning {
 
 template <class NodeProperty, class EdgeProperty>
 bool GraphBase<NodeProperty, EdgeProperty>::addNode(
     const NodeProperty& node_property) {
+  thaw();
   graph_.push_back(std::map<size_t, double>());  // Add node.
 
   // Add node properties.
-  const size_t idx = graph_.size() - 1;
-  node_properties_.insert(std::make_pair(idx, node_property));
+  node_properties_.push_back(node_property);
   // Create all adjacent edges.
   if (!addEdges()) {
     graph_.pop_back();
-    node_properties_.erase(node_properties_.find(idx));
+    node_properties_.pop_back();
     return false;
   }
   return true;
@@ -60,6 +62,11 @@ void GraphBase<NodeProperty, EdgeProperty>::clear() {
   start_idx_ = std::numeric_limits<size_t>::max();
   goal_idx_ = std::numeric_limits<size_t>::max();
   is_created_ = false;
+  is_frozen_ = false;
+  csr_offsets_.clear();
+  csr_targets_.clear();
+  csr_costs_.clear();
+  csr_edge_properties_.clear();
 }
 
 template <class NodeProperty, class EdgeProperty>
@@ -68,6 +75,109 @@ void GraphBase<NodeProperty, EdgeProperty>::clearEdges() {
   for (std::map<size_t, double>& neighbors : graph_) {
     neighbors.clear();
   }
+  is_frozen_ = false;
+  csr_offsets_.clear();
+  csr_targets_.clear();
+  csr_costs_.clear();
+  csr_edge_properties_.clear();
+}
+
+template <class NodeProperty, class EdgeProperty>
+void GraphBase<NodeProperty, EdgeProperty>::freeze() {
+  if (is_frozen_) {
+    return;
+  }
+
+  const size_t num_edges = edge_properties_.size();
+  csr_offsets_.assign(1, 0);
+  csr_offsets_.reserve(graph_.size() + 1);
+  csr_targets_.clear();
+  csr_targets_.reserve(num_edges);
+  csr_costs_.clear();
+  csr_costs_.reserve(num_edges);
+  csr_edge_properties_.clear();
+  csr_edge_properties_.reserve(num_edges);
+
+  for (size_t i = 0; i < graph_.size(); ++i) {
+    // The adjacency maps are sorted by neighbor id.
+    for (const std::pair<const size_t, double>& n : graph_[i]) {
+      csr_targets_.push_back(n.first);
+      csr_costs_.push_back(n.second);
+      typename EdgeProperties::const_iterator it =
+          edge_properties_.find(EdgeId(i, n.first));
+      csr_edge_properties_.push_back(it == edge_properties_.end()
+                                         ? EdgeProperty()
+                                         : it->second);
+    }
+    csr_offsets_.push_back(csr_targets_.size());
+  }
+
+  // Release the maps but keep the number of nodes.
+  Graph(graph_.size()).swap(graph_);
+  EdgeProperties().swap(edge_properties_);
+  is_frozen_ = true;
+}
+
+template <class NodeProperty, class EdgeProperty>
+void GraphBase<NodeProperty, EdgeProperty>::thaw() {
+  if (!is_frozen_) {
+    return;
+  }
+
+  edge_properties_.reserve(csr_targets_.size());
+  for (size_t i = 0; i < graph_.size(); ++i) {
+    for (size_t k = csr_offsets_[i]; k < csr_offsets_[i + 1]; ++k) {
+      graph_[i].insert(graph_[i].end(),
+                       std::make_pair(csr_targets_[k], csr_costs_[k]));
+      edge_properties_.insert(std::make_pair(EdgeId(i, csr_targets_[k]),
+                                             csr_edge_properties_[k]));
+    }
+  }
+
+  std::vector<size_t>().swap(csr_offsets_);
+  std::vector<size_t>().swap(csr_targets_);
+  std::vector<double>().swap(csr_costs_);
+  std::vector<EdgeProperty>().swap(csr_edge_properties_);
+  is_frozen_ = false;
+}
+
+template <class NodeProperty, class EdgeProperty>
+size_t GraphBase<NodeProperty, EdgeProperty>::findCsrPosition(
+    const EdgeId& edge_id) const {
+  if (!is_frozen_ || !nodeExists(edge_id.first)) {
+    return std::numeric_limits<size_t>::max();
+  }
+  const std::vector<size_t>::const_iterator begin =
+      csr_targets_.begin() + csr_offsets_[edge_id.first];
+  const std::vector<size_t>::const_iterator end =
+      csr_targets_.begin() + csr_offsets_[edge_id.first + 1];
+  const std::vector<size_t>::const_iterator it =
+      std::lower_bound(begin, end, edge_id.second);
+  if (it == end || *it != edge_id.second) {
+    return std::numeric_limits<size_t>::max();
+  }
+  return std::distance(csr_targets_.begin(), it);
+}
+
+template <class NodeProperty, class EdgeProperty>
+template <class Visitor>
+bool GraphBase<NodeProperty, EdgeProperty>::forEachNeighbor(
+    size_t node_id, const Visitor& visitor) const {
+  if (is_frozen_) {
+    for (size_t k = csr_offsets_[node_id]; k < csr_offsets_[node_id + 1];
+         ++k) {
+      if (!visitor(csr_targets_[k], csr_costs_[k])) {
+        return false;
+      }
+    }
+  } else {
+    for (const std::pair<const size_t, double>& n : graph_[node_id]) {
+      if (!visitor(n.first, n.second)) {
+        return false;
+      }
+    }
+  }
+  return true;
 }
 
 template <class NodeProperty, class EdgeProperty>
@@ -77,12 +187,15 @@ bool GraphBase<NodeProperty, EdgeProperty>::nodeExists(size_t node_id) const {
 template <class NodeProperty, class EdgeProperty>
 bool GraphBase<NodeProperty, EdgeProperty>::nodePropertyExists(
     size_t node_id) const {
-  return node_properties_.count(node_id) > 0;
+  return node_id < node_properties_.size();
 }
 
 template <class NodeProperty, class EdgeProperty>
 bool GraphBase<NodeProperty, EdgeProperty>::edgeExists(
     const EdgeId& edge_id) const {
+  if (is_frozen_) {
+    return findCsrPosition(edge_id) != std::numeric_limits<size_t>::max();
+  }
   return nodeExists(edge_id.first) &&
          graph_[edge_id.first].count(edge_id.second) > 0;
 }
@@ -90,6 +203,9 @@ bool GraphBase<NodeProperty, EdgeProperty>::edgeExists(
 template <class NodeProperty, class EdgeProperty>
 bool GraphBase<NodeProperty, EdgeProperty>::edgePropertyExists(
     const EdgeId& edge_id) const {
+  if (is_frozen_) {
+    return findCsrPosition(edge_id) != std::numeric_limits<size_t>::max();
+  }
   return edge_properties_.count(edge_id) > 0;
 }
 
@@ -98,7 +214,11 @@ bool GraphBase<NodeProperty, EdgeProperty>::getEdgeCost(const EdgeId& edge_id,
                                                         double* cost) const {
   ROS_ASSERT(cost);
 
-  if (edgeExists(edge_id)) {
+  const size_t csr_pos = findCsrPosition(edge_id);
+  if (csr_pos != std::numeric_limits<size_t>::max()) {
+    *cost = csr_costs_[csr_pos];
+    return true;
+  } else if (!is_frozen_ && edgeExists(edge_id)) {
     *cost = graph_.at(edge_id.first).at(edge_id.second);
     return true;
   } else {
@@ -113,7 +233,7 @@ template <class NodeProperty, class EdgeProperty>
 const NodeProperty* GraphBase<NodeProperty, EdgeProperty>::getNodeProperty(
     size_t node_id) const {
   if (nodePropertyExists(node_id)) {
-    return &(node_properties_.at(node_id));
+    return &(node_properties_[node_id]);
   } else {
     ROS_ERROR_STREAM("Cannot access node property " << node_id << ".");
     return nullptr;
@@ -124,8 +244,13 @@ template <class NodeProperty, class EdgeProperty>
 const EdgeProperty*
 GraphBase<NodeProperty, EdgeProperty>::GraphBase::getEdgeProperty(
     const EdgeId& edge_id) const {
-  if (edgePropertyExists(edge_id)) {
-    return &(edge_properties_.at(edge_id));
+  const size_t csr_pos = findCsrPosition(edge_id);
+  if (csr_pos != std::numeric_limits<size_t>::max()) {
+    return &(csr_edge_properties_[csr_pos]);
+  }
+  typename EdgeProperties::const_iterator it = edge_properties_.find(edge_id);
+  if (it != edge_properties_.end()) {
+    return &(it->second);
   } else {
     ROS_ERROR_STREAM("Cannot access edge property from "
                      << edge_id.first << " to " << edge_id.second << ".");
@@ -142,6 +267,19 @@ bool GraphBase<NodeProperty, EdgeProperty>::solveDijkstra(
     return false;
   }
 
+  switch (search_engine_) {
+    case SearchEngine::kBinaryHeap:
+      return solveBinaryHeap(start, goal, nullptr, solution);
+    case SearchEngine::kRadixHeap:
+      return solveRadixHeap(start, goal, nullptr, solution);
+    default:
+      return solveDijkstraLinearScan(start, goal, solution);
+  }
+}
+
+template <class NodeProperty, class EdgeProperty>
+bool GraphBase<NodeProperty, EdgeProperty>::solveDijkstraLinearScan(
+    size_t start, size_t goal, Solution* solution) const {
   // https://en.wikipedia.org/wiki/Dijkstra%27s_algorithm
   // Initialization.
   std::set<size_t> open_set = {start};  // Nodes to evaluate.
@@ -166,22 +304,21 @@ bool GraphBase<NodeProperty, EdgeProperty>::solveDijkstra(
     closed_set.insert(current);
 
     // Check all neighbors.
-    for (const std::pair<size_t, double>& n : graph_[current]) {
-      if (closed_set.count(n.first) > 0) {
-        continue;  // Ignore already evaluated neighbors.
+    forEachNeighbor(current, [&](size_t n, double edge_cost) {
+      if (closed_set.count(n) > 0) {
+        return true;  // Ignore already evaluated neighbors.
       }
-      open_set.insert(n.first);  // Add to open set if not already in.
+      open_set.insert(n);  // Add to open set if not already in.
 
       // The distance from start to a neighbor.
-      const double tentative_cost = cost[current] + n.second;
-      if (tentative_cost >= cost[n.first]) {
-        continue;  // This is not a better path to n.
-      } else {
+      const double tentative_cost = cost[current] + edge_cost;
+      if (tentative_cost < cost[n]) {
         // This path is the best path to n until now.
-        came_from[n.first] = current;
-        cost[n.first] = tentative_cost;
+        came_from[n] = current;
+        cost[n] = tentative_cost;
       }
-    }
+      return true;
+    });
   }
 
   return false;
@@ -213,6 +350,20 @@ bool GraphBase<NodeProperty, EdgeProperty>::solveAStar(
     return false;
   }
 
+  switch (search_engine_) {
+    case SearchEngine::kBinaryHeap:
+      return solveBinaryHeap(start, goal, &heuristic, solution);
+    case SearchEngine::kRadixHeap:
+      return solveRadixHeap(start, goal, &heuristic, solution);
+    default:
+      return solveAStarLinearScan(start, goal, heuristic, solution);
+  }
+}
+
+template <class NodeProperty, class EdgeProperty>
+bool GraphBase<NodeProperty, EdgeProperty>::solveAStarLinearScan(
+    size_t start, size_t goal, const Heuristic& heuristic,
+    Solution* solution) const {
   // https://en.wikipedia.org/wiki/A*_search_algorithm
   // Initialization.
   std::set<size_t> open_set = {start};  // Nodes to evaluate.
@@ -246,26 +397,30 @@ bool GraphBase<NodeProperty, EdgeProperty>::solveAStar(
     closed_set.insert(current);
 
     // Check all neighbors.
-    for (const std::pair<size_t, double>& n : graph_[current]) {
-      if (closed_set.count(n.first) > 0) {
-        continue;  // Ignore already evaluated neighbors.
-      }
-      open_set.insert(n.first);  // Add to open set if not already in.
-
-      // The distance from start to a neighbor.
-      const double tentative_cost = cost[current] + n.second;
-      if (tentative_cost >= cost[n.first]) {
-        continue;  // This is not a better path to n.
-      } else {
-        // This path is the best path to n until now.
-        came_from[n.first] = current;
-        cost[n.first] = tentative_cost;
-        const Heuristic::const_iterator heuristic_it = heuristic.find(n.first);
-        if (heuristic_it == heuristic.end()) {
-          return false;  // Heuristic not found.
-        }
-        cost_with_heuristic[n.first] = cost[n.first] + heuristic_it->second;
-      }
+    const bool heuristic_found =
+        forEachNeighbor(current, [&](size_t n, double edge_cost) {
+          if (closed_set.count(n) > 0) {
+            return true;  // Ignore already evaluated neighbors.
+          }
+          open_set.insert(n);  // Add to open set if not already in.
+
+          // The distance from start to a neighbor.
+          const double tentative_cost = cost[current] + edge_cost;
+          if (tentative_cost >= cost[n]) {
+            return true;  // This is not a better path to n.
+          }
+          // This path is the best path to n until now.
+          came_from[n] = current;
+          cost[n] = tentative_cost;
+          const Heuristic::const_iterator heuristic_it = heuristic.find(n);
+          if (heuristic_it == heuristic.end()) {
+            return false;  // Heuristic not found.
+          }
+          cost_with_heuristic[n] = cost[n] + heuristic_it->second;
+          return true;
+        });
+    if (!heuristic_found) {
+      return false;
     }
   }
 
@@ -278,9 +433,158 @@ bool GraphBase<NodeProperty, EdgeProperty>::solveAStar(
   return GraphBase::solveAStar(start_idx_, goal_idx_, solution);
 }
 
+template <class NodeProperty, class EdgeProperty>
+bool GraphBase<NodeProperty, EdgeProperty>::solveBinaryHeap(
+    size_t start, size_t goal, const Heuristic* heuristic,
+    Solution* solution) const {
+  // Initialization.
+  IndexedBinaryHeap open_set(graph_.size());  // Nodes to evaluate.
+  std::vector<bool> closed_set(graph_.size(), false);  // Evaluated nodes.
+  // Get previous node on optimal path.
+  std::vector<size_t> came_from(graph_.size(),
+                                std::numeric_limits<size_t>::max());
+  // Optimal cost from start.
+  std::vector<double> cost(graph_.size(), std::numeric_limits<double>::max());
+  // cost + heuristic
+  std::vector<double> cost_with_heuristic(graph_.size(),
+                                          std::numeric_limits<double>::max());
+  cost[start] = 0.0;
+  cost_with_heuristic[start] = 0.0;
+  if (heuristic) {
+    const Heuristic::const_iterator start_heuristic_it = heuristic->find(start);
+    if (start_heuristic_it == heuristic->end()) {
+      return false;  // Heuristic not found.
+    }
+    cost_with_heuristic[start] = start_heuristic_it->second;
+  }
+  open_set.push(start, cost_with_heuristic[start]);
+
+  while (!open_set.empty()) {
+    // Pop vertex with lowest cost with heuristic from open set.
+    const size_t current = open_set.pop();
+    if (current == goal) {  // Reached goal.
+      *solution = reconstructSolution(came_from, current);
+      return true;
+    }
+    closed_set[current] = true;
+
+    // Check all neighbors.
+    const bool heuristic_found =
+        forEachNeighbor(current, [&](size_t n, double edge_cost) {
+          if (closed_set[n]) {
+            return true;  // Ignore already evaluated neighbors.
+          }
+
+          // The distance from start to a neighbor.
+          const double tentative_cost = cost[current] + edge_cost;
+          if (tentative_cost < cost[n]) {
+            // This path is the best path to n until now.
+            came_from[n] = current;
+            cost[n] = tentative_cost;
+            cost_with_heuristic[n] = tentative_cost;
+            if (heuristic) {
+              const Heuristic::const_iterator heuristic_it =
+                  heuristic->find(n);
+              if (heuristic_it == heuristic->end()) {
+                return false;  // Heuristic not found.
+              }
+              cost_with_heuristic[n] += heuristic_it->second;
+            }
+          }
+          // Add to open set if not already in or update its key.
+          open_set.push(n, cost_with_heuristic[n]);
+          return true;
+        });
+    if (!heuristic_found) {
+      return false;
+    }
+  }
+
+  return false;
+}
+
+template <class NodeProperty, class EdgeProperty>
+bool GraphBase<NodeProperty, EdgeProperty>::solveRadixHeap(
+    size_t start, size_t goal, const Heuristic* heuristic,
+    Solution* solution) const {
+  // Initialization.
+  RadixHeap open_set;  // Nodes to evaluate, possibly multiple times.
+  std::vector<bool> closed_set(graph_.size(), false);  // Evaluated nodes.
+  // Get previous node on optimal path.
+  std::vector<size_t> came_from(graph_.size(),
+                                std::numeric_limits<size_t>::max());
+  // Optimal milli int cost from start.
+  std::vector<uint64_t> cost(graph_.size(),
+                             std::numeric_limits<uint64_t>::max());
+  // cost + heuristic
+  std::vector<uint64_t> cost_with_heuristic(
+      graph_.size(), std::numeric_limits<uint64_t>::max());
+  cost[start] = 0;
+  cost_with_heuristic[start] = 0;
+  if (heuristic) {
+    const Heuristic::const_iterator start_heuristic_it = heuristic->find(start);
+    if (start_heuristic_it == heuristic->end()) {
+      return false;  // Heuristic not found.
+    }
+    cost_with_heuristic[start] = doubleToMilliInt(start_heuristic_it->second);
+  }
+  open_set.push(start, cost_with_heuristic[start]);
+
+  while (!open_set.empty()) {
+    // Pop vertex with lowest cost with heuristic from open set.
+    const RadixHeap::Entry entry = open_set.pop();
+    const size_t current = entry.second;
+    if (closed_set[current] || entry.first < cost_with_heuristic[current]) {
+      continue;  // Outdated entry.
+    }
+    if (current == goal) {  // Reached goal.
+      *solution = reconstructSolution(came_from, current);
+      return true;
+    }
+    closed_set[current] = true;
+
+    // Check all neighbors.
+    const bool heuristic_found =
+        forEachNeighbor(current, [&](size_t n, double edge_cost) {
+          if (closed_set[n]) {
+            return true;  // Ignore already evaluated neighbors.
+          }
+
+          // The distance from start to a neighbor.
+          const uint64_t tentative_cost =
+              cost[current] + doubleToMilliInt(edge_cost);
+          if (tentative_cost >= cost[n]) {
+            return true;  // This is not a better path to n.
+          }
+          // This path is the best path to n until now.
+          came_from[n] = current;
+          cost[n] = tentative_cost;
+          cost_with_heuristic[n] = tentative_cost;
+          if (heuristic) {
+            const Heuristic::const_iterator heuristic_it = heuristic->find(n);
+            if (heuristic_it == heuristic->end()) {
+              return false;  // Heuristic not found.
+            }
+            cost_with_heuristic[n] += doubleToMilliInt(heuristic_it->second);
+          }
+          // Inconsistent heuristics are clamped to the last popped key.
+          cost_with_heuristic[n] =
+              std::max(cost_with_heuristic[n], open_set.getLastKey());
+          open_set.push(n, cost_with_heuristic[n]);
+          return true;
+        });
+    if (!heuristic_found) {
+      return false;
+    }
+  }
+
+  return false;
+}
+
 template <class NodeProperty, class EdgeProperty>
 bool GraphBase<NodeProperty, EdgeProperty>::addEdge(
     const EdgeId& edge_id, const EdgeProperty& edge_property, double cost) {
+  thaw();
   if (cost >= 0.0 && nodeExists(edge_id.first)) {
     graph_[edge_id.first][edge_id.second] = cost;
     edge_properties_.insert(std::make_pair(edge_id, edge_property));
@@ -302,6 +606,18 @@ Solution GraphBase<NodeProperty, EdgeProperty>::reconstructSolution(
   return solution;
 }
 
+template <class NodeProperty, class EdgeProperty>
+Solution GraphBase<NodeProperty, EdgeProperty>::reconstructSolution(
+    const std::vector<size_t>& came_from, size_t current) const {
+  Solution solution = {current};
+  while (came_from[current] != std::numeric_limits<size_t>::max()) {
+    current = came_from[current];
+    solution.push_back(current);
+  }
+  std::reverse(solution.begin(), solution.end());
+  return solution;
+}
+
 template <class NodeProperty, class EdgeProperty>
 std::vector<std::vector<int>>
 GraphBase<NodeProperty, EdgeProperty>::getAdjacencyMatrix() const {
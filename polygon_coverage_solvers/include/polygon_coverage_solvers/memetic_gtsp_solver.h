@@ -0,0 +1,56 @@
+#ifndef POLYGON_COVERAGE_SOLVERS_MEMETIC_GTSP_SOLVER_H_
+#define POLYGON_COVERAGE_SOLVERS_MEMETIC_GTSP_SOLVER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "polygon_coverage_solvers/gtsp_solver.h"
+
+namespace polygon_coverage_planning {
+
+// Native memetic GTSP solver following the design of GK MA:
+// - a population of tours, each given by its sequence of nodes,
+// - ordered crossover of the cluster sequences and segment reversal mutation,
+// - local improvement by node insertion, 2-opt (symmetric instances only) and
+//   cluster optimization, i.e., the optimal node choice for a fixed cluster
+//   order,
+// - termination after a number of generations without improvement or when
+//   the budget is exhausted.
+// All state lives in solve(), so one solver can be shared between threads.
+// G. Gutin, D. Karapetyan, "A memetic algorithm for the generalized traveling
+// salesman problem." Natural Computing 9.1 (2010): 47-60.
+class MemeticGtspSolver : public GtspSolver {
+ public:
+  struct Settings {
+    Settings()
+        : population_size(30),
+          num_elite(10),
+          max_stall_generations(10),
+          mutation_probability(0.1),
+          seed(123456) {}
+    size_t population_size;        // Number of tours per generation.
+    size_t num_elite;              // Best tours kept in the next generation.
+    size_t max_stall_generations;  // Stop without improvement.
+    double mutation_probability;   // Probability to mutate an offspring.
+    unsigned int seed;             // Random seed. Same seed, same solution.
+  };
+
+  MemeticGtspSolver() {}
+  MemeticGtspSolver(const Settings& settings) : settings_(settings) {}
+
+  inline const Settings& getSettings() const { return settings_; }
+
+ protected:
+  bool solveTask(const std::vector<std::vector<int>>& m,
+                 const std::vector<std::vector<int>>& clusters,
+                 const Clock::time_point& deadline, std::vector<int>* solution,
+                 GtspIncumbent* incumbent) const override;
+
+ private:
+  Settings settings_;
+};
+
+}  // namespace polygon_coverage_planning
+
+#endif  // POLYGON_COVERAGE_SOLVERS_MEMETIC_GTSP_SOLVER_H_
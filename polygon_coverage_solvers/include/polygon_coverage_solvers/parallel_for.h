@@ -0,0 +1,43 @@
+#ifndef POLYGON_COVERAGE_SOLVERS_PARALLEL_FOR_H_
+#define POLYGON_COVERAGE_SOLVERS_PARALLEL_FOR_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace polygon_coverage_planning {
+
+// Call fn(i) for all i in [0, n). The indices are handed out dynamically to
+// num_threads threads, i.e., jobs of different size are balanced. fn must be
+// thread safe. num_threads = 0 uses all hardware threads.
+template <class Function>
+void parallelFor(size_t n, size_t num_threads, const Function& fn) {
+  if (num_threads == 0) {
+    num_threads = std::thread::hardware_concurrency();
+  }
+  num_threads = std::max<size_t>(1, std::min(num_threads, n));
+  if (num_threads == 1) {
+    for (size_t i = 0; i < n; ++i) fn(i);
+    return;
+  }
+
+  std::atomic<size_t> next(0);
+  auto worker = [&next, n, &fn]() {
+    for (size_t i = next++; i < n; i = next++) fn(i);
+  };
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads - 1);
+  for (size_t t = 1; t < num_threads; ++t) {
+    threads.emplace_back(worker);
+  }
+  worker();  // Calling thread works, too.
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+}
+
+}  // namespace polygon_coverage_planning
+
+#endif  // POLYGON_COVERAGE_SOLVERS_PARALLEL_FOR_H_
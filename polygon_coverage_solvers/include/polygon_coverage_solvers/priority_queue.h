@@ -0,0 +1,79 @@
+#ifndef POLYGON_COVERAGE_SOLVERS_PRIORITY_QUEUE_H_
+#define POLYGON_COVERAGE_SOLVERS_PRIORITY_QUEUE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Priority queues for graph search.
+namespace polygon_coverage_planning {
+
+// An indexed binary min-heap over the ids [0, capacity). Every id is contained
+// at most once. Ties are broken by the smaller id such that the pop order is
+// identical to a linear scan over an ordered open set.
+class IndexedBinaryHeap {
+ public:
+  IndexedBinaryHeap(size_t capacity);
+
+  inline bool empty() const { return heap_.empty(); }
+  inline size_t size() const { return heap_.size(); }
+  inline bool contains(size_t id) const {
+    return id < position_.size() && position_[id] != kNotInHeap;
+  }
+
+  // Insert id or update its key if it is already contained.
+  void push(size_t id, double key);
+  // Remove and return the id with the lowest key.
+  size_t pop();
+  // The lowest key in the heap.
+  inline double topKey() const { return key_[heap_.front()]; }
+
+ private:
+  static const size_t kNotInHeap;
+
+  // Compare the heap elements at position a and b.
+  bool less(size_t a, size_t b) const;
+  void swap(size_t a, size_t b);
+  void siftUp(size_t pos);
+  void siftDown(size_t pos);
+
+  std::vector<size_t> heap_;      // The heap of ids.
+  std::vector<size_t> position_;  // Position of id in heap_.
+  std::vector<double> key_;       // Key of id.
+};
+
+// A monotone radix heap for integer keys, e.g., milli int costs. Pushed keys
+// must not be smaller than the last popped key. Ids can be pushed several
+// times (lazy deletion), i.e., the caller needs to skip outdated entries. Ties
+// are broken by the smaller id.
+// Ahuja, Ravindra K., et al. "Faster algorithms for the shortest path
+// problem." Journal of the ACM 37.2 (1990): 213-223.
+class RadixHeap {
+ public:
+  // first: key
+  // second: id
+  typedef std::pair<uint64_t, size_t> Entry;
+
+  RadixHeap();
+
+  inline bool empty() const { return size_ == 0; }
+  inline size_t size() const { return size_; }
+  inline uint64_t getLastKey() const { return last_; }
+
+  // Insert id with key. Keys smaller than the last popped key are clamped.
+  void push(size_t id, uint64_t key);
+  // Remove and return the entry with the lowest key.
+  Entry pop();
+
+ private:
+  size_t bucketIndex(uint64_t key) const;
+
+  std::vector<std::vector<Entry>> buckets_;
+  uint64_t last_;
+  size_t size_;
+};
+
+}  // namespace polygon_coverage_planning
+
+#endif  // POLYGON_COVERAGE_SOLVERS_PRIORITY_QUEUE_H_
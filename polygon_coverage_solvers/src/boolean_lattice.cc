@@ -1,152 +1,145 @@
-#include <cmath>
-#include <numeric>
-
+#include <ros/assert.h>
 #include <ros/console.h>
 
 #include "polygon_coverage_solvers/boolean_lattice.h"
-#include "polygon_coverage_solvers/combinatorics.h"
 
 namespace polygon_coverage_planning {
 namespace boolean_lattice {
 
+const size_t BooleanLattice::kMaxNumClusters;
+
 void BooleanLattice::clear() {
-  GraphBase::clear();
-  num_clusters_ = sorted_original_clusters_.size();
+  num_clusters_ = num_original_clusters_;
   start_cluster_ = 0;
   goal_cluster_ = 0;
+  start_idx_ = std::numeric_limits<size_t>::max();
+  goal_idx_ = std::numeric_limits<size_t>::max();
+  is_created_ = false;
 }
 
 bool BooleanLattice::create() {
   clear();
 
-  // Create all k elements of n combinations for all k in [0 .. n].
-  graph_.reserve(
-      std::exp2(num_clusters_));  // A boolean lattice has 2^n elements.
-  for (size_t k = 0; k < num_clusters_ + 1; ++k) {
-    std::vector<std::set<size_t>> combinations;
-    getAllCombinationsOfKElementsFromN(sorted_original_clusters_, k,
-                                       &combinations);
-    // Add combinations as nodes to the graph.
-    for (const std::set<size_t>& combination : combinations) {
-      if (!addNode(NodeProperty(combination))) {
-        return false;
-      }
-    }
+  if (num_original_clusters_ > kMaxNumClusters) {
+    ROS_ERROR_STREAM("Boolean lattice supports at most "
+                     << kMaxNumClusters << " clusters. Requested "
+                     << num_original_clusters_ << " clusters.");
+    num_original_clusters_ = 0;
+    num_clusters_ = 0;
+    return false;
   }
 
   ROS_INFO_STREAM("Successfully created boolean lattice with "
-                  << graph_.size() << " nodes and " << edge_properties_.size()
-                  << " edges.");
+                  << getNumRegularNodes() << " implicit nodes.");
 
   is_created_ = true;
-  return graph_.size() == std::exp2(num_clusters_)  // 2^n elements.
-         && edge_properties_.size() ==
-                num_clusters_ *
-                    std::exp2(num_clusters_ - 1)  //  n * 2^(n-1) edges.
-         && graph_.size() == node_properties_.size();
-}
-
-bool BooleanLattice::addEdges() {
-  if (graph_.empty()) {
-    ROS_INFO_STREAM("Cannot add edges to an empty graph.");
-    return false;
-  }
-
-  const size_t new_id = graph_.size() - 1;
-  for (size_t adj_id = 0; adj_id < new_id; ++adj_id) {
-    EdgeId backwards_edge_id(adj_id, new_id);
-    EdgeId forwards_edge_id(new_id, adj_id);
-    if (isConnected(backwards_edge_id)) {
-      if (!addEdge(backwards_edge_id, EdgeProperty(), 0.0)) {
-        return false;
-      }
-    } else if (isConnected(forwards_edge_id)) {
-      if (!addEdge(forwards_edge_id, EdgeProperty(), 0.0)) {
-        return false;
-      }
-    }
-  }
   return true;
 }
 
-bool BooleanLattice::isConnected(const EdgeId& edge_id) {
-  // Access node properties:
-  const NodeProperty* from_node_property = getNodeProperty(edge_id.first);
-  const NodeProperty* to_node_property = getNodeProperty(edge_id.second);
-  if (from_node_property == nullptr || to_node_property == nullptr) {
+bool BooleanLattice::addStartNode() {
+  if (!is_created_) {
+    ROS_ERROR_STREAM("create() needs to be called first.");
     return false;
   }
 
-  // Check if edge from_id->to_id exists:
-  return from_node_property->visited_clusters.size() + 1 ==
-             to_node_property->visited_clusters.size() &&
-         std::includes(to_node_property->visited_clusters.begin(),
-                       to_node_property->visited_clusters.end(),
-                       from_node_property->visited_clusters.begin(),
-                       from_node_property->visited_clusters.end());
+  // All regular nodes implicitly include the unique start cluster.
+  start_idx_ = size();
+  start_cluster_ = num_clusters_;
+  num_clusters_++;
+  return true;
 }
 
-bool BooleanLattice::addStartNode(const NodeProperty& node_property) {
+bool BooleanLattice::addGoalNode() {
   if (!is_created_) {
     ROS_ERROR_STREAM("create() needs to be called first.");
     return false;
   }
 
-  start_idx_ = graph_.size();
-  // Add start cluster to all existing node properties.
-  start_cluster_ = num_clusters_;  // Unique start cluster.
+  // The goal node includes all clusters.
+  goal_idx_ = size();
+  goal_cluster_ = num_clusters_;
   num_clusters_++;
-  for (size_t i = 0; i < node_properties_.size(); ++i) {
-    if (node_properties_.count(i) == 0) {
-      is_created_ = false;  // Need to reset graph state.
-      return false;
+  return true;
+}
+
+bool BooleanLattice::includesCluster(size_t node_id, size_t cluster) const {
+  if (isRegularNode(node_id)) {
+    if (cluster < num_original_clusters_) {
+      return (static_cast<ClusterMask>(node_id) >> cluster) & 1;
     }
-    node_properties_[i].visited_clusters.insert(start_cluster_);
+    return hasStartNode() && cluster == start_cluster_;
+  } else if (hasGoalNode() && node_id == goal_idx_) {
+    return cluster < num_clusters_;
   }
+  return false;  // Start node or invalid node.
+}
 
-  // Add new node with empty visited set.
-  if (!addNode(NodeProperty())) {
-    is_created_ = false;  // Need to reset graph state.
-    return false;
+bool BooleanLattice::edgeExists(const EdgeId& edge_id) const {
+  const size_t from = edge_id.first;
+  const size_t to = edge_id.second;
+  if (isRegularNode(from) && isRegularNode(to)) {
+    // Exactly one additional bit set.
+    const ClusterMask diff = static_cast<ClusterMask>(from ^ to);
+    return (from & to) == from && diff != 0 && (diff & (diff - 1)) == 0;
   }
-
-  return true;
+  if (hasStartNode() && from == start_idx_) {
+    return to == 0;
+  }
+  if (hasGoalNode() && to == goal_idx_) {
+    return from == getFullNode();
+  }
+  return false;
 }
 
-bool BooleanLattice::addStartNode() { return addStartNode(NodeProperty()); }
+bool BooleanLattice::getEdgeCost(const EdgeId& edge_id, double* cost) const {
+  ROS_ASSERT(cost);
 
-bool BooleanLattice::addGoalNode(const NodeProperty& node_property) {
-  if (!is_created_) {
-    ROS_ERROR_STREAM("create() needs to be called first.");
+  if (edgeExists(edge_id)) {
+    *cost = 0.0;
+    return true;
+  } else {
+    ROS_ERROR_STREAM("Edge from " << edge_id.first << " to " << edge_id.second
+                                  << " does not exist.");
+    *cost = -1.0;
     return false;
   }
+}
 
-  goal_idx_ = graph_.size();
-  goal_cluster_ = num_clusters_;  // Unique goal cluster.
-  num_clusters_++;
-
-  // Goal node is connected to maximum visited cluster set.
-  // Find maximum set.
-  NodeProperty max_node_property =
-      std::max_element(node_properties_.begin(), node_properties_.end(),
-                       [](const std::pair<size_t, NodeProperty>& a,
-                          const std::pair<size_t, NodeProperty>& b) {
-                         return a.second.visited_clusters.size() <
-                                b.second.visited_clusters.size();
-                       })
-          ->second;
-  max_node_property.visited_clusters.insert(goal_cluster_);
-
-  // Add new node with completely visited set.
-  if (!addNode(max_node_property)) {
-    is_created_ = false;
-    return false;
+void BooleanLattice::getSuccessors(size_t node_id,
+                                   std::vector<size_t>* successors) const {
+  ROS_ASSERT(successors);
+  successors->clear();
+
+  if (hasStartNode() && node_id == start_idx_) {
+    successors->push_back(0);
+  } else if (isRegularNode(node_id)) {
+    if (node_id == getFullNode()) {
+      if (hasGoalNode()) successors->push_back(goal_idx_);
+      return;
+    }
+    for (size_t c = 0; c < num_original_clusters_; ++c) {
+      const size_t bit = static_cast<size_t>(1) << c;
+      if ((node_id & bit) == 0) successors->push_back(node_id | bit);
+    }
   }
-
-  return true;
 }
 
-bool BooleanLattice::addGoalNode() { return addGoalNode(NodeProperty()); }
+size_t BooleanLattice::getSuccessor(size_t node_id, size_t cluster) const {
+  if (isRegularNode(node_id)) {
+    if (cluster < num_original_clusters_) {
+      const size_t bit = static_cast<size_t>(1) << cluster;
+      return (node_id & bit) == 0 ? node_id | bit
+                                  : std::numeric_limits<size_t>::max();
+    } else if (hasGoalNode() && cluster == goal_cluster_ &&
+               node_id == getFullNode()) {
+      return goal_idx_;
+    }
+  } else if (hasStartNode() && node_id == start_idx_ &&
+             cluster == start_cluster_) {
+    return 0;
+  }
+  return std::numeric_limits<size_t>::max();
+}
 
 }  // namespace boolean_lattice
 }  // namespace polygon_coverage_planning
@@ -0,0 +1,81 @@
+#include "polygon_coverage_solvers/exact_gtsp_solver.h"
+
+#include <limits>
+
+#include <ros/assert.h>
+#include <ros/console.h>
+
+namespace polygon_coverage_planning {
+
+bool ExactGtspSolver::solveTask(const std::vector<std::vector<int>>& m,
+                                const std::vector<std::vector<int>>& clusters,
+                                const Clock::time_point& deadline,
+                                std::vector<int>* solution,
+                                GtspIncumbent* incumbent) const {
+  ROS_ASSERT(solution);
+  solution->clear();
+
+  // Fix the smallest cluster.
+  size_t first = 0;
+  for (size_t c = 1; c < clusters.size(); ++c) {
+    if (clusters[c].size() < clusters[first].size()) first = c;
+  }
+  std::vector<std::vector<size_t>> other_clusters;
+  for (size_t c = 0; c < clusters.size(); ++c) {
+    if (c == first) continue;
+    other_clusters.emplace_back(clusters[c].begin(), clusters[c].end());
+  }
+  if (other_clusters.empty()) {
+    *solution = {clusters[first].front()};
+    if (incumbent) incumbent->update(*solution, 0);
+    return true;
+  }
+  if (other_clusters.size() > HeldKarp::kMaxNumClusters) {
+    ROS_ERROR_STREAM("Exact GTSP solver supports at most "
+                     << HeldKarp::kMaxNumClusters + 1 << " clusters. Requested "
+                     << clusters.size() << " clusters.");
+    return false;
+  }
+
+  // The dense cost matrix with an additional goal node, i.e., a copy of the
+  // current start node.
+  const double kInfinity = std::numeric_limits<double>::max();
+  const size_t goal = m.size();
+  std::vector<std::vector<double>> cost(
+      goal + 1, std::vector<double>(goal + 1, kInfinity));
+  for (size_t i = 0; i < goal; ++i) {
+    for (size_t j = 0; j < goal; ++j) {
+      if (m[i][j] != std::numeric_limits<int>::max()) cost[i][j] = m[i][j];
+    }
+  }
+
+  int64_t best_cost = std::numeric_limits<int64_t>::max();
+  for (size_t k = 0; k < clusters[first].size(); ++k) {
+    // Try at least one start node.
+    if (k > 0 && Clock::now() > deadline) {
+      ROS_WARN_STREAM("Time budget exhausted. Returning best cycle so far.");
+      break;
+    }
+    const int s = clusters[first][k];
+    for (size_t i = 0; i < goal; ++i) cost[i][goal] = cost[i][s];
+
+    Solution path;
+    if (!held_karp_.solve(cost, other_clusters, s, goal, &path)) continue;
+    path.pop_back();  // Goal.
+    const std::vector<int> tour(path.begin(), path.end());
+    const int64_t tour_cost = computeCost(m, tour);
+    if (tour_cost < best_cost) {
+      best_cost = tour_cost;
+      *solution = tour;
+      if (incumbent) incumbent->update(tour, tour_cost);
+    }
+  }
+
+  if (solution->empty()) {
+    ROS_ERROR_STREAM("No feasible GTSP solution.");
+    return false;
+  }
+  return true;
+}
+
+}  // namespace polygon_coverage_planning
@@ -1,7 +1,14 @@
 #include "polygon_coverage_solvers/gk_ma.h"
 
+#include <cstring>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+
 #include <mono/jit/jit.h>
 #include <mono/metadata/assembly.h>
+#include <mono/metadata/threads.h>
 
 #include <ros/assert.h>
 #include <ros/console.h>
@@ -18,6 +25,20 @@ const std::string kCatkinPath =
 const std::string kLibraryPath = kCatkinPath + "/devel/lib";
 const std::string kExecutablePath = kLibraryPath + "/" + kFile;
 
+// Serializes all GkMaSolver calls to the singleton.
+std::mutex gk_ma_mutex;
+
+// Solve a task with the singleton. Leaves the solution empty on failure.
+void solveGkMa(const Task& task, std::vector<int>* solution) {
+  ROS_ASSERT(solution);
+  solution->clear();
+  std::lock_guard<std::mutex> lock(gk_ma_mutex);
+  GkMa& gk_ma = GkMa::getInstance();
+  if (gk_ma.setSolver(task) && gk_ma.solve()) {
+    *solution = gk_ma.getSolution();
+  }
+}
+
 bool Task::mIsSquare() const {
   for (size_t i = 0; i < m.size(); ++i) {
     if (m[i].size() != m.size()) {
@@ -41,7 +62,13 @@ bool Task::mIsSymmetric() const {
   return true;
 }
 
-GkMa::GkMa() {
+GkMa::GkMa()
+    : ctor_file_(NULL),
+      ctor_task_(NULL),
+      solve_(NULL),
+      get_solution_(NULL),
+      get_flat_weights_(NULL),
+      get_task_clusters_(NULL) {
   domain_ = mono_jit_init(kFile.c_str());
   MonoAssembly* assembly =
       mono_domain_assembly_open(domain_, kExecutablePath.c_str());
@@ -53,52 +80,82 @@ GkMa::GkMa() {
   ROS_ASSERT_MSG(solver_class_, "Cannot find OurSolver in assembly %s",
                  mono_image_get_filename(image));
   solver_ = mono_object_new(domain_, solver_class_);  // Allocate memory.
+
+  // Look up all methods once. The constructors differ in their number of
+  // arguments.
+  ctor_file_ = mono_class_get_method_from_name(solver_class_, ".ctor", 2);
+  ctor_task_ = mono_class_get_method_from_name(solver_class_, ".ctor", 4);
+  solve_ = mono_class_get_method_from_name(solver_class_, "Solve", 0);
+  MonoProperty* prop =
+      mono_class_get_property_from_name(solver_class_, "Solution");
+  if (prop) get_solution_ = mono_property_get_get_method(prop);
+  prop = mono_class_get_property_from_name(solver_class_, "FlatWeights");
+  if (prop) get_flat_weights_ = mono_property_get_get_method(prop);
+  prop = mono_class_get_property_from_name(solver_class_, "TaskClusters");
+  if (prop) get_task_clusters_ = mono_property_get_get_method(prop);
+
+  ROS_ERROR_COND(ctor_file_ == NULL,
+                 "Constructor OurSolver(string, bool) not found.");
+  ROS_ERROR_COND(ctor_task_ == NULL,
+                 "Constructor OurSolver(int[], int, int[][], bool) not found.");
+  ROS_ERROR_COND(solve_ == NULL, "Method Solve() not found.");
+  ROS_ERROR_COND(get_solution_ == NULL, "Getter Solution() not found.");
+  ROS_ERROR_COND(get_flat_weights_ == NULL, "Getter FlatWeights() not found.");
+  ROS_ERROR_COND(get_task_clusters_ == NULL,
+                 "Getter TaskClusters() not found.");
 }
 
 GkMa::~GkMa() { mono_jit_cleanup(domain_); }
 
-void GkMa::setSolver(const std::string& file, bool binary) {
+void GkMa::attachThread() const { mono_thread_attach(domain_); }
+
+bool GkMa::setSolver(const std::string& file, bool binary) {
+  attachThread();
+  if (ctor_file_ == NULL) {
+    ROS_ERROR_STREAM("Constructor OurSolver(string, bool) not found.");
+    return false;
+  }
+
   void* args[2];
   args[0] = mono_string_new(domain_, file.c_str());
   args[1] = &binary;
+  mono_runtime_invoke(ctor_file_, solver_, args, NULL);
+  return true;
+}
 
-  // Find constructor method.
-  void* iter = NULL;
-  MonoMethod* ctor = NULL;
-  while ((ctor = mono_class_get_methods(solver_class_, &iter))) {
-    if (strcmp(mono_method_get_name(ctor), ".ctor") == 0) {
-      // Check if the ctor takes two arguments.
-      MonoMethodSignature* sig = mono_method_signature(ctor);
-      if (mono_signature_get_param_count(sig) == 2) {
-        break;
-      }
-    }
+bool GkMa::setSolver(const Task& task) {
+  attachThread();
+  if (ctor_task_ == NULL) {
+    ROS_ERROR_STREAM(
+        "Constructor OurSolver(int[], int, int[][], bool) not found.");
+    return false;
+  }
+  if (!task.mIsSquare()) {
+    ROS_ERROR_STREAM("Cost matrix is not square.");
+    return false;
   }
 
-  mono_runtime_invoke(ctor, solver_, args, NULL);
+  void* args[4];
+  args[0] = matrixToFlatMonoArray(task.m);
+  int n = static_cast<int>(task.m.size());
+  args[1] = &n;
+  args[2] = vectorOfVectorToMonoArray(task.clusters);
+  bool is_symmetric = task.mIsSymmetric();
+  args[3] = &is_symmetric;
+  mono_runtime_invoke(ctor_task_, solver_, args, NULL);
+  return true;
 }
 
-void GkMa::setSolver(const Task& task) {
-  void* args[3];
-  args[0] = vectorOfVectorToMonoArray(task.m);
-  args[1] = vectorOfVectorToMonoArray(task.clusters);
-  bool is_symmetric = task.mIsSymmetric();
-  args[2] = &is_symmetric;
-
-  // Find constructor method.
-  void* iter = NULL;
-  MonoMethod* ctor = NULL;
-  while ((ctor = mono_class_get_methods(solver_class_, &iter))) {
-    if (strcmp(mono_method_get_name(ctor), ".ctor") == 0) {
-      // Check if the ctor takes two arguments.
-      MonoMethodSignature* sig = mono_method_signature(ctor);
-      if (mono_signature_get_param_count(sig) == 3) {
-        break;
-      }
-    }
+MonoArray* GkMa::matrixToFlatMonoArray(
+    const std::vector<std::vector<int>>& in) const {
+  const size_t n = in.size();
+  MonoArray* result = mono_array_new(domain_, mono_get_int32_class(), n * n);
+  for (size_t i = 0; i < n; ++i) {
+    if (in[i].empty()) continue;
+    std::memcpy(mono_array_addr(result, int, i * n), in[i].data(),
+                in[i].size() * sizeof(int));
   }
-
-  mono_runtime_invoke(ctor, solver_, args, NULL);
+  return result;
 }
 
 MonoArray* GkMa::vectorOfVectorToMonoArray(
@@ -108,64 +165,122 @@ MonoArray* GkMa::vectorOfVectorToMonoArray(
   for (size_t i = 0; i < in.size(); ++i) {
     MonoArray* row =
         mono_array_new(domain_, mono_get_int32_class(), in[i].size());
-    for (size_t j = 0; j < in[i].size(); ++j) {
-      mono_array_set(row, int, j, in[i][j]);
+    if (!in[i].empty()) {
+      std::memcpy(mono_array_addr(row, int, 0), in[i].data(),
+                  in[i].size() * sizeof(int));
     }
-    mono_array_set(result, MonoArray*, i, row);
+    mono_array_setref(result, i, row);
   }
   return result;
 }
 
 bool GkMa::solve() {
+  attachThread();
   // TODO(rikba): Check if solver ctor was called.
   if (!solver_) {
     ROS_ERROR_STREAM("Solver not set.");
     return false;
   }
-
-  // Find methods SolutionAtIndex(int index) and Solve().
-  void* iter = NULL;
-  MonoMethod* m = NULL;
-  MonoMethod* solve = NULL;
-  MonoMethod* solution_at_index = NULL;
-  while ((m = mono_class_get_methods(solver_class_, &iter))) {
-    if (strcmp(mono_method_get_name(m), "Solve") == 0) {
-      solve = m;
-    } else if (strcmp(mono_method_get_name(m), "SolutionAtIndex") == 0) {
-      solution_at_index = m;
-    }
-  }
-  if (solve == NULL || solution_at_index == NULL) {
-    ROS_ERROR_COND(solve == NULL, "Method Solve() not found.");
-    ROS_ERROR_COND(solution_at_index == NULL,
-                   "Method SolutionAtIndex(int index) not found.");
+  if (solve_ == NULL || get_solution_ == NULL) {
+    ROS_ERROR_COND(solve_ == NULL, "Method Solve() not found.");
+    ROS_ERROR_COND(get_solution_ == NULL, "Getter Solution() not found.");
     return false;
   }
 
   // Solve()
-  mono_runtime_invoke(solve, solver_, NULL, NULL);
+  mono_runtime_invoke(solve_, solver_, NULL, NULL);
 
-  // Solution().
-  MonoProperty* prop =
-      mono_class_get_property_from_name(solver_class_, "SolutionLength");
-  MonoMethod* solution_length = mono_property_get_get_method(prop);
-  if (solution_length == NULL) {
-    ROS_ERROR_STREAM("Getter SolutionLength() not found.");
+  // Copy the solution int[] at once.
+  MonoArray* solution = reinterpret_cast<MonoArray*>(
+      mono_runtime_invoke(get_solution_, solver_, NULL, NULL));
+  if (solution == NULL) {
+    ROS_ERROR_STREAM("No solution.");
+    return false;
+  }
+  solution_.resize(mono_array_length(solution));
+  if (!solution_.empty()) {
+    std::memcpy(solution_.data(), mono_array_addr(solution, int, 0),
+                solution_.size() * sizeof(int));
+  }
+
+  return true;
+}
+
+bool GkMa::getTask(std::vector<std::vector<int>>* m,
+                   std::vector<std::vector<int>>* clusters) const {
+  ROS_ASSERT(m);
+  ROS_ASSERT(clusters);
+  attachThread();
+  if (get_flat_weights_ == NULL || get_task_clusters_ == NULL) {
+    ROS_ERROR_COND(get_flat_weights_ == NULL,
+                   "Getter FlatWeights() not found.");
+    ROS_ERROR_COND(get_task_clusters_ == NULL,
+                   "Getter TaskClusters() not found.");
+    return false;
+  }
+
+  MonoArray* weights = reinterpret_cast<MonoArray*>(
+      mono_runtime_invoke(get_flat_weights_, solver_, NULL, NULL));
+  MonoArray* task_clusters = reinterpret_cast<MonoArray*>(
+      mono_runtime_invoke(get_task_clusters_, solver_, NULL, NULL));
+  if (weights == NULL || task_clusters == NULL) {
+    ROS_ERROR_STREAM("No task set.");
     return false;
   }
-  MonoObject* result =
-      mono_runtime_invoke(solution_length, solver_, NULL, NULL);
-  int num_nodes = *(int*)mono_object_unbox(result);
 
-  solution_.resize(num_nodes);
-  for (int i = 0; i < num_nodes; ++i) {
-    void* args[1];
-    args[0] = &i;
-    MonoObject* node =
-        mono_runtime_invoke(solution_at_index, solver_, args, NULL);
-    solution_[i] = *(int*)mono_object_unbox(node);
+  // Row-major n x n matrix.
+  size_t n = 0;
+  while (n * n < mono_array_length(weights)) n++;
+  m->assign(n, std::vector<int>(n));
+  for (size_t i = 0; i < n; ++i) {
+    std::memcpy((*m)[i].data(), mono_array_addr(weights, int, i * n),
+                n * sizeof(int));
   }
 
+  clusters->resize(mono_array_length(task_clusters));
+  for (size_t i = 0; i < clusters->size(); ++i) {
+    MonoArray* row = mono_array_get(task_clusters, MonoArray*, i);
+    (*clusters)[i].resize(mono_array_length(row));
+    if (!(*clusters)[i].empty()) {
+      std::memcpy((*clusters)[i].data(), mono_array_addr(row, int, 0),
+                  (*clusters)[i].size() * sizeof(int));
+    }
+  }
+  return true;
+}
+
+bool GkMaSolver::solveTask(const std::vector<std::vector<int>>& m,
+                           const std::vector<std::vector<int>>& clusters,
+                           const Clock::time_point& deadline,
+                           std::vector<int>* solution,
+                           GtspIncumbent* incumbent) const {
+  ROS_ASSERT(solution);
+  if (deadline == Clock::time_point::max()) {
+    solveGkMa(Task(m, clusters), solution);
+  } else {
+    // The worker owns its task and result, because it may outlive this call.
+    std::shared_ptr<const Task> task =
+        std::make_shared<const Task>(m, clusters);
+    std::shared_ptr<std::promise<std::vector<int>>> result =
+        std::make_shared<std::promise<std::vector<int>>>();
+    std::future<std::vector<int>> future = result->get_future();
+    std::thread([task, result]() {
+      std::vector<int> tour;
+      solveGkMa(*task, &tour);
+      result->set_value(tour);
+    }).detach();
+
+    if (future.wait_until(deadline) == std::future_status::timeout) {
+      ROS_WARN_STREAM("GK MA did not finish within the budget.");
+      return incumbent && incumbent->get(solution);
+    }
+    *solution = future.get();
+  }
+
+  if (solution->empty()) {
+    return false;
+  }
+  if (incumbent) incumbent->update(*solution, computeCost(m, *solution));
   return true;
 }
 
@@ -0,0 +1,94 @@
+#include "polygon_coverage_solvers/gtsp_solver.h"
+
+#include <ros/assert.h>
+#include <ros/console.h>
+
+namespace polygon_coverage_planning {
+
+std::chrono::steady_clock::time_point GtspBudget::computeDeadline() const {
+  typedef std::chrono::steady_clock Clock;
+  const Clock::time_point now = Clock::now();
+  const std::chrono::duration<double> max_duration =
+      Clock::time_point::max() - now;
+  if (max_time >= max_duration.count()) {
+    return Clock::time_point::max();
+  }
+  return now + std::chrono::duration_cast<Clock::duration>(
+                   std::chrono::duration<double>(max_time));
+}
+
+bool GtspIncumbent::update(const std::vector<int>& tour, int64_t cost) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (cost >= cost_) return false;
+  tour_ = tour;
+  cost_ = cost;
+  return true;
+}
+
+bool GtspIncumbent::get(std::vector<int>* tour, int64_t* cost) const {
+  ROS_ASSERT(tour);
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (tour_.empty()) return false;
+  *tour = tour_;
+  if (cost) *cost = cost_;
+  return true;
+}
+
+void GtspIncumbent::clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  tour_.clear();
+  cost_ = std::numeric_limits<int64_t>::max();
+}
+
+bool GtspSolver::solve(const std::vector<std::vector<int>>& m,
+                       const std::vector<std::vector<int>>& clusters,
+                       std::vector<int>* solution,
+                       GtspIncumbent* incumbent) const {
+  ROS_ASSERT(solution);
+  solution->clear();
+
+  // Check input.
+  for (const std::vector<int>& row : m) {
+    if (row.size() != m.size()) {
+      ROS_ERROR_STREAM("Cost matrix is not square.");
+      return false;
+    }
+  }
+  if (clusters.empty()) {
+    ROS_ERROR_STREAM("No clusters.");
+    return false;
+  }
+  std::vector<bool> is_clustered(m.size(), false);
+  for (size_t c = 0; c < clusters.size(); ++c) {
+    if (clusters[c].empty()) {
+      ROS_ERROR_STREAM("Cluster " << c << " is empty.");
+      return false;
+    }
+    for (int v : clusters[c]) {
+      if (v < 0 || static_cast<size_t>(v) >= m.size() || is_clustered[v]) {
+        ROS_ERROR_STREAM("Node " << v << " is not a unique cluster node.");
+        return false;
+      }
+      is_clustered[v] = true;
+    }
+  }
+
+  return solveTask(m, clusters, budget_.computeDeadline(), solution,
+                   incumbent);
+}
+
+int64_t GtspSolver::computeCost(const std::vector<std::vector<int>>& m,
+                                const std::vector<int>& tour) {
+  if (tour.size() < 2) return 0;
+  int64_t cost = 0;
+  for (size_t i = 0; i < tour.size(); ++i) {
+    const int w = m[tour[i]][tour[(i + 1) % tour.size()]];
+    if (w == std::numeric_limits<int>::max()) {
+      return std::numeric_limits<int64_t>::max();
+    }
+    cost += w;
+  }
+  return cost;
+}
+
+}  // namespace polygon_coverage_planning
@@ -0,0 +1,228 @@
+#include "polygon_coverage_solvers/held_karp.h"
+
+#include <algorithm>
+#include <limits>
+
+#include <ros/assert.h>
+#include <ros/console.h>
+
+#include "polygon_coverage_solvers/parallel_for.h"
+
+namespace polygon_coverage_planning {
+
+const size_t HeldKarp::kMaxNumClusters;
+
+namespace {
+typedef HeldKarp::ClusterMask ClusterMask;
+const double kInfinity = std::numeric_limits<double>::max();
+const uint32_t kNoParent = std::numeric_limits<uint32_t>::max();
+
+// One layer of the dynamic program, i.e., all cluster sets with the same number
+// of clusters. The sets are ordered by their bitmask which is identical to the
+// colexicographic order. A set's rank is given by the combinatorial number
+// system. Each set holds a block of all nodes of its clusters, ordered by
+// cluster.
+struct Layer {
+  std::vector<size_t> offsets;    // Begin of every set's block.
+  std::vector<double> cost;       // Cost of the path ending in a node.
+  std::vector<uint32_t> parents;  // The previous node on the path.
+};
+
+// The next bitmask with the same number of set bits. Gosper's hack.
+inline ClusterMask nextMask(ClusterMask mask) {
+  const ClusterMask c = mask & -mask;
+  const ClusterMask r = mask + c;
+  return (((r ^ mask) >> 2) / c) | r;
+}
+}  // namespace
+
+bool HeldKarp::solve(const std::vector<std::vector<double>>& cost,
+                     const std::vector<std::vector<size_t>>& clusters,
+                     size_t start, size_t goal, Solution* solution) const {
+  ROS_ASSERT(solution);
+  solution->clear();
+
+  // Check input.
+  const size_t num_nodes = cost.size();
+  const size_t n = clusters.size();
+  if (start >= num_nodes || goal >= num_nodes) {
+    ROS_ERROR_STREAM("Start or goal out of range.");
+    return false;
+  }
+  if (n > kMaxNumClusters) {
+    ROS_ERROR_STREAM("Dynamic program supports at most "
+                     << kMaxNumClusters << " clusters. Requested " << n
+                     << " clusters.");
+    return false;
+  }
+  if (num_nodes >= kNoParent) {
+    ROS_ERROR_STREAM("Too many nodes.");
+    return false;
+  }
+  for (const std::vector<double>& row : cost) {
+    if (row.size() != num_nodes) {
+      ROS_ERROR_STREAM("Cost matrix is not square.");
+      return false;
+    }
+  }
+  const size_t kNoCluster = std::numeric_limits<size_t>::max();
+  std::vector<size_t> cluster_of(num_nodes, kNoCluster);
+  for (size_t c = 0; c < n; ++c) {
+    if (clusters[c].empty()) {
+      ROS_ERROR_STREAM("Cluster " << c << " is empty.");
+      return false;
+    }
+    for (size_t v : clusters[c]) {
+      if (v >= num_nodes || v == start || v == goal ||
+          cluster_of[v] != kNoCluster) {
+        ROS_ERROR_STREAM("Node " << v << " is not a unique cluster node.");
+        return false;
+      }
+      cluster_of[v] = c;
+    }
+  }
+
+  // No clusters to visit.
+  if (n == 0) {
+    if (cost[start][goal] == kInfinity) return false;
+    *solution = {start, goal};
+    return true;
+  }
+
+  // Binomial coefficients to rank the cluster sets.
+  std::vector<std::vector<size_t>> binomial(n + 1,
+                                            std::vector<size_t>(n + 2, 0));
+  for (size_t i = 0; i <= n; ++i) {
+    binomial[i][0] = 1;
+    for (size_t j = 1; j <= i; ++j) {
+      binomial[i][j] = binomial[i - 1][j - 1] + binomial[i - 1][j];
+    }
+  }
+  auto rank = [&binomial](ClusterMask mask) {
+    size_t r = 0;
+    for (size_t i = 1; mask != 0; mask &= mask - 1, ++i) {
+      r += binomial[__builtin_ctzll(mask)][i];
+    }
+    return r;
+  };
+  auto bit = [](size_t c) { return static_cast<ClusterMask>(1) << c; };
+
+  // Layer k = 1: Paths from start to any cluster node.
+  std::vector<Layer> layers(n + 1);
+  {
+    Layer& layer = layers[1];
+    layer.offsets.assign(1, 0);
+    for (size_t c = 0; c < n; ++c) {
+      for (size_t w : clusters[c]) {
+        layer.cost.push_back(cost[start][w]);
+        layer.parents.push_back(cost[start][w] == kInfinity
+                                    ? kNoParent
+                                    : static_cast<uint32_t>(start));
+      }
+      layer.offsets.push_back(layer.cost.size());
+    }
+  }
+
+  // Layer k > 1.
+  for (size_t k = 2; k <= n; ++k) {
+    Layer& prev = layers[k - 1];
+    Layer& layer = layers[k];
+
+    // Enumerate all sets with k clusters and allocate their blocks.
+    std::vector<ClusterMask> masks;
+    masks.reserve(binomial[n][k]);
+    layer.offsets.reserve(binomial[n][k] + 1);
+    layer.offsets.assign(1, 0);
+    for (ClusterMask mask = bit(k) - 1; mask < bit(n); mask = nextMask(mask)) {
+      masks.push_back(mask);
+      size_t block_size = 0;
+      for (ClusterMask m = mask; m != 0; m &= m - 1) {
+        block_size += clusters[__builtin_ctzll(m)].size();
+      }
+      layer.offsets.push_back(layer.offsets.back() + block_size);
+    }
+    layer.cost.resize(layer.offsets.back());
+    layer.parents.resize(layer.offsets.back());
+
+    // Every set only reads the previous layer and writes its own block.
+    parallelFor(masks.size(), num_threads_, [&](size_t j) {
+      const ClusterMask mask = masks[j];
+      size_t pos = layer.offsets[j];
+      for (ClusterMask m = mask; m != 0; m &= m - 1) {
+        const size_t c = __builtin_ctzll(m);
+        const ClusterMask prev_mask = mask ^ bit(c);
+        const size_t prev_begin = prev.offsets[rank(prev_mask)];
+        for (size_t w : clusters[c]) {
+          double best_cost = kInfinity;
+          uint32_t best_parent = kNoParent;
+          size_t prev_pos = prev_begin;
+          for (ClusterMask pm = prev_mask; pm != 0; pm &= pm - 1) {
+            for (size_t v : clusters[__builtin_ctzll(pm)]) {
+              const double prev_cost = prev.cost[prev_pos++];
+              if (prev_cost == kInfinity || cost[v][w] == kInfinity) continue;
+              const double new_cost = prev_cost + cost[v][w];
+              if (new_cost < best_cost) {
+                best_cost = new_cost;
+                best_parent = static_cast<uint32_t>(v);
+              }
+            }
+          }
+          layer.cost[pos] = best_cost;
+          layer.parents[pos] = best_parent;
+          pos++;
+        }
+      }
+    });
+
+    // Release previous layer costs.
+    std::vector<double>().swap(prev.cost);
+  }
+
+  // Close the path to the goal.
+  const Layer& full = layers[n];
+  double best_cost = kInfinity;
+  size_t last = kNoCluster;
+  size_t pos = 0;
+  for (size_t c = 0; c < n; ++c) {
+    for (size_t v : clusters[c]) {
+      const double path_cost = full.cost[pos++];
+      if (path_cost == kInfinity || cost[v][goal] == kInfinity) continue;
+      if (path_cost + cost[v][goal] < best_cost) {
+        best_cost = path_cost + cost[v][goal];
+        last = v;
+      }
+    }
+  }
+  if (last == kNoCluster) {
+    ROS_ERROR_STREAM("No feasible GTSPP solution.");
+    return false;
+  }
+
+  // Backtrack.
+  solution->push_back(goal);
+  ClusterMask mask = bit(n) - 1;
+  size_t w = last;
+  for (size_t k = n; k > 0; --k) {
+    solution->push_back(w);
+    const size_t c = cluster_of[w];
+    // Position of w in the set's block.
+    size_t w_pos = layers[k].offsets[rank(mask)];
+    for (ClusterMask m = mask & (bit(c) - 1); m != 0; m &= m - 1) {
+      w_pos += clusters[__builtin_ctzll(m)].size();
+    }
+    w_pos += std::find(clusters[c].begin(), clusters[c].end(), w) -
+             clusters[c].begin();
+    ROS_ASSERT(layers[k].parents[w_pos] != kNoParent);
+    w = layers[k].parents[w_pos];
+    mask ^= bit(c);
+  }
+  ROS_ASSERT(w == start);
+  solution->push_back(start);
+  std::reverse(solution->begin(), solution->end());
+
+  ROS_DEBUG_STREAM("Solved GTSPP with " << n << " clusters and cost "
+                                        << best_cost << ".");
+  return true;
+}
+
+}  // namespace polygon_coverage_planning
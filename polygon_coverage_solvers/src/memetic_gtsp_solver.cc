@@ -0,0 +1,406 @@
+#include "polygon_coverage_solvers/memetic_gtsp_solver.h"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <random>
+
+#include <ros/assert.h>
+#include <ros/console.h>
+
+namespace polygon_coverage_planning {
+
+namespace {
+const int kNoEdge = std::numeric_limits<int>::max();
+// The cost of a non-existing edge. Any feasible tour is cheaper and the sum
+// over all edges of a tour does not overflow.
+const int64_t kPenalty = static_cast<int64_t>(1) << 40;
+
+// A cycle given by its sequence of nodes, one per cluster.
+typedef std::vector<int> Tour;
+
+struct Individual {
+  Tour tour;
+  int64_t cost;
+  bool operator<(const Individual& other) const { return cost < other.cost; }
+};
+
+// The state of one solve() call.
+class MemeticSearch {
+ public:
+  MemeticSearch(const std::vector<std::vector<int>>& m,
+                const std::vector<std::vector<int>>& clusters,
+                const std::vector<int>& cluster_of, bool is_symmetric,
+                const MemeticGtspSolver::Settings& settings,
+                size_t max_generations)
+      : m_(m),
+        clusters_(clusters),
+        cluster_of_(cluster_of),
+        is_symmetric_(is_symmetric),
+        settings_(settings),
+        max_generations_(max_generations),
+        rng_(settings.seed) {}
+
+  // Evolve the population until it stalls or the budget is exhausted.
+  // incumbent: optional, receives every feasible improvement.
+  Individual run(const std::chrono::steady_clock::time_point& deadline,
+                 GtspIncumbent* incumbent);
+
+ private:
+  inline int64_t cost(int from, int to) const {
+    return m_[from][to] == kNoEdge ? kPenalty : m_[from][to];
+  }
+  int64_t tourCost(const Tour& tour) const;
+
+  Tour createRandomTour();
+  // Take a random fragment of a and complete it in the cluster order of b.
+  Tour crossover(const Tour& a, const Tour& b);
+  // Reverse a random segment.
+  void mutate(Tour* tour);
+  // Apply all local improvements until none of them succeeds.
+  void improve(Tour* tour) const;
+  // Remove a node and reinsert the best node of its cluster at the best
+  // position.
+  bool improveInsertion(Tour* tour) const;
+  // Classic 2-opt. Only valid for symmetric costs.
+  bool improveTwoOpt(Tour* tour) const;
+  // Choose the optimal node of every cluster for the given cluster order.
+  // Shortest cycle through the layered cluster graph. The first layer is the
+  // smallest cluster.
+  bool optimizeClusters(Tour* tour) const;
+  // Binary tournament.
+  const Individual& select(const std::vector<Individual>& population);
+  // Add an individual if no individual with the same cost exists.
+  bool addUnique(const Individual& individual,
+                 std::vector<Individual>* population) const;
+
+  const std::vector<std::vector<int>>& m_;
+  const std::vector<std::vector<int>>& clusters_;
+  const std::vector<int>& cluster_of_;
+  const bool is_symmetric_;
+  const MemeticGtspSolver::Settings& settings_;
+  const size_t max_generations_;
+  std::mt19937 rng_;
+};
+
+int64_t MemeticSearch::tourCost(const Tour& tour) const {
+  if (tour.size() < 2) return 0;
+  int64_t result = cost(tour.back(), tour.front());
+  for (size_t i = 0; i + 1 < tour.size(); ++i) {
+    result += cost(tour[i], tour[i + 1]);
+  }
+  return result;
+}
+
+Tour MemeticSearch::createRandomTour() {
+  std::vector<size_t> order(clusters_.size());
+  for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+  std::shuffle(order.begin(), order.end(), rng_);
+
+  Tour tour(order.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    const std::vector<int>& cluster = clusters_[order[i]];
+    std::uniform_int_distribution<size_t> node(0, cluster.size() - 1);
+    tour[i] = cluster[node(rng_)];
+  }
+  return tour;
+}
+
+Tour MemeticSearch::crossover(const Tour& a, const Tour& b) {
+  const size_t n = a.size();
+  std::uniform_int_distribution<size_t> start_dist(0, n - 1);
+  std::uniform_int_distribution<size_t> length_dist(1, n - 1);
+  const size_t start = start_dist(rng_);
+  const size_t length = length_dist(rng_);
+
+  Tour child;
+  child.reserve(n);
+  std::vector<bool> has_cluster(clusters_.size(), false);
+  for (size_t i = 0; i < length; ++i) {
+    const int v = a[(start + i) % n];
+    child.push_back(v);
+    has_cluster[cluster_of_[v]] = true;
+  }
+  for (int v : b) {
+    if (!has_cluster[cluster_of_[v]]) child.push_back(v);
+  }
+  return child;
+}
+
+void MemeticSearch::mutate(Tour* tour) {
+  ROS_ASSERT(tour);
+  std::uniform_int_distribution<size_t> position(0, tour->size() - 1);
+  size_t i = position(rng_);
+  size_t j = position(rng_);
+  if (i > j) std::swap(i, j);
+  std::reverse(tour->begin() + i, tour->begin() + j + 1);
+}
+
+void MemeticSearch::improve(Tour* tour) const {
+  ROS_ASSERT(tour);
+  bool improved = true;
+  while (improved) {
+    improved = false;
+    while (improveInsertion(tour)) improved = true;
+    while (is_symmetric_ && improveTwoOpt(tour)) improved = true;
+    improved = optimizeClusters(tour) || improved;
+  }
+}
+
+bool MemeticSearch::improveInsertion(Tour* tour) const {
+  ROS_ASSERT(tour);
+  const size_t n = tour->size();
+  if (n < 3) return false;
+
+  bool improved = false;
+  for (size_t i = 0; i < n; ++i) {
+    const int v = (*tour)[i];
+    const int prev = (*tour)[(i + n - 1) % n];
+    const int next = (*tour)[(i + 1) % n];
+    const int64_t removal_gain =
+        cost(prev, v) + cost(v, next) - cost(prev, next);
+
+    // Best reinsertion into the remaining cycle of n - 1 nodes.
+    auto rest = [tour, i](size_t j) { return (*tour)[j < i ? j : j + 1]; };
+    int64_t best_delta = removal_gain;
+    size_t best_position = n;
+    int best_node = v;
+    for (size_t j = 0; j + 1 < n; ++j) {
+      const int x = rest(j);
+      const int y = rest((j + 1) % (n - 1));
+      const int64_t base = cost(x, y);
+      for (int w : clusters_[cluster_of_[v]]) {
+        const int64_t delta = cost(x, w) + cost(w, y) - base;
+        if (delta < best_delta) {
+          best_delta = delta;
+          best_position = j + 1;
+          best_node = w;
+        }
+      }
+    }
+    if (best_position < n) {
+      tour->erase(tour->begin() + i);
+      tour->insert(tour->begin() + best_position, best_node);
+      improved = true;
+    }
+  }
+  return improved;
+}
+
+bool MemeticSearch::improveTwoOpt(Tour* tour) const {
+  ROS_ASSERT(tour);
+  const size_t n = tour->size();
+  if (n < 4) return false;
+
+  bool improved = false;
+  for (size_t i = 0; i + 2 < n; ++i) {
+    for (size_t j = i + 2; j < n; ++j) {
+      const size_t j_next = (j + 1) % n;
+      if (j_next == i) continue;
+      const int a = (*tour)[i], b = (*tour)[i + 1];
+      const int c = (*tour)[j], d = (*tour)[j_next];
+      const int64_t delta = cost(a, c) + cost(b, d) - cost(a, b) - cost(c, d);
+      if (delta < 0) {
+        std::reverse(tour->begin() + i + 1, tour->begin() + j + 1);
+        improved = true;
+      }
+    }
+  }
+  return improved;
+}
+
+bool MemeticSearch::optimizeClusters(Tour* tour) const {
+  ROS_ASSERT(tour);
+  const size_t n = tour->size();
+  if (n < 2) return false;
+
+  // Rotate such that the smallest cluster comes first.
+  size_t first = 0;
+  for (size_t i = 1; i < n; ++i) {
+    if (clusters_[cluster_of_[(*tour)[i]]].size() <
+        clusters_[cluster_of_[(*tour)[first]]].size()) {
+      first = i;
+    }
+  }
+  std::vector<const std::vector<int>*> layers(n);
+  for (size_t i = 0; i < n; ++i) {
+    layers[i] = &clusters_[cluster_of_[(*tour)[(first + i) % n]]];
+  }
+
+  const int64_t old_cost = tourCost(*tour);
+  int64_t best_cost = old_cost;
+  Tour best_tour;
+  std::vector<std::vector<int64_t>> dist(n);
+  std::vector<std::vector<size_t>> parent(n);
+  for (size_t i = 1; i < n; ++i) {
+    dist[i].resize(layers[i]->size());
+    parent[i].resize(layers[i]->size());
+  }
+  for (int s : *layers[0]) {
+    for (size_t k = 0; k < layers[1]->size(); ++k) {
+      dist[1][k] = cost(s, (*layers[1])[k]);
+    }
+    for (size_t i = 2; i < n; ++i) {
+      for (size_t k = 0; k < layers[i]->size(); ++k) {
+        const int w = (*layers[i])[k];
+        int64_t best = std::numeric_limits<int64_t>::max();
+        for (size_t l = 0; l < layers[i - 1]->size(); ++l) {
+          const int64_t d = dist[i - 1][l] + cost((*layers[i - 1])[l], w);
+          if (d < best) {
+            best = d;
+            parent[i][k] = l;
+          }
+        }
+        dist[i][k] = best;
+      }
+    }
+    // Close the cycle.
+    size_t last = 0;
+    int64_t cycle_cost = std::numeric_limits<int64_t>::max();
+    for (size_t k = 0; k < layers[n - 1]->size(); ++k) {
+      const int64_t d = dist[n - 1][k] + cost((*layers[n - 1])[k], s);
+      if (d < cycle_cost) {
+        cycle_cost = d;
+        last = k;
+      }
+    }
+    if (cycle_cost < best_cost) {
+      best_cost = cycle_cost;
+      best_tour.assign(n, s);
+      for (size_t i = n - 1; i > 0; --i) {
+        best_tour[i] = (*layers[i])[last];
+        last = parent[i][last];
+      }
+    }
+  }
+
+  if (best_cost < old_cost) {
+    tour->swap(best_tour);
+    return true;
+  }
+  return false;
+}
+
+const Individual& MemeticSearch::select(
+    const std::vector<Individual>& population) {
+  std::uniform_int_distribution<size_t> index(0, population.size() - 1);
+  const Individual& a = population[index(rng_)];
+  const Individual& b = population[index(rng_)];
+  return a.cost <= b.cost ? a : b;
+}
+
+bool MemeticSearch::addUnique(const Individual& individual,
+                              std::vector<Individual>* population) const {
+  ROS_ASSERT(population);
+  for (const Individual& other : *population) {
+    if (other.cost == individual.cost) return false;
+  }
+  population->push_back(individual);
+  return true;
+}
+
+Individual MemeticSearch::run(
+    const std::chrono::steady_clock::time_point& deadline,
+    GtspIncumbent* incumbent) {
+  const size_t population_size = std::max<size_t>(1, settings_.population_size);
+  // Give up filling a population with unique tours after some attempts.
+  const size_t max_attempts = 3 * population_size;
+
+  auto is_expired = [&deadline]() {
+    return std::chrono::steady_clock::now() > deadline;
+  };
+  auto report = [incumbent](const Individual& best) {
+    if (incumbent && best.cost < kPenalty) {
+      incumbent->update(best.tour, best.cost);
+    }
+  };
+
+  // Create at least one tour, even if the budget is exhausted.
+  std::vector<Individual> population;
+  for (size_t i = 0; i < max_attempts && population.size() < population_size &&
+                     (population.empty() || !is_expired());
+       ++i) {
+    Individual individual;
+    individual.tour = createRandomTour();
+    improve(&individual.tour);
+    individual.cost = tourCost(individual.tour);
+    addUnique(individual, &population);
+  }
+  std::sort(population.begin(), population.end());
+  report(population.front());
+  if (clusters_.size() < 2) return population.front();
+
+  std::uniform_real_distribution<double> probability(0.0, 1.0);
+  size_t num_stall_generations = 0;
+  for (size_t generation = 0;
+       generation < max_generations_ &&
+       num_stall_generations < settings_.max_stall_generations && !is_expired();
+       ++generation) {
+    const int64_t best_cost = population.front().cost;
+
+    std::vector<Individual> next(
+        population.begin(),
+        population.begin() + std::min(settings_.num_elite, population.size()));
+    for (size_t i = 0; i < max_attempts && next.size() < population_size &&
+                       !is_expired();
+         ++i) {
+      Individual child;
+      child.tour =
+          crossover(select(population).tour, select(population).tour);
+      if (probability(rng_) < settings_.mutation_probability) {
+        mutate(&child.tour);
+      }
+      improve(&child.tour);
+      child.cost = tourCost(child.tour);
+      addUnique(child, &next);
+    }
+    std::sort(next.begin(), next.end());
+    population.swap(next);
+
+    if (population.front().cost < best_cost) {
+      report(population.front());
+      num_stall_generations = 0;
+    } else {
+      num_stall_generations++;
+    }
+  }
+
+  return population.front();
+}
+}  // namespace
+
+bool MemeticGtspSolver::solveTask(
+    const std::vector<std::vector<int>>& m,
+    const std::vector<std::vector<int>>& clusters,
+    const Clock::time_point& deadline, std::vector<int>* solution,
+    GtspIncumbent* incumbent) const {
+  ROS_ASSERT(solution);
+  solution->clear();
+
+  std::vector<int> cluster_of(m.size(), -1);
+  for (size_t c = 0; c < clusters.size(); ++c) {
+    for (int v : clusters[c]) cluster_of[v] = static_cast<int>(c);
+  }
+  bool is_symmetric = true;
+  for (size_t i = 0; i < m.size() && is_symmetric; ++i) {
+    for (size_t j = 0; j < i && is_symmetric; ++j) {
+      is_symmetric = m[i][j] == m[j][i];
+    }
+  }
+
+  MemeticSearch search(m, clusters, cluster_of, is_symmetric, settings_,
+                       budget_.max_generations);
+  const Individual best = search.run(deadline, incumbent);
+  if (best.cost >= kPenalty) {
+    ROS_ERROR_STREAM("No feasible GTSP solution.");
+    return false;
+  }
+
+  *solution = best.tour;
+  ROS_DEBUG_STREAM("Solved GTSP with " << clusters.size()
+                                       << " clusters and cost " << best.cost
+                                       << ".");
+  return true;
+}
+
+}  // namespace polygon_coverage_planning
@@ -0,0 +1,124 @@
+#include "polygon_coverage_solvers/priority_queue.h"
+
+#include <algorithm>
+#include <limits>
+
+#include <ros/assert.h>
+
+namespace polygon_coverage_planning {
+
+const size_t IndexedBinaryHeap::kNotInHeap =
+    std::numeric_limits<size_t>::max();
+
+IndexedBinaryHeap::IndexedBinaryHeap(size_t capacity)
+    : position_(capacity, kNotInHeap),
+      key_(capacity, std::numeric_limits<double>::max()) {
+  heap_.reserve(capacity);
+}
+
+void IndexedBinaryHeap::push(size_t id, double key) {
+  ROS_ASSERT(id < position_.size());
+  if (contains(id)) {
+    const double old_key = key_[id];
+    key_[id] = key;
+    if (key < old_key) {
+      siftUp(position_[id]);
+    } else if (key > old_key) {
+      siftDown(position_[id]);
+    }
+  } else {
+    key_[id] = key;
+    position_[id] = heap_.size();
+    heap_.push_back(id);
+    siftUp(heap_.size() - 1);
+  }
+}
+
+size_t IndexedBinaryHeap::pop() {
+  ROS_ASSERT(!heap_.empty());
+  const size_t top = heap_.front();
+  swap(0, heap_.size() - 1);
+  heap_.pop_back();
+  position_[top] = kNotInHeap;
+  if (!heap_.empty()) siftDown(0);
+  return top;
+}
+
+bool IndexedBinaryHeap::less(size_t a, size_t b) const {
+  const size_t id_a = heap_[a];
+  const size_t id_b = heap_[b];
+  if (key_[id_a] != key_[id_b]) return key_[id_a] < key_[id_b];
+  return id_a < id_b;
+}
+
+void IndexedBinaryHeap::swap(size_t a, size_t b) {
+  std::swap(heap_[a], heap_[b]);
+  position_[heap_[a]] = a;
+  position_[heap_[b]] = b;
+}
+
+void IndexedBinaryHeap::siftUp(size_t pos) {
+  while (pos > 0) {
+    const size_t parent = (pos - 1) / 2;
+    if (!less(pos, parent)) break;
+    swap(pos, parent);
+    pos = parent;
+  }
+}
+
+void IndexedBinaryHeap::siftDown(size_t pos) {
+  while (true) {
+    const size_t left = 2 * pos + 1;
+    const size_t right = left + 1;
+    size_t smallest = pos;
+    if (left < heap_.size() && less(left, smallest)) smallest = left;
+    if (right < heap_.size() && less(right, smallest)) smallest = right;
+    if (smallest == pos) break;
+    swap(pos, smallest);
+    pos = smallest;
+  }
+}
+
+RadixHeap::RadixHeap()
+    : buckets_(std::numeric_limits<uint64_t>::digits + 1), last_(0), size_(0) {}
+
+size_t RadixHeap::bucketIndex(uint64_t key) const {
+  // Bucket i > 0 holds all keys whose highest bit differing from last_ is
+  // bit i - 1.
+  return key == last_ ? 0
+                      : std::numeric_limits<uint64_t>::digits -
+                            __builtin_clzll(key ^ last_);
+}
+
+void RadixHeap::push(size_t id, uint64_t key) {
+  key = std::max(key, last_);  // Keep monotonicity.
+  buckets_[bucketIndex(key)].emplace_back(key, id);
+  size_++;
+}
+
+RadixHeap::Entry RadixHeap::pop() {
+  ROS_ASSERT(size_ > 0);
+  if (buckets_.front().empty()) {
+    // Find first non-empty bucket and redistribute it with its minimum key.
+    size_t i = 1;
+    while (buckets_[i].empty()) i++;
+    std::vector<Entry> bucket;
+    bucket.swap(buckets_[i]);
+    last_ = std::min_element(bucket.begin(), bucket.end())->first;
+    for (const Entry& e : bucket) {
+      buckets_[bucketIndex(e.first)].push_back(e);
+    }
+  }
+
+  // All entries in the first bucket share the same key. Break ties by id.
+  std::vector<Entry>& front = buckets_.front();
+  std::vector<Entry>::iterator min_it = std::min_element(front.begin(),
+                                                         front.end());
+  const Entry result = *min_it;
+  *min_it = front.back();
+  front.pop_back();
+  size_--;
+  return result;
+}
+
+}  // namespace polygon_coverage_planning
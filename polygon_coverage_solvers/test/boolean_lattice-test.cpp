@@ -0,0 +1,96 @@
+#include <algorithm>
+#include <limits>
+
+#include <gtest/gtest.h>
+
+#include "polygon_coverage_solvers/boolean_lattice.h"
+
+using namespace polygon_coverage_planning;
+using namespace boolean_lattice;
+
+TEST(BooleanLatticeTest, Create) {
+  const size_t kNumClusters = 3;
+  BooleanLattice lattice(kNumClusters);
+  ASSERT_TRUE(lattice.isInitialized());
+  EXPECT_EQ(lattice.size(), 8);
+
+  // n * 2^(n-1) edges.
+  size_t num_edges = 0;
+  for (size_t i = 0; i < lattice.size(); ++i) {
+    std::vector<size_t> successors;
+    lattice.getSuccessors(i, &successors);
+    for (size_t j = 0; j < lattice.size(); ++j) {
+      const bool is_successor =
+          std::find(successors.begin(), successors.end(), j) !=
+          successors.end();
+      EXPECT_EQ(lattice.edgeExists(EdgeId(i, j)), is_successor);
+      num_edges += is_successor;
+    }
+  }
+  EXPECT_EQ(num_edges, 12);
+
+  EXPECT_TRUE(lattice.edgeExists(EdgeId(0b000, 0b010)));
+  EXPECT_TRUE(lattice.edgeExists(EdgeId(0b101, 0b111)));
+  EXPECT_FALSE(lattice.edgeExists(EdgeId(0b001, 0b010)));
+  EXPECT_FALSE(lattice.edgeExists(EdgeId(0b001, 0b111)));
+  EXPECT_FALSE(lattice.edgeExists(EdgeId(0b011, 0b001)));
+  EXPECT_TRUE(lattice.includesCluster(0b101, 2));
+  EXPECT_FALSE(lattice.includesCluster(0b101, 1));
+}
+
+TEST(BooleanLatticeTest, StartAndGoal) {
+  const size_t kNumClusters = 3;
+  BooleanLattice lattice(kNumClusters);
+  ASSERT_TRUE(lattice.addStartNode());
+  ASSERT_TRUE(lattice.addGoalNode());
+  EXPECT_EQ(lattice.size(), 10);
+  EXPECT_EQ(lattice.getStartIdx(), 8);
+  EXPECT_EQ(lattice.getGoalIdx(), 9);
+  EXPECT_EQ(lattice.getStartCluster(), 3);
+  EXPECT_EQ(lattice.getGoalCluster(), 4);
+
+  // Start node visits nothing, regular nodes visit the start cluster.
+  for (size_t c = 0; c < 5; ++c) {
+    EXPECT_FALSE(lattice.includesCluster(lattice.getStartIdx(), c));
+    EXPECT_TRUE(lattice.includesCluster(lattice.getGoalIdx(), c));
+  }
+  EXPECT_TRUE(lattice.includesCluster(0, lattice.getStartCluster()));
+  EXPECT_FALSE(lattice.includesCluster(0b111, lattice.getGoalCluster()));
+
+  EXPECT_TRUE(lattice.edgeExists(EdgeId(lattice.getStartIdx(), 0)));
+  EXPECT_FALSE(lattice.edgeExists(EdgeId(lattice.getStartIdx(), 1)));
+  EXPECT_TRUE(lattice.edgeExists(EdgeId(0b111, lattice.getGoalIdx())));
+  EXPECT_FALSE(lattice.edgeExists(EdgeId(0b011, lattice.getGoalIdx())));
+  double cost = -1.0;
+  EXPECT_TRUE(lattice.getEdgeCost(EdgeId(0b111, lattice.getGoalIdx()), &cost));
+  EXPECT_EQ(cost, 0.0);
+
+  const size_t kNone = std::numeric_limits<size_t>::max();
+  EXPECT_EQ(lattice.getSuccessor(lattice.getStartIdx(),
+                                 lattice.getStartCluster()),
+            0);
+  EXPECT_EQ(lattice.getSuccessor(lattice.getStartIdx(), 0), kNone);
+  EXPECT_EQ(lattice.getSuccessor(0b001, 1), 0b011);
+  EXPECT_EQ(lattice.getSuccessor(0b001, 0), kNone);
+  EXPECT_EQ(lattice.getSuccessor(0b111, lattice.getGoalCluster()),
+            lattice.getGoalIdx());
+  EXPECT_EQ(lattice.getSuccessor(0b011, lattice.getGoalCluster()), kNone);
+}
+
+TEST(BooleanLatticeTest, ManyClusters) {
+  // 20+ clusters do not materialize any adjacency.
+  BooleanLattice lattice(40);
+  ASSERT_TRUE(lattice.isInitialized());
+  EXPECT_EQ(lattice.size(), static_cast<size_t>(1) << 40);
+  std::vector<size_t> successors;
+  lattice.getSuccessors(0, &successors);
+  EXPECT_EQ(successors.size(), 40);
+
+  EXPECT_FALSE(BooleanLattice(BooleanLattice::kMaxNumClusters + 1)
+                   .isInitialized());
+}
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <limits>
 #include <random>
 #include <vector>
@@ -27,7 +28,7 @@ TEST(GkMa, LoadFromFile) {
                                              "40d198.gtsp", "65rbg323.gtsp"};
   for (const std::string& instance_name : instance_names) {
     std::string file = instances_path + instance_name;
-    instance.setSolver(file, true);
+    EXPECT_TRUE(instance.setSolver(file, true));
     EXPECT_TRUE(instance.solve());
     EXPECT_FALSE(instance.getSolution().empty());
   }
@@ -64,10 +65,69 @@ TEST(GkMa, LoadFromTask) {
   Task task(m, clusters);
   EXPECT_FALSE(task.mIsSymmetric());
 
-  instance.setSolver(task);
+  EXPECT_TRUE(instance.setSolver(task));
   EXPECT_TRUE(instance.solve());
   std::vector<int> solution = instance.getSolution();
   EXPECT_EQ(solution.size(), clusters.size());
+
+  // Exactly one node per cluster.
+  for (const std::vector<int>& cluster : clusters) {
+    size_t num_visits = 0;
+    for (int v : solution) {
+      num_visits += std::count(cluster.begin(), cluster.end(), v);
+    }
+    EXPECT_EQ(num_visits, 1);
+  }
+
+  // Non-square cost matrix.
+  m.back().pop_back();
+  EXPECT_FALSE(instance.setSolver(Task(m, clusters)));
+}
+
+TEST(GkMa, Budget) {
+  GkMa& instance = GkMa::getInstance();
+
+  // Package directory.
+  std::string instances_path = ros::package::getPath(kPackageName);
+  // Catkin directory.
+  instances_path = instances_path.substr(0, instances_path.find("/src/"));
+  // Instances directory.
+  instances_path +=
+      "/build/" + kPackageName + "/gtsp_instances-prefix/src/gtsp_instances/";
+  ASSERT_TRUE(instance.setSolver(instances_path + "65rbg323.gtsp", true));
+  std::vector<std::vector<int>> m;
+  std::vector<std::vector<int>> clusters;
+  ASSERT_TRUE(instance.getTask(&m, &clusters));
+
+  // Visit the clusters in order. A feasible tour, because m is complete.
+  std::vector<int> seed_tour;
+  for (const std::vector<int>& cluster : clusters) {
+    seed_tour.push_back(cluster.front());
+  }
+  const int64_t seed_cost = GtspSolver::computeCost(m, seed_tour);
+  ASSERT_LT(seed_cost, std::numeric_limits<int64_t>::max());
+
+  // GK MA cannot finish in time. Return at the deadline with the incumbent,
+  // if any. The following solve without budget waits for the background
+  // worker of the timed out solve.
+  GkMaSolver solver;
+  std::vector<int> solution;
+  solver.setBudget(GtspBudget(1e-3));
+  EXPECT_FALSE(solver.solve(m, clusters, &solution));
+  solver.setBudget(GtspBudget());
+  EXPECT_TRUE(solver.solve(m, clusters, &solution));
+
+  GtspIncumbent incumbent;
+  incumbent.update(seed_tour, seed_cost);
+  solver.setBudget(GtspBudget(1e-3));
+  EXPECT_TRUE(solver.solve(m, clusters, &solution, &incumbent));
+  EXPECT_EQ(seed_tour, solution);
+  solver.setBudget(GtspBudget());
+  EXPECT_TRUE(solver.solve(m, clusters, &solution, &incumbent));
+  EXPECT_EQ(clusters.size(), solution.size());
+  int64_t cost = 0;
+  EXPECT_TRUE(incumbent.get(&solution, &cost));
+  EXPECT_LE(cost, seed_cost);
 }
 
 int main(int argc, char** argv) {
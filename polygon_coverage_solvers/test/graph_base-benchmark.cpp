@@ -0,0 +1,136 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <vector>
+
+#include "polygon_coverage_solvers/graph_base.h"
+
+using namespace polygon_coverage_planning;
+
+// Compares the dense node and edge property lookup of a frozen graph with the
+// former ordered map storage.
+
+const size_t kSeed = 123456;
+const size_t kNumNodes = 200;
+const size_t kNumNeighbors = 6;
+const size_t kNumLookups = 1000000;
+
+namespace benchmark_graph {
+struct NodeProperty {
+  NodeProperty() : x(0.0), y(0.0) {}
+  NodeProperty(double x, double y) : x(x), y(y) {}
+  double x;
+  double y;
+};
+struct EdgeProperty {};
+
+// A random graph with unit edge costs.
+class RandomGraph : public GraphBase<NodeProperty, EdgeProperty> {
+ public:
+  RandomGraph(size_t num_nodes) : GraphBase(), num_nodes_(num_nodes) {
+    is_created_ = create();
+  }
+
+  virtual bool create() override {
+    clear();
+    for (size_t i = 0; i < num_nodes_; ++i) {
+      if (!addNode(NodeProperty(std::rand() % 100, std::rand() % 100))) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+ private:
+  virtual bool addEdges() override {
+    const size_t new_id = graph_.size() - 1;
+    for (size_t i = 0; i < kNumNeighbors && new_id > 0; ++i) {
+      const size_t adj_id = std::rand() % new_id;
+      if (!addEdge(EdgeId(new_id, adj_id), EdgeProperty(), 1.0) ||
+          !addEdge(EdgeId(adj_id, new_id), EdgeProperty(), 1.0)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  virtual bool calculateHeuristic(size_t goal,
+                                  Heuristic* heuristic) const override {
+    for (size_t i = 0; i < graph_.size(); ++i) {
+      (*heuristic)[i] = 0.0;
+    }
+    return true;
+  }
+
+  size_t num_nodes_;
+};
+}  // namespace benchmark_graph
+
+int main() {
+  std::srand(kSeed);
+  benchmark_graph::RandomGraph graph(kNumNodes);
+  if (!graph.isInitialized()) {
+    std::cerr << "Failed to create graph." << std::endl;
+    return 1;
+  }
+  graph.freeze();
+
+  // Reference: the former ordered map storage with count plus at lookup.
+  std::map<size_t, benchmark_graph::NodeProperty> node_map;
+  std::map<EdgeId, benchmark_graph::EdgeProperty> edge_map;
+  std::vector<EdgeId> edges;
+  for (size_t i = 0; i < graph.size(); ++i) {
+    node_map[i] = *graph.getNodeProperty(i);
+    for (size_t j = 0; j < graph.size(); ++j) {
+      if (graph.edgeExists(EdgeId(i, j))) {
+        edge_map[EdgeId(i, j)] = *graph.getEdgeProperty(EdgeId(i, j));
+        edges.push_back(EdgeId(i, j));
+      }
+    }
+  }
+  if (edges.empty()) {
+    std::cerr << "Graph has no edges." << std::endl;
+    return 1;
+  }
+
+  double sum_map = 0.0;
+  size_t num_edges_map = 0;
+  std::chrono::high_resolution_clock::time_point t0 =
+      std::chrono::high_resolution_clock::now();
+  for (size_t i = 0; i < kNumLookups; ++i) {
+    const size_t id = i % kNumNodes;
+    if (node_map.count(id) > 0) sum_map += node_map.at(id).x;
+    const EdgeId& edge = edges[i % edges.size()];
+    if (edge_map.count(edge) > 0) num_edges_map++;
+  }
+  std::chrono::high_resolution_clock::time_point t1 =
+      std::chrono::high_resolution_clock::now();
+
+  double sum_dense = 0.0;
+  size_t num_edges_dense = 0;
+  for (size_t i = 0; i < kNumLookups; ++i) {
+    const size_t id = i % kNumNodes;
+    sum_dense += graph.getNodeProperty(id)->x;
+    const EdgeId& edge = edges[i % edges.size()];
+    if (graph.getEdgeProperty(edge) != nullptr) num_edges_dense++;
+  }
+  std::chrono::high_resolution_clock::time_point t2 =
+      std::chrono::high_resolution_clock::now();
+
+  // Also prevents the compiler from dropping the loops.
+  if (sum_map != sum_dense || num_edges_map != num_edges_dense) {
+    std::cerr << "Lookup results differ." << std::endl;
+    return 1;
+  }
+
+  const double map_ms =
+      std::chrono::duration<double, std::milli>(t1 - t0).count();
+  const double dense_ms =
+      std::chrono::duration<double, std::milli>(t2 - t1).count();
+  std::cout << kNumLookups << " node and edge property lookups on "
+            << graph.size() << " nodes and " << edges.size()
+            << " edges. std::map: " << map_ms << " ms, dense: " << dense_ms
+            << " ms." << std::endl;
+  return 0;
+}
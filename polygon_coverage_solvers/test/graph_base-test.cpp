@@ -0,0 +1,217 @@
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "polygon_coverage_solvers/graph_base.h"
+#include "polygon_coverage_solvers/priority_queue.h"
+
+using namespace polygon_coverage_planning;
+
+const size_t kSeed = 123456;
+const size_t kNumNodes = 200;
+const size_t kNumNeighbors = 6;
+const size_t kNumQueries = 50;
+
+namespace test_graph {
+struct NodeProperty {
+  NodeProperty() : x(0.0), y(0.0) {}
+  NodeProperty(double x, double y) : x(x), y(y) {}
+  double x;
+  double y;
+};
+struct EdgeProperty {};
+
+// A random geometric graph with Euclidean edge costs.
+class RandomGraph : public GraphBase<NodeProperty, EdgeProperty> {
+ public:
+  RandomGraph(size_t num_nodes) : GraphBase(), num_nodes_(num_nodes) {
+    is_created_ = create();
+  }
+
+  virtual bool create() override {
+    clear();
+    for (size_t i = 0; i < num_nodes_; ++i) {
+      // Integer coordinates provoke ties.
+      if (!addNode(NodeProperty(std::rand() % 100, std::rand() % 100))) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+ private:
+  virtual bool addEdges() override {
+    const size_t new_id = graph_.size() - 1;
+    for (size_t i = 0; i < kNumNeighbors && new_id > 0; ++i) {
+      const size_t adj_id = std::rand() % new_id;
+      const double cost = distance(new_id, adj_id);
+      if (!addEdge(EdgeId(new_id, adj_id), EdgeProperty(), cost) ||
+          !addEdge(EdgeId(adj_id, new_id), EdgeProperty(), cost)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  virtual bool calculateHeuristic(size_t goal,
+                                  Heuristic* heuristic) const override {
+    for (size_t i = 0; i < graph_.size(); ++i) {
+      (*heuristic)[i] = distance(i, goal);
+    }
+    return true;
+  }
+
+  double distance(size_t a, size_t b) const {
+    const NodeProperty* p_a = getNodeProperty(a);
+    const NodeProperty* p_b = getNodeProperty(b);
+    return std::sqrt((p_a->x - p_b->x) * (p_a->x - p_b->x) +
+                     (p_a->y - p_b->y) * (p_a->y - p_b->y));
+  }
+
+  size_t num_nodes_;
+};
+}  // namespace test_graph
+
+double computeCost(const test_graph::RandomGraph& graph,
+                   const Solution& solution) {
+  double cost = 0.0;
+  for (size_t i = 0; i + 1 < solution.size(); ++i) {
+    double edge_cost;
+    EXPECT_TRUE(
+        graph.getEdgeCost(EdgeId(solution[i], solution[i + 1]), &edge_cost));
+    cost += edge_cost;
+  }
+  return cost;
+}
+
+TEST(PriorityQueueTest, IndexedBinaryHeap) {
+  IndexedBinaryHeap heap(5);
+  heap.push(3, 1.0);
+  heap.push(1, 2.0);
+  heap.push(4, 1.0);
+  heap.push(0, 3.0);
+  EXPECT_TRUE(heap.contains(0));
+  EXPECT_FALSE(heap.contains(2));
+  heap.push(0, 0.5);  // Decrease key.
+
+  EXPECT_EQ(heap.pop(), 0);
+  EXPECT_EQ(heap.pop(), 3);  // Tie broken by id.
+  EXPECT_EQ(heap.pop(), 4);
+  EXPECT_EQ(heap.pop(), 1);
+  EXPECT_TRUE(heap.empty());
+}
+
+TEST(PriorityQueueTest, RadixHeap) {
+  RadixHeap heap;
+  heap.push(3, 10);
+  heap.push(1, 20);
+  heap.push(4, 10);
+  heap.push(0, 1000);
+  heap.push(2, 15);
+
+  EXPECT_EQ(heap.pop(), RadixHeap::Entry(10, 3));  // Tie broken by id.
+  EXPECT_EQ(heap.pop(), RadixHeap::Entry(10, 4));
+  heap.push(5, 12);
+  EXPECT_EQ(heap.pop(), RadixHeap::Entry(12, 5));
+  EXPECT_EQ(heap.pop(), RadixHeap::Entry(15, 2));
+  EXPECT_EQ(heap.pop(), RadixHeap::Entry(20, 1));
+  EXPECT_EQ(heap.pop(), RadixHeap::Entry(1000, 0));
+  EXPECT_TRUE(heap.empty());
+}
+
+TEST(GraphBaseTest, SearchEngines) {
+  std::srand(kSeed);
+  test_graph::RandomGraph graph(kNumNodes);
+  ASSERT_TRUE(graph.isInitialized());
+
+  for (size_t i = 0; i < kNumQueries; ++i) {
+    const size_t start = std::rand() % kNumNodes;
+    const size_t goal = std::rand() % kNumNodes;
+
+    Solution dijkstra_linear, dijkstra_binary, dijkstra_radix;
+    Solution astar_linear, astar_binary, astar_radix;
+    graph.setSearchEngine(SearchEngine::kLinearScan);
+    const bool success = graph.solveDijkstra(start, goal, &dijkstra_linear);
+    EXPECT_EQ(success, graph.solveAStar(start, goal, &astar_linear));
+    graph.setSearchEngine(SearchEngine::kBinaryHeap);
+    EXPECT_EQ(success, graph.solveDijkstra(start, goal, &dijkstra_binary));
+    EXPECT_EQ(success, graph.solveAStar(start, goal, &astar_binary));
+    graph.setSearchEngine(SearchEngine::kRadixHeap);
+    EXPECT_EQ(success, graph.solveDijkstra(start, goal, &dijkstra_radix));
+    EXPECT_EQ(success, graph.solveAStar(start, goal, &astar_radix));
+    if (!success) continue;
+
+    // Binary heap reproduces the original solvers.
+    EXPECT_EQ(dijkstra_linear, dijkstra_binary);
+    EXPECT_EQ(astar_linear, astar_binary);
+
+    // Radix heap is optimal on milli int costs.
+    const double cost = computeCost(graph, dijkstra_linear);
+    EXPECT_NEAR(cost, computeCost(graph, dijkstra_radix),
+                dijkstra_radix.size() * kFromMilli);
+    EXPECT_NEAR(cost, computeCost(graph, astar_linear), 1e-9);
+    EXPECT_NEAR(cost, computeCost(graph, astar_radix),
+                astar_radix.size() * kFromMilli);
+  }
+}
+
+TEST(GraphBaseTest, Freeze) {
+  std::srand(kSeed);
+  test_graph::RandomGraph graph(kNumNodes);
+  ASSERT_TRUE(graph.isInitialized());
+  test_graph::RandomGraph frozen_graph = graph;
+  frozen_graph.freeze();
+  EXPECT_TRUE(frozen_graph.isFrozen());
+  EXPECT_EQ(graph.size(), frozen_graph.size());
+  EXPECT_EQ(graph.getNumberOfEdges(), frozen_graph.getNumberOfEdges());
+  EXPECT_EQ(graph.getAdjacencyMatrix(), frozen_graph.getAdjacencyMatrix());
+
+  for (size_t i = 0; i < kNumQueries; ++i) {
+    const size_t start = std::rand() % kNumNodes;
+    const size_t goal = std::rand() % kNumNodes;
+
+    Solution solution, frozen_solution;
+    EXPECT_EQ(graph.solveDijkstra(start, goal, &solution),
+              frozen_graph.solveDijkstra(start, goal, &frozen_solution));
+    EXPECT_EQ(solution, frozen_solution);
+    EXPECT_EQ(graph.solveAStar(start, goal, &solution),
+              frozen_graph.solveAStar(start, goal, &frozen_solution));
+    EXPECT_EQ(solution, frozen_solution);
+  }
+
+  // Adding a node thaws the graph.
+  std::srand(kSeed);
+  EXPECT_TRUE(graph.addStartNode(test_graph::NodeProperty(50.0, 50.0)));
+  std::srand(kSeed);
+  EXPECT_TRUE(frozen_graph.addStartNode(test_graph::NodeProperty(50.0, 50.0)));
+  EXPECT_FALSE(frozen_graph.isFrozen());
+  EXPECT_EQ(graph.getAdjacencyMatrix(), frozen_graph.getAdjacencyMatrix());
+}
+
+TEST(GraphBaseTest, PropertyLookup) {
+  std::srand(kSeed);
+  test_graph::RandomGraph graph(kNumNodes);
+  ASSERT_TRUE(graph.isInitialized());
+  graph.freeze();
+
+  // Every node and every edge in the frozen adjacency has a property.
+  size_t num_edges = 0;
+  for (size_t i = 0; i < graph.size(); ++i) {
+    ASSERT_NE(graph.getNodeProperty(i), nullptr);
+    for (size_t j = 0; j < graph.size(); ++j) {
+      if (!graph.edgeExists(EdgeId(i, j))) continue;
+      EXPECT_NE(graph.getEdgeProperty(EdgeId(i, j)), nullptr);
+      num_edges++;
+    }
+  }
+  EXPECT_GT(num_edges, 0);
+  EXPECT_EQ(graph.getNodeProperty(graph.size()), nullptr);
+  EXPECT_EQ(graph.getEdgeProperty(EdgeId(0, graph.size())), nullptr);
+}
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,70 @@
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <ros/package.h>
+
+#include "polygon_coverage_solvers/gk_ma.h"
+#include "polygon_coverage_solvers/memetic_gtsp_solver.h"
+
+using namespace polygon_coverage_planning;
+
+// Compares the tour costs and solve times of GK MA and the memetic solver on
+// GTSPLIB instances.
+
+const std::string kPackageName = "polygon_coverage_solvers";
+
+int main() {
+  gk_ma::GkMa& gk_ma = gk_ma::GkMa::getInstance();
+  const MemeticGtspSolver solver;
+
+  // Package directory.
+  std::string instances_path = ros::package::getPath(kPackageName);
+  // Catkin directory.
+  instances_path = instances_path.substr(0, instances_path.find("/src/"));
+  // Instances directory.
+  instances_path +=
+      "/build/" + kPackageName + "/gtsp_instances-prefix/src/gtsp_instances/";
+
+  std::vector<std::string> instance_names = {"4br17.gtsp", "11berlin52.gtsp",
+                                             "40d198.gtsp", "65rbg323.gtsp"};
+  for (const std::string& instance_name : instance_names) {
+    std::vector<std::vector<int>> m;
+    std::vector<std::vector<int>> clusters;
+    if (!gk_ma.setSolver(instances_path + instance_name, true) ||
+        !gk_ma.getTask(&m, &clusters)) {
+      std::cerr << "Failed to load " << instance_name << "." << std::endl;
+      return 1;
+    }
+
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    if (!gk_ma.solve()) {
+      std::cerr << "GK MA failed on " << instance_name << "." << std::endl;
+      return 1;
+    }
+    const double time_gk_ma = std::chrono::duration<double>(
+                                  std::chrono::steady_clock::now() - start)
+                                  .count();
+    const std::vector<int> solution_gk_ma = gk_ma.getSolution();
+
+    start = std::chrono::steady_clock::now();
+    std::vector<int> solution;
+    if (!solver.solve(m, clusters, &solution)) {
+      std::cerr << "Memetic solver failed on " << instance_name << "."
+                << std::endl;
+      return 1;
+    }
+    const double time_memetic = std::chrono::duration<double>(
+                                    std::chrono::steady_clock::now() - start)
+                                    .count();
+
+    std::cout << instance_name
+              << " GK MA: " << GtspSolver::computeCost(m, solution_gk_ma)
+              << " in " << time_gk_ma
+              << "s, memetic: " << GtspSolver::computeCost(m, solution)
+              << " in " << time_memetic << "s" << std::endl;
+  }
+  return 0;
+}
@@ -0,0 +1,251 @@
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <ros/package.h>
+
+#include "polygon_coverage_solvers/exact_gtsp_solver.h"
+#include "polygon_coverage_solvers/gk_ma.h"
+#include "polygon_coverage_solvers/memetic_gtsp_solver.h"
+
+using namespace polygon_coverage_planning;
+
+const size_t kSeed = 123456;
+const size_t kNumInstances = 50;
+const size_t kMaxNumClusters = 6;
+const size_t kMaxClusterSize = 3;
+const int64_t kInfinity = std::numeric_limits<int64_t>::max();
+const std::string kPackageName = "polygon_coverage_solvers";
+
+struct Instance {
+  std::vector<std::vector<int>> m;
+  std::vector<std::vector<int>> clusters;
+};
+
+Instance createRandomInstance() {
+  Instance instance;
+  const size_t num_clusters = 1 + std::rand() % kMaxNumClusters;
+  int num_nodes = 0;
+  instance.clusters.resize(num_clusters);
+  for (std::vector<int>& cluster : instance.clusters) {
+    const size_t cluster_size = 1 + std::rand() % kMaxClusterSize;
+    for (size_t i = 0; i < cluster_size; ++i) {
+      cluster.push_back(num_nodes++);
+    }
+  }
+
+  // Asymmetric costs with some missing edges.
+  instance.m.assign(num_nodes, std::vector<int>(num_nodes));
+  for (int i = 0; i < num_nodes; ++i) {
+    for (int j = 0; j < num_nodes; ++j) {
+      instance.m[i][j] = (i != j && std::rand() % 10 > 0)
+                             ? std::rand() % 1000
+                             : std::numeric_limits<int>::max();
+    }
+  }
+  return instance;
+}
+
+// Enumerate all cluster orders with fixed first cluster and all node choices.
+int64_t solveBruteForce(const Instance& instance) {
+  std::vector<size_t> order(instance.clusters.size());
+  std::iota(order.begin(), order.end(), 0);
+  int64_t best_cost = kInfinity;
+  do {
+    std::vector<size_t> choice(order.size(), 0);
+    while (true) {
+      std::vector<int> tour(order.size());
+      for (size_t i = 0; i < order.size(); ++i) {
+        tour[i] = instance.clusters[order[i]][choice[i]];
+      }
+      best_cost =
+          std::min(best_cost, GtspSolver::computeCost(instance.m, tour));
+
+      // Next node choice.
+      size_t i = 0;
+      for (; i < choice.size(); ++i) {
+        if (++choice[i] < instance.clusters[order[i]].size()) break;
+        choice[i] = 0;
+      }
+      if (i == choice.size()) break;
+    }
+  } while (std::next_permutation(order.begin() + 1, order.end()));
+  return best_cost;
+}
+
+void checkTour(const Instance& instance, const std::vector<int>& tour) {
+  ASSERT_EQ(tour.size(), instance.clusters.size());
+  for (const std::vector<int>& cluster : instance.clusters) {
+    size_t num_visits = 0;
+    for (int v : tour) {
+      num_visits += std::count(cluster.begin(), cluster.end(), v);
+    }
+    EXPECT_EQ(num_visits, 1);
+  }
+}
+
+TEST(MemeticGtspSolverTest, BruteForce) {
+  std::srand(kSeed);
+  const MemeticGtspSolver solver;
+
+  for (size_t i = 0; i < kNumInstances; ++i) {
+    const Instance instance = createRandomInstance();
+    const int64_t expected_cost = solveBruteForce(instance);
+
+    std::vector<int> solution;
+    const bool success = solver.solve(instance.m, instance.clusters, &solution);
+    EXPECT_EQ(success, expected_cost < kInfinity);
+    if (!success) continue;
+
+    checkTour(instance, solution);
+    EXPECT_EQ(GtspSolver::computeCost(instance.m, solution), expected_cost);
+  }
+}
+
+TEST(ExactGtspSolverTest, BruteForce) {
+  std::srand(kSeed);
+  const ExactGtspSolver solver;
+
+  for (size_t i = 0; i < kNumInstances; ++i) {
+    const Instance instance = createRandomInstance();
+    const int64_t expected_cost = solveBruteForce(instance);
+
+    std::vector<int> solution;
+    const bool success = solver.solve(instance.m, instance.clusters, &solution);
+    EXPECT_EQ(success, expected_cost < kInfinity);
+    if (!success) continue;
+
+    checkTour(instance, solution);
+    EXPECT_EQ(GtspSolver::computeCost(instance.m, solution), expected_cost);
+  }
+}
+
+TEST(GtspSolverTest, Budget) {
+  std::srand(kSeed);
+  MemeticGtspSolver memetic;
+  ExactGtspSolver exact;
+  const std::vector<GtspSolver*> solvers = {&memetic, &exact};
+  const std::vector<GtspBudget> budgets = {GtspBudget(), GtspBudget(0.0),
+                                           GtspBudget(1.0, 0)};
+
+  for (size_t i = 0; i < kNumInstances; ++i) {
+    const Instance instance = createRandomInstance();
+    if (solveBruteForce(instance) == kInfinity) continue;
+    for (GtspSolver* solver : solvers) {
+      for (const GtspBudget& budget : budgets) {
+        solver->setBudget(budget);
+        GtspIncumbent incumbent;
+        std::vector<int> solution, best_so_far;
+        int64_t best_so_far_cost = 0;
+        // An exhausted budget returns the best tour so far. It may be
+        // infeasible.
+        if (!solver->solve(instance.m, instance.clusters, &solution,
+                           &incumbent)) {
+          continue;
+        }
+        checkTour(instance, solution);
+        ASSERT_TRUE(incumbent.get(&best_so_far, &best_so_far_cost));
+        EXPECT_EQ(best_so_far, solution);
+        EXPECT_EQ(best_so_far_cost,
+                  GtspSolver::computeCost(instance.m, solution));
+      }
+    }
+  }
+}
+
+TEST(MemeticGtspSolverTest, Reentrant) {
+  std::srand(kSeed);
+  const MemeticGtspSolver solver;
+  const size_t kNumThreads = 4;
+
+  std::vector<Instance> instances;
+  while (instances.size() < kNumThreads) {
+    Instance instance = createRandomInstance();
+    if (solveBruteForce(instance) < kInfinity) instances.push_back(instance);
+  }
+
+  // Same seed, same solution. Also when solving concurrently.
+  std::vector<std::vector<int>> sequential(kNumThreads), parallel(kNumThreads);
+  for (size_t i = 0; i < kNumThreads; ++i) {
+    EXPECT_TRUE(solver.solve(instances[i].m, instances[i].clusters,
+                             &sequential[i]));
+  }
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back([&, i]() {
+      solver.solve(instances[i].m, instances[i].clusters, &parallel[i]);
+    });
+  }
+  for (std::thread& thread : threads) thread.join();
+  EXPECT_EQ(sequential, parallel);
+}
+
+TEST(GtspSolverTest, InvalidInput) {
+  const MemeticGtspSolver solver;
+  std::vector<int> solution;
+  std::vector<std::vector<int>> m(3, std::vector<int>(3, 1));
+  // No clusters.
+  EXPECT_FALSE(solver.solve(m, {}, &solution));
+  // Empty cluster.
+  EXPECT_FALSE(solver.solve(m, {{0}, {}}, &solution));
+  // Node in two clusters.
+  EXPECT_FALSE(solver.solve(m, {{0, 1}, {1, 2}}, &solution));
+  // Node out of range.
+  EXPECT_FALSE(solver.solve(m, {{0}, {3}}, &solution));
+  // Non-square matrix.
+  m.back().pop_back();
+  EXPECT_FALSE(solver.solve(m, {{0}, {1}}, &solution));
+}
+
+// Compare against GK MA and the exact solver on GTSPLIB instances.
+TEST(GtspSolverTest, Gtsplib) {
+  gk_ma::GkMa& gk_ma = gk_ma::GkMa::getInstance();
+  const MemeticGtspSolver solver;
+  const ExactGtspSolver exact;
+
+  // Package directory.
+  std::string instances_path = ros::package::getPath(kPackageName);
+  // Catkin directory.
+  instances_path = instances_path.substr(0, instances_path.find("/src/"));
+  // Instances directory.
+  instances_path +=
+      "/build/" + kPackageName + "/gtsp_instances-prefix/src/gtsp_instances/";
+
+  std::vector<std::string> instance_names = {"4br17.gtsp", "11berlin52.gtsp",
+                                             "40d198.gtsp", "65rbg323.gtsp"};
+  for (const std::string& instance_name : instance_names) {
+    ASSERT_TRUE(gk_ma.setSolver(instances_path + instance_name, true));
+    Instance instance;
+    ASSERT_TRUE(gk_ma.getTask(&instance.m, &instance.clusters));
+
+    EXPECT_TRUE(gk_ma.solve());
+    const std::vector<int> solution_gk_ma = gk_ma.getSolution();
+
+    std::vector<int> solution;
+    EXPECT_TRUE(solver.solve(instance.m, instance.clusters, &solution));
+
+    checkTour(instance, solution);
+    const int64_t cost_gk_ma =
+        GtspSolver::computeCost(instance.m, solution_gk_ma);
+    const int64_t cost_memetic = GtspSolver::computeCost(instance.m, solution);
+    // Within 5% of GK MA.
+    EXPECT_LE(cost_memetic, 1.05 * cost_gk_ma);
+
+    if (instance.clusters.size() > HeldKarp::kMaxNumClusters + 1) continue;
+    std::vector<int> solution_exact;
+    EXPECT_TRUE(exact.solve(instance.m, instance.clusters, &solution_exact));
+    const int64_t cost_exact =
+        GtspSolver::computeCost(instance.m, solution_exact);
+    EXPECT_LE(cost_exact, cost_memetic);
+    EXPECT_LE(cost_exact, cost_gk_ma);
+  }
+}
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
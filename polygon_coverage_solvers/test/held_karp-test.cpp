@@ -0,0 +1,144 @@
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "polygon_coverage_solvers/held_karp.h"
+
+using namespace polygon_coverage_planning;
+
+const size_t kSeed = 123456;
+const size_t kNumInstances = 50;
+const size_t kMaxNumClusters = 5;
+const size_t kMaxClusterSize = 3;
+const double kInfinity = std::numeric_limits<double>::max();
+
+struct Instance {
+  std::vector<std::vector<double>> cost;
+  std::vector<std::vector<size_t>> clusters;
+  size_t start;
+  size_t goal;
+};
+
+Instance createRandomInstance() {
+  Instance instance;
+  const size_t num_clusters = 1 + std::rand() % kMaxNumClusters;
+  size_t num_nodes = 0;
+  instance.clusters.resize(num_clusters);
+  for (std::vector<size_t>& cluster : instance.clusters) {
+    const size_t cluster_size = 1 + std::rand() % kMaxClusterSize;
+    for (size_t i = 0; i < cluster_size; ++i) {
+      cluster.push_back(num_nodes++);
+    }
+  }
+  instance.start = num_nodes++;
+  instance.goal = num_nodes++;
+
+  // Asymmetric costs with some missing edges.
+  instance.cost.assign(num_nodes, std::vector<double>(num_nodes, kInfinity));
+  for (size_t i = 0; i < num_nodes; ++i) {
+    for (size_t j = 0; j < num_nodes; ++j) {
+      if (i != j && std::rand() % 10 > 0) {
+        instance.cost[i][j] = (std::rand() % 1000) / 10.0;
+      }
+    }
+  }
+  return instance;
+}
+
+double computeCost(const Instance& instance, const Solution& solution) {
+  double cost = 0.0;
+  for (size_t i = 0; i + 1 < solution.size(); ++i) {
+    cost += instance.cost[solution[i]][solution[i + 1]];
+  }
+  return cost;
+}
+
+// Enumerate all cluster orders and node choices.
+double solveBruteForce(const Instance& instance) {
+  std::vector<size_t> order(instance.clusters.size());
+  std::iota(order.begin(), order.end(), 0);
+  double best_cost = kInfinity;
+  do {
+    std::vector<size_t> choice(order.size(), 0);
+    while (true) {
+      double cost = 0.0;
+      size_t prev = instance.start;
+      for (size_t i = 0; i <= order.size() && cost < kInfinity; ++i) {
+        const size_t next = i < order.size()
+                                ? instance.clusters[order[i]][choice[i]]
+                                : instance.goal;
+        const double edge_cost = instance.cost[prev][next];
+        cost = edge_cost == kInfinity ? kInfinity : cost + edge_cost;
+        prev = next;
+      }
+      best_cost = std::min(best_cost, cost);
+
+      // Next node choice.
+      size_t i = 0;
+      for (; i < choice.size(); ++i) {
+        if (++choice[i] < instance.clusters[order[i]].size()) break;
+        choice[i] = 0;
+      }
+      if (i == choice.size()) break;
+    }
+  } while (std::next_permutation(order.begin(), order.end()));
+  return best_cost;
+}
+
+TEST(HeldKarpTest, BruteForce) {
+  std::srand(kSeed);
+  const HeldKarp single_thread(1);
+  const HeldKarp multi_thread(4);
+
+  for (size_t i = 0; i < kNumInstances; ++i) {
+    const Instance instance = createRandomInstance();
+    const double expected_cost = solveBruteForce(instance);
+
+    Solution solution, solution_parallel;
+    const bool success =
+        single_thread.solve(instance.cost, instance.clusters, instance.start,
+                            instance.goal, &solution);
+    EXPECT_EQ(success, expected_cost < kInfinity);
+    EXPECT_EQ(success,
+              multi_thread.solve(instance.cost, instance.clusters,
+                                 instance.start, instance.goal,
+                                 &solution_parallel));
+    if (!success) continue;
+
+    EXPECT_EQ(solution, solution_parallel);
+    ASSERT_EQ(solution.size(), instance.clusters.size() + 2);
+    EXPECT_EQ(solution.front(), instance.start);
+    EXPECT_EQ(solution.back(), instance.goal);
+    // Every cluster is visited exactly once.
+    for (const std::vector<size_t>& cluster : instance.clusters) {
+      size_t num_visits = 0;
+      for (size_t v : solution) {
+        num_visits += std::count(cluster.begin(), cluster.end(), v);
+      }
+      EXPECT_EQ(num_visits, 1);
+    }
+    EXPECT_NEAR(computeCost(instance, solution), expected_cost, 1e-9);
+  }
+}
+
+TEST(HeldKarpTest, InvalidInput) {
+  const HeldKarp solver;
+  Solution solution;
+  std::vector<std::vector<double>> cost(3, std::vector<double>(3, 1.0));
+  // Start in cluster.
+  EXPECT_FALSE(solver.solve(cost, {{0, 1}}, 0, 2, &solution));
+  // Empty cluster.
+  EXPECT_FALSE(solver.solve(cost, {{}}, 0, 2, &solution));
+  // No cluster.
+  EXPECT_TRUE(solver.solve(cost, {}, 0, 2, &solution));
+  EXPECT_EQ(solution, Solution({0, 2}));
+}
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}